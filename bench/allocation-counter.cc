@@ -0,0 +1,75 @@
+//
+// =========================================================================
+//
+//       Filename:  allocation-counter.cc
+//
+//    Description:  Replaces the global operator new and delete of the
+//                  benchmark binary by versions that count the calls and
+//                  bytes, read by RunBenchmark through CountAllocations.
+//                  Kept apart from the benchmarks, so the compiler can
+//                  not inline them into code that pairs them with
+//                  the default allocation functions.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 09:31:40 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "bench.h"
+
+//--------------------------------------------------------------------------
+//  local variables
+//--------------------------------------------------------------------------
+namespace {
+// relaxed, as only the totals between two benchmarks matter
+std::atomic<uint64_t> allocations(0);
+std::atomic<uint64_t> allocatedBytes(0);
+}  // -----  end of namespace  -----
+
+void * operator new (std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  void * p = std::malloc(size > 0 ? size : 1);
+  if (p == NULL) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void * operator new[] (std::size_t size) {
+  return ::operator new(size);
+}
+
+void operator delete (void * p) noexcept {
+  std::free(p);
+}
+
+void operator delete[] (void * p) noexcept {
+  std::free(p);
+}
+
+void operator delete (void * p, std::size_t) noexcept {
+  std::free(p);
+}
+
+void operator delete[] (void * p, std::size_t) noexcept {
+  std::free(p);
+}
+
+AllocationCounters CountAllocations () {
+  AllocationCounters c;
+  c.allocations = allocations.load(std::memory_order_relaxed);
+  c.bytes       = allocatedBytes.load(std::memory_order_relaxed);
+  return c;
+}   // -----  end of function CountAllocations  -----
@@ -0,0 +1,202 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-allocation.cc
+//
+//    Description:  Throughput of the allocation kernels in cells (one share
+//                  of one person of one expense) per second, in floating
+//                  point and in whole cents, and the latency per
+//                  household on a batch of small households, with the
+//                  kernels unrolled for their size and without.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 10:02:17 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "bench.h"
+
+namespace {
+const std::size_t kBatch = 100000;
+
+// kBatch households of 2 to 4 persons, as most are, with 8 expenses each,
+// packed side by side
+struct small_batch {
+  std::vector<std::size_t> persons;  // per household
+  std::vector<std::size_t> begin;    // of its incomes
+  std::vector<double>      incomes;
+  std::vector<double>      costs;    // kBatch x 8
+};
+
+typedef struct small_batch SmallBatch;
+
+const std::size_t kBatchExpenses = 8;
+
+void MakeSmallBatch (SmallBatch & b) {
+  uint64_t state = 88172645463325252ull;
+  for (std::size_t h = 0; h < kBatch; ++h) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    const std::size_t n = 2 + state % 3;
+    b.persons.push_back(n);
+    b.begin.push_back(b.incomes.size());
+    for (std::size_t j = 0; j < n; ++j) {
+      b.incomes.push_back(1000. + static_cast<double>((state >> (8 + j)) % 64)*50.);
+    }
+    for (std::size_t i = 0; i < kBatchExpenses; ++i) {
+      b.costs.push_back(20. + static_cast<double>((state >> (16 + i)) % 32)*12.5);
+    }
+  }
+}
+
+// the batch through kernel, one household after the other
+template <typename Kernel>
+double SplitSmallBatch (const SmallBatch & b, Kernel kernel,
+                        std::vector<double> & shares,
+                        std::vector<double> & totals) {
+  double sum = 0.;
+  for (std::size_t h = 0; h < kBatch; ++h) {
+    sum += kernel(b.incomes.data() + b.begin[h], b.persons[h],
+                  b.costs.data() + h*kBatchExpenses, kBatchExpenses,
+                  shares.data(), totals.data());
+  }
+  return sum;
+}
+}  // -----  end of namespace  -----
+
+void BenchAllocation () {
+  const std::size_t kGroupSizes[] = { 2, 64, 4096 };
+  const std::size_t kExpenses     = 32;
+
+  for (std::size_t g = 0; g < 3; ++g) {
+    const std::size_t n = kGroupSizes[g];
+
+    std::vector<double> incomes(n);
+    std::vector<double> costs(kExpenses);
+    std::vector<double> shares(n*kExpenses);
+    std::vector<double> totals(n);
+    for (std::size_t j = 0; j < n; ++j) {
+      incomes[j] = 1000. + static_cast<double>(j % 17)*125.;
+    }
+    for (std::size_t i = 0; i < kExpenses; ++i) {
+      costs[i] = 20. + static_cast<double>(i)*7.5;
+    }
+
+    std::vector<int64_t>     centIncomes(n);
+    std::vector<int64_t>     centCosts(kExpenses);
+    std::vector<int64_t>     centShares(n*kExpenses);
+    std::vector<int64_t>     centTotals(n);
+    std::vector<uint64_t>    centScratch(AllocateCentsScratch(n));
+    for (std::size_t j = 0; j < n; ++j) {
+      centIncomes[j] = ToCents(incomes[j]) + static_cast<int64_t>(j % 7);
+    }
+    for (std::size_t i = 0; i < kExpenses; ++i) {
+      centCosts[i] = ToCents(costs[i]) + static_cast<int64_t>(i % 3);
+    }
+
+    RunBenchmark("AllocateShares/members=" + std::to_string(n), "cells",
+                 static_cast<double>(n*kExpenses), [&]() {
+      DoNotOptimize(AllocateShares(incomes.data(), n, costs.data(), kExpenses,
+                                   shares.data(), totals.data()));
+    });
+    RunBenchmark("AllocateCents/members=" + std::to_string(n), "cells",
+                 static_cast<double>(n*kExpenses), [&]() {
+      DoNotOptimize(AllocateCents(centIncomes.data(), n,
+                                  centCosts.data(), kExpenses,
+                                  centShares.data(), centTotals.data(),
+                                  centScratch.data()));
+    });
+
+    // the shares of every expense have to add up to its cost
+    std::size_t unbalanced = 0;
+    for (std::size_t i = 0; i < kExpenses; ++i) {
+      int64_t sum = 0;
+      for (std::size_t j = 0; j < n; ++j) {
+        sum += centShares[j*kExpenses + i];
+      }
+      unbalanced += (sum != centCosts[i]);
+    }
+    std::printf("%zu of %zu expenses do not add up\n", unbalanced, kExpenses);
+  }  // -----  end for  -----
+
+  // small households one by one, where the loops over the persons cost
+  // more than the arithmetic
+  SmallBatch b;
+  MakeSmallBatch(b);
+  std::vector<double> shares(4*kBatchExpenses);
+  std::vector<double> totals(4);
+  std::vector<double> generic(4*kBatchExpenses);
+  RunBenchmark("AllocateSharesGeneric/2-4 members", "households",
+               static_cast<double>(kBatch), [&]() {
+    DoNotOptimize(SplitSmallBatch(b, AllocateSharesGeneric, generic, totals));
+  });
+  RunBenchmark("AllocateShares/2-4 members", "households",
+               static_cast<double>(kBatch), [&]() {
+    DoNotOptimize(SplitSmallBatch(b, AllocateShares, shares, totals));
+  });
+
+  // the same through Allocate, from the records of a household
+  std::vector<std::vector<Person> > persons(3);
+  std::vector<Expense>              expenses(kBatchExpenses);
+  for (std::size_t n = 2; n <= 4; ++n) {
+    persons[n - 2].resize(n);
+    for (std::size_t j = 0; j < n; ++j) {
+      persons[n - 2][j].income = b.incomes[j];
+    }
+  }
+  for (std::size_t i = 0; i < kBatchExpenses; ++i) {
+    expenses[i].cost   = b.costs[i];
+    expenses[i].policy = PolicyIncome;
+  }
+  Allocation a;
+  RunBenchmark("Allocate/2-4 members", "households",
+               static_cast<double>(kBatch), [&]() {
+    double sum = 0.;
+    for (std::size_t h = 0; h < kBatch; ++h) {
+      Allocate(persons[b.persons[h] - 2], expenses, a);
+      sum += a.ratio;
+    }
+    DoNotOptimize(sum);
+  });
+  expenses[0].policy = PolicyEqual;
+  RunBenchmark("AllocatePolicies/2-4 members", "households",
+               static_cast<double>(kBatch), [&]() {
+    double sum = 0.;
+    for (std::size_t h = 0; h < kBatch; ++h) {
+      Allocate(persons[b.persons[h] - 2], expenses, a);
+      sum += a.ratio;
+    }
+    DoNotOptimize(sum);
+  });
+
+  // the unrolled kernels have to give the same shares, bit for bit
+  std::size_t mismatches = 0;
+  for (std::size_t h = 0; h < kBatch; ++h) {
+    const double * incomes = b.incomes.data() + b.begin[h];
+    const double * costs   = b.costs.data() + h*kBatchExpenses;
+    AllocateShares(incomes, b.persons[h], costs, kBatchExpenses,
+                   shares.data(), totals.data());
+    AllocateSharesGeneric(incomes, b.persons[h], costs, kBatchExpenses,
+                          generic.data(), totals.data());
+    for (std::size_t k = 0; k < b.persons[h]*kBatchExpenses; ++k) {
+      mismatches += !(shares[k] <= generic[k] && shares[k] >= generic[k]);
+    }
+  }
+  std::printf("%zu of %zu households differ from the generic kernel\n",
+              mismatches, kBatch);
+}   // -----  end of function BenchAllocation  -----
@@ -0,0 +1,145 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-batch-executor.cc
+//
+//    Description:  Measures how RunBatchJob scales with the number of
+//                  threads on a batch whose households have 2 to 200
+//                  members, and checks that the output does not depend
+//                  on the number of threads. Also measures what a reject
+//                  log costs on clean data and on data where every 100th
+//                  household has a zero income.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 08:45:09 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "output-writer.h"
+#include "batch-executor.h"
+#include "validation.h"
+#include "bench.h"
+
+namespace {
+// most households are small, every 50th has up to 200 members
+std::string MakeBatch (const std::size_t households) {
+  std::string text;
+  uint64_t    state = 0x9e3779b97f4a7c15ull;
+  for (std::size_t h = 0; h < households; ++h) {
+    state = state*6364136223846793005ull + 1442695040888963407ull;
+    const std::size_t n = (h % 50 == 0) ? 2 + (state >> 33) % 199
+                                        : 2 + (state >> 33) % 4;
+    for (std::size_t j = 0; j < n; ++j) {
+      text += "[person" + std::to_string(j + 1) + "]\nname = p"
+              + std::to_string(j) + "\nincome = "
+              + std::to_string(1000 + (state >> (j % 32)) % 4000) + ".50\n";
+    }
+    text += "[expenses]\nrent = 1000\nutilities = 50.25\nfood = 200\n"
+            "telephone = 19.99\ninsurance = 77.10\n";
+  }  // -----  end for  -----
+  return text;
+}
+
+// the same batch with the first income of every 100th household zero
+std::string ZeroSomeIncomes (const std::string & text) {
+  std::string bad;
+  std::size_t copied = 0;
+  std::size_t h      = 0;
+  for (std::size_t p = text.find("[person1]"); p != std::string::npos;
+       p = text.find("[person1]", p + 1), ++h) {
+    if (h % 100 == 99) {
+      const std::size_t income = text.find("income = ", p) + 9;
+      const std::size_t end    = text.find('\n', income);
+      bad.append(text, copied, income - copied);
+      bad.append("0");
+      copied = end;
+    }
+  }  // -----  end for  -----
+  bad.append(text, copied, std::string::npos);
+  return bad;
+}
+}  // -----  end of namespace  -----
+
+void BenchBatchExecutor () {
+  const std::size_t kHouseholds = 20000;
+  const std::string text        = MakeBatch(kHouseholds);
+  const unsigned    cores       = std::thread::hardware_concurrency();
+
+  std::printf("%zu households, %zu bytes, %u cores\n", kHouseholds,
+              text.size(), cores);
+
+  BatchJob job;
+  job.text     = text;
+  job.fileName = "bench";
+  job.cents    = false;
+  job.series   = false;
+  job.format   = OutputCsv;
+  job.threads  = 1;
+  job.rejects  = NULL;
+
+  std::ostringstream reference;
+  uint64_t           households = 0;
+  std::string        error;
+  RunBatchJob(job, reference, households, error);
+
+  double single = 0.;
+  for (unsigned threads = 1; threads <= 64; threads *= 2) {
+    if (threads > 2 && threads > cores) {
+      break;
+    }
+    job.threads = threads;
+
+    std::ostringstream check;
+    RunBatchJob(job, check, households, error);
+    if (check.str() != reference.str()) {
+      std::printf("%u threads: output DIFFERS\n", threads);
+    }
+
+    CountingBuffer sink;
+    std::ostream   os(&sink);
+    const BenchResult r = RunBenchmark(
+      "RunBatchJob/" + std::to_string(threads) + " threads", "households",
+      static_cast<double>(kHouseholds), [&]() {
+        RunBatchJob(job, os, households, error);
+      });
+    if (threads == 1) {
+      single = r.nsPerOp;
+    }
+    std::printf("%-40s %14.2fx speedup\n", "", single/r.nsPerOp);
+  }  // -----  end for  -----
+
+  // the reject log on one thread, clean and with 1% bad households
+  const std::string bad = ZeroSomeIncomes(text);
+  CountingBuffer    sink;
+  std::ostream      os(&sink);
+  CountingBuffer    rejectSink;
+  std::ostream      rejectOs(&rejectSink);
+  RejectLog         rejects;
+  job.threads = 1;
+  job.rejects = &rejects;
+  for (std::size_t k = 0; k < 2; ++k) {
+    job.text = k == 0 ? std::string_view(text) : std::string_view(bad);
+    RunBenchmark(k == 0 ? "RunBatchJob/rejects, clean"
+                        : "RunBatchJob/rejects, 1% bad", "households",
+                 static_cast<double>(kHouseholds), [&]() {
+      InitRejectLog(rejects, &rejectOs, job.fileName);
+      RunBatchJob(job, os, households, error);
+      FinishRejectLog(rejects);
+    });
+    std::printf("%llu rejected\n",
+                static_cast<unsigned long long>(rejects.records));
+  }  // -----  end for  -----
+}   // -----  end of function BenchBatchExecutor  -----
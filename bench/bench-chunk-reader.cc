@@ -0,0 +1,130 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-chunk-reader.cc
+//
+//    Description:  Compares CountLines and the counting of comment lines
+//                  on top of the chunked reader with the former helpers,
+//                  which read a char at a time through istream_iterator
+//                  and tokens through operator>>, on a ledger of 64 MB,
+//                  or 1 GB if FAIRSHARE_BENCH_HUGE is set, and checks
+//                  that both count the same.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 10:14:03 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "chunk-reader.h"
+#include "helper-functions.h"
+#include "bench.h"
+
+namespace {
+// a comment header, then two persons and as many expenses as fit into
+// size bytes
+void WriteLedger (const std::string & fileName, const std::size_t size) {
+  std::ofstream ofs(fileName);
+  for (std::size_t i = 0; i < 1000; ++i) {
+    ofs << "# generated ledger, header line " << i << "\n";
+  }
+  ofs << "[person1]\nname   = Max\nincome = 1000\n\n"
+      << "[person2]\nname   = Maxi\nincome = 2000\n\n"
+      << "[expenses]\n";
+
+  char line[64];
+  for (std::size_t i = 0; static_cast<std::size_t>(ofs.tellp()) < size; ++i) {
+    std::snprintf(line, sizeof(line), "expense%zu = %zu.%02zu\n",
+                  i, 10 + i % 990, i % 100);
+    ofs << line;
+  }
+}
+
+// CountLines as it was before the chunked reader
+int LegacyCountLines (const std::string & fileName) {
+  std::ifstream ifs(fileName);
+  ifs.unsetf(std::ios_base::skipws);
+  return static_cast<int>(std::count(std::istream_iterator<char>(ifs),
+                                     std::istream_iterator<char>(), '\n'));
+}
+
+// CountCommentLinesOfStream as it was before the chunked reader
+int LegacyCountCommentLines (const std::string & fileName) {
+  std::ifstream ifs(fileName);
+  std::string   firstStringOfLine;
+  int           counterCommentLines = 0;
+
+  ifs >> firstStringOfLine;
+  char firstCharOfString = firstStringOfLine.c_str()[0];
+  while (firstCharOfString == '#' || firstCharOfString == '/') {
+    ifs.ignore(300, '\n');
+    ifs >> firstStringOfLine;
+    firstCharOfString = firstStringOfLine.c_str()[0];
+    counterCommentLines++;
+  }
+  ifs.seekg(0);
+  return counterCommentLines;
+}
+}  // -----  end of namespace  -----
+
+void BenchChunkReader () {
+  const bool        huge     = std::getenv("FAIRSHARE_BENCH_HUGE") != NULL;
+  const std::size_t size     = huge ? std::size_t(1) << 30
+                                    : std::size_t(64) << 20;
+  const std::string label    = huge ? "1GB" : "64MB";
+  const std::string fileName = "/tmp/fairshare-bench-chunk-reader.ini";
+  WriteLedger(fileName, size);
+
+  const double bytes = static_cast<double>(size);
+  int          legacy = 0;
+  int          lines  = 0;
+  RunBenchmark("CountLines/istream_iterator/" + label, "bytes", bytes, [&]() {
+    legacy = LegacyCountLines(fileName);
+    DoNotOptimize(legacy);
+  });
+  RunBenchmark("CountLines/chunked/" + label, "bytes", bytes, [&]() {
+    lines = CountLines(fileName);
+    DoNotOptimize(lines);
+  });
+
+  // the comment lines at the start only
+  int legacyComments = 0;
+  int comments       = 0;
+  RunBenchmark("CountCommentLines/operator>>", "files", 1., [&]() {
+    legacyComments = LegacyCountCommentLines(fileName);
+    DoNotOptimize(legacyComments);
+  });
+  RunBenchmark("CountCommentLines/chunked", "files", 1., [&]() {
+    comments = CountCommentLinesOfFile(fileName);
+    DoNotOptimize(comments);
+  });
+
+  std::string text(std::size_t(1) << 20, 'x');
+  for (std::size_t k = 40; k < text.size(); k += 41) {
+    text[k] = '\n';
+  }
+  RunBenchmark("CountNewlines/1MB", "bytes",
+               static_cast<double>(text.size()), [&]() {
+    DoNotOptimize(CountNewlines(text));
+  });
+
+  std::printf("%d lines, %d comment lines%s\n", lines, comments,
+              lines == legacy && comments == legacyComments
+              ? "" : ", MISMATCH with the former helpers");
+  std::remove(fileName.c_str());
+}   // -----  end of function BenchChunkReader  -----
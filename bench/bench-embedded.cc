@@ -0,0 +1,127 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-embedded.cc
+//
+//    Description:  Measures the overhead of one call of the libfairshare
+//                  API, as a service embedding it sees it, against the
+//                  Allocation based functions of the command line
+//                  interface, and checks that calls from several threads
+//                  give the same shares.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 10:12:55 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "libfairshare.h"
+#include "bench.h"
+
+void BenchEmbedded () {
+  struct { std::size_t persons, expenses; } kSizes[] = {
+    { 2,   4    },
+    { 5,   10   },
+    { 100, 1000 },
+  };
+
+  for (std::size_t s = 0; s < 3; ++s) {
+    const std::size_t n = kSizes[s].persons;
+    const std::size_t e = kSizes[s].expenses;
+
+    std::vector<Person>  persons(n);
+    std::vector<Expense> expenses(e);
+    std::vector<double>  incomes(n);
+    std::vector<double>  costs(e);
+    for (std::size_t j = 0; j < n; ++j) {
+      incomes[j]        = 1000. + static_cast<double>(j % 17)*125.37;
+      persons[j].name   = "person" + std::to_string(j);
+      persons[j].income = incomes[j];
+    }
+    for (std::size_t i = 0; i < e; ++i) {
+      costs[i]          = 20. + static_cast<double>(i % 101)*7.31;
+      expenses[i].name  = "expense" + std::to_string(i);
+      expenses[i].cost  = costs[i];
+    }
+
+    std::vector<double>  shares(n*e);
+    std::vector<double>  totals(n);
+    std::vector<int64_t> scratch(FairshareCentsScratch(n, e));
+    Allocation           a;
+
+    const std::string label = std::to_string(n) + "x" + std::to_string(e);
+    const double      cells = static_cast<double>(n*e);
+
+    RunBenchmark("FairshareSplit/" + label, "shares", cells, [&]() {
+      FairshareStatus status = FairshareSplit(incomes.data(), n,
+                                              costs.data(), e,
+                                              shares.data(), shares.size(),
+                                              totals.data(), totals.size());
+      DoNotOptimize(status);
+      DoNotOptimize(totals[0]);
+    });
+    RunBenchmark("AllocateHousehold/" + label, "shares", cells, [&]() {
+      const char * error = AllocateHousehold(persons, expenses, false, a);
+      DoNotOptimize(error);
+      DoNotOptimize(a.totals[0]);
+    });
+    RunBenchmark("FairshareSplitCents/" + label, "shares", cells, [&]() {
+      FairshareStatus status =
+        FairshareSplitCents(incomes.data(), n, costs.data(), e,
+                            shares.data(), shares.size(),
+                            totals.data(), totals.size(),
+                            scratch.data(), scratch.size());
+      DoNotOptimize(status);
+      DoNotOptimize(totals[0]);
+    });
+    RunBenchmark("AllocateHousehold cents/" + label, "shares", cells, [&]() {
+      const char * error = AllocateHousehold(persons, expenses, true, a);
+      DoNotOptimize(error);
+      DoNotOptimize(a.totals[0]);
+    });
+
+    // every thread splits in cents into its own buffers
+    const unsigned kThreads = 4;
+    std::vector<std::vector<double> > threadShares(kThreads,
+                                                   std::vector<double>(n*e));
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&, t]() {
+        std::vector<double>  myTotals(n);
+        std::vector<int64_t> myScratch(FairshareCentsScratch(n, e));
+        for (unsigned k = 0; k < 1000; ++k) {
+          FairshareSplitCents(incomes.data(), n, costs.data(), e,
+                              threadShares[t].data(), threadShares[t].size(),
+                              myTotals.data(), myTotals.size(),
+                              myScratch.data(), myScratch.size());
+        }
+      });
+    }
+    for (unsigned t = 0; t < kThreads; ++t) {
+      threads[t].join();
+    }
+
+    bool identical = true;
+    for (unsigned t = 0; t < kThreads; ++t) {
+      identical = identical
+        && std::memcmp(threadShares[t].data(), shares.data(),
+                       n*e*sizeof(double)) == 0;
+    }
+    std::printf("%s: %u threads, shares %s\n", label.c_str(), kThreads,
+                identical ? "identical" : "DIFFER");
+  }  // -----  end for  -----
+}   // -----  end of function BenchEmbedded  -----
@@ -0,0 +1,213 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-group-tree.cc
+//
+//    Description:  Compares evaluating a portfolio of buildings and flats
+//                  as one group tree with splitting it level by level
+//                  with the flat Allocate, once per portfolio, building
+//                  and flat, as the flat tool had to be run before.
+//                  Larger trees are run if FAIRSHARE_BENCH_HUGE is set.
+//                  If FAIRSHARE_BENCH_TREE_FILE is set, only writes the
+//                  smallest portfolio there, for make check-tree.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 12:41:18 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>   // getenv
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "group-tree.h"
+#include "bench.h"
+
+namespace {
+// the members and expenses of one flat or building, the last expense
+// being the part of the costs of the level above
+struct flat_level {
+  std::vector<Person>  persons;
+  std::vector<Expense> expenses;
+};  // -----  end of struct flat_level  -----
+
+typedef struct flat_level FlatLevel;
+
+// amounts in cents as text, e.g. 1234.05
+std::string CentsText (const uint64_t cents) {
+  const uint64_t    rest   = cents % 100;
+  const std::string digits = std::to_string(rest);
+  return std::to_string(cents/100) + (rest < 10 ? ".0" : ".") + digits;
+}
+
+// A portfolio of buildings with flats of 1 to 4 persons, as tree text and
+// as the households of the flat tool: the portfolio with a person per
+// building, every building with a person per flat, every flat with its
+// members. Incomes and rents are in cents, so that hardly any sum of
+// them is exact.
+void MakePortfolio (const std::size_t buildings, const std::size_t flats,
+                    std::string & text, std::vector<FlatLevel> & levels) {
+  uint64_t state = 0x9e3779b97f4a7c15ull;
+
+  text = "[group portfolio]\n[expenses]\nmanagement = 5000\n";
+  levels.assign(1 + buildings + buildings*flats, FlatLevel());
+  levels[0].expenses.push_back(Expense());
+  levels[0].expenses.back().cost = 5000.;
+
+  for (std::size_t b = 0; b < buildings; ++b) {
+    const std::string building = "b" + std::to_string(b);
+    text += "[group " + building + "]\nparent = portfolio\n[expenses]\n"
+            "elevator = 120\ncaretaker = 400\n";
+    FlatLevel & l = levels[1 + b];
+    l.expenses.resize(3);
+    l.expenses[0].cost = 120.;
+    l.expenses[1].cost = 400.;
+
+    for (std::size_t f = 0; f < flats; ++f) {
+      state = state*6364136223846793005ull + 1442695040888963407ull;
+      text += "[group " + building + "f" + std::to_string(f) + "]\nparent = "
+              + building + "\n";
+      FlatLevel & m = levels[1 + buildings + b*flats + f];
+      const std::size_t n = 1 + (state >> 33) % 4;
+      for (std::size_t j = 0; j < n; ++j) {
+        const uint64_t income = 100000 + (state >> (j + 8)) % 300000;
+        text += "[person" + std::to_string(j + 1) + "]\nname = p"
+                + std::to_string(j) + "\nincome = " + CentsText(income)
+                + "\n";
+        Person p = { "p" + std::to_string(j),
+                     static_cast<double>(income)/100. };
+        m.persons.push_back(p);
+      }
+      const uint64_t rent = 60000 + (state >> 20) % 20000;
+      text += "[expenses]\nrent = " + CentsText(rent) + "\nheating = 80.15\n";
+      m.expenses.resize(3);
+      m.expenses[0].cost = static_cast<double>(rent)/100.;
+      m.expenses[1].cost = 80.15;
+    }  // -----  end for flats  -----
+  }  // -----  end for buildings  -----
+}
+
+// The flat tool level by level: the incomes are summed up first, as the
+// persons of a level are the groups below it, then every level is split
+// and hands the share of each group down as its last expense.
+double SplitLevels (std::vector<FlatLevel> & levels,
+                    const std::size_t buildings, const std::size_t flats,
+                    Allocation & a) {
+  for (std::size_t b = 0; b < buildings; ++b) {
+    FlatLevel & l = levels[1 + b];
+    l.persons.resize(flats);
+    for (std::size_t f = 0; f < flats; ++f) {
+      const FlatLevel & m = levels[1 + buildings + b*flats + f];
+      double income = 0.;
+      for (std::size_t j = 0; j < m.persons.size(); ++j) {
+        income += m.persons[j].income;
+      }
+      l.persons[f].income = income;
+    }
+  }
+  levels[0].persons.resize(buildings);
+  for (std::size_t b = 0; b < buildings; ++b) {
+    double income = 0.;
+    for (std::size_t f = 0; f < flats; ++f) {
+      income += levels[1 + b].persons[f].income;
+    }
+    levels[0].persons[b].income = income;
+  }
+
+  double paid = 0.;
+  Allocate(levels[0].persons, levels[0].expenses, a);
+  std::vector<double> buildingShares(a.totals);
+  for (std::size_t b = 0; b < buildings; ++b) {
+    FlatLevel & l = levels[1 + b];
+    l.expenses[2].cost = buildingShares[b];
+    Allocate(l.persons, l.expenses, a);
+    for (std::size_t f = 0; f < flats; ++f) {
+      FlatLevel & m = levels[1 + buildings + b*flats + f];
+      m.expenses[2].cost = a.totals[f];
+    }
+    for (std::size_t f = 0; f < flats; ++f) {
+      FlatLevel & m = levels[1 + buildings + b*flats + f];
+      Allocate(m.persons, m.expenses, a);
+      for (std::size_t j = 0; j < m.persons.size(); ++j) {
+        paid += a.totals[j];
+      }
+    }
+  }  // -----  end for  -----
+  return paid;
+}
+}  // -----  end of namespace  -----
+
+void BenchGroupTree () {
+  struct { std::size_t buildings, flats; } kSizes[] = {
+    { 10,   100 },
+    { 100,  1000 },
+    { 1000, 1000 },
+  };
+  const std::size_t sizes = std::getenv("FAIRSHARE_BENCH_HUGE") != NULL ? 3 : 2;
+
+  const char * treeFile = std::getenv("FAIRSHARE_BENCH_TREE_FILE");
+  if (treeFile != NULL) {
+    std::string            text;
+    std::vector<FlatLevel> levels;
+    MakePortfolio(kSizes[0].buildings, kSizes[0].flats, text, levels);
+    std::ofstream(treeFile) << text;
+    return;
+  }
+
+  for (std::size_t s = 0; s < sizes; ++s) {
+    const std::size_t buildings = kSizes[s].buildings;
+    const std::size_t flats     = kSizes[s].flats;
+
+    std::string            text;
+    std::vector<FlatLevel> levels;
+    MakePortfolio(buildings, flats, text, levels);
+
+    GroupTree   tree;
+    std::string error;
+    InitGroupTree(tree);
+    ParseGroupTree(text, "bench", tree, error);
+    const double groups = static_cast<double>(Groups(tree));
+    std::printf("%zu buildings x %zu flats: %zu groups, %zu persons, "
+                "%zu bytes\n", buildings, flats, Groups(tree),
+                tree.personNames.size(), text.size());
+
+    const std::string label = std::to_string(buildings) + "x"
+                              + std::to_string(flats);
+    RunBenchmark("ParseGroupTree+Evaluate/" + label, "groups", groups, [&]() {
+      ParseGroupTree(text, "bench", tree, error);
+      EvaluateGroupTree(tree, error);
+      DoNotOptimize(tree.rates[0]);
+    });
+    RunBenchmark("EvaluateGroupTree/" + label, "groups", groups, [&]() {
+      EvaluateGroupTree(tree, error);
+      DoNotOptimize(tree.rates[0]);
+    });
+    Allocation a;
+    double     paid = 0.;
+    RunBenchmark("flat Allocate per level/" + label, "groups", groups, [&]() {
+      paid = SplitLevels(levels, buildings, flats, a);
+      DoNotOptimize(paid);
+    });
+
+    double total = 0.;
+    for (std::size_t g = 0; g < Groups(tree); ++g) {
+      for (std::size_t p = tree.firstPerson[g]; p < tree.firstPerson[g + 1];
+           ++p) {
+        total += tree.personIncomes[p]*tree.rates[g];
+      }
+    }
+    std::printf("%s: paid %.2f by the tree, %.2f level by level\n",
+                label.c_str(), total, paid);
+  }  // -----  end for  -----
+}   // -----  end of function BenchGroupTree  -----
@@ -0,0 +1,232 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-household-store.cc
+//
+//    Description:  Compares keeping a batch in a std::vector<Household>
+//                  with the household store: the time to load a batch
+//                  file, and the peak resident set size and the time to
+//                  free a large synthetic batch, each measured in a
+//                  child process of its own.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 10:48:21 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <malloc.h>        // malloc_trim
+#include <sys/wait.h>      // waitpid
+#include <unistd.h>        // fork
+
+#include "ledger.h"
+#include "ini-parser.h"
+#include "household-store.h"
+#include "bench.h"
+
+namespace {
+const char * const kExpenseNames[] = {
+  "rent", "utilities", "telecom", "food", "mortgage", "electricity",
+  "heating", "water", "internet", "insurance", "car", "fuel",
+  "public transport", "household supplies", "streaming services",
+  "gym", "child care", "school fees", "pets", "garden", "cleaning",
+  "repairs", "furniture", "vacation savings", "emergency fund",
+  "gifts", "restaurants", "groceries", "pharmacy", "health insurance",
+  "liability insurance", "property tax", "waste collection",
+  "broadcasting fee", "newspaper", "books", "clothing", "hobbies",
+  "parking", "bank fees",
+};
+const std::size_t kExpenseNameCount = sizeof(kExpenseNames)/sizeof(kExpenseNames[0]);
+
+// households of 2 to 5 members out of 200000 names, with 3 to 8
+// consecutive, hence distinct, expenses out of kExpenseNames
+void MakeHousehold (uint64_t & state, Household & h) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  h.persons.resize(2 + state % 4);
+  h.expenses.resize(3 + (state >> 8) % 6);
+  for (std::size_t j = 0; j < h.persons.size(); ++j) {
+    h.persons[j].name   = "member" + std::to_string((state >> (j + 16)) % 200000);
+    h.persons[j].income = 1000. + static_cast<double>((state >> j) % 400000)/100.;
+  }
+  for (std::size_t i = 0; i < h.expenses.size(); ++i) {
+    h.expenses[i].name = kExpenseNames[((state >> 20) + i) % kExpenseNameCount];
+    h.expenses[i].cost = 10. + static_cast<double>((state >> i) % 100000)/100.;
+  }
+}
+
+std::string MakeBatchText (const std::size_t households) {
+  std::string text;
+  uint64_t    state = 88172645463325252ull;
+  Household   h;
+  for (std::size_t k = 0; k < households; ++k) {
+    MakeHousehold(state, h);
+    for (std::size_t j = 0; j < h.persons.size(); ++j) {
+      text += "[person" + std::to_string(j + 1) + "]\nname = "
+              + h.persons[j].name + "\nincome = "
+              + std::to_string(h.persons[j].income) + "\n";
+    }
+    text += "[expenses]\n";
+    for (std::size_t i = 0; i < h.expenses.size(); ++i) {
+      text += h.expenses[i].name + " = " + std::to_string(h.expenses[i].cost)
+              + "\n";
+    }
+  }  // -----  end for  -----
+  return text;
+}
+
+void LoadIntoVector (const std::string_view text, std::vector<Household> & all) {
+  IniScanner scanner;
+  InitIniScanner(scanner, text);
+  all.clear();
+  bool pendingPerson = false;
+  for (;;) {
+    all.push_back(Household());
+    if (ParseHousehold(scanner, all.back(), true, pendingPerson) == IniSyntaxError
+        || (all.back().persons.empty() && all.back().expenses.empty())) {
+      all.pop_back();
+      return;
+    }
+  }  // -----  end for  -----
+}
+
+// the field VmRSS or VmHWM (the peak) of /proc/self/status in MiB
+double ResidentMiB (const char * field) {
+  std::FILE * status = std::fopen("/proc/self/status", "r");
+  char        line[256];
+  double      kiB = 0.;
+  while (status != NULL && std::fgets(line, sizeof(line), status) != NULL) {
+    if (std::strncmp(line, field, std::strlen(field)) == 0) {
+      kiB = std::strtod(line + std::strlen(field) + 1, NULL);
+    }
+  }
+  if (status != NULL) {
+    std::fclose(status);
+  }
+  return kiB/1024.;
+}
+
+// Returns the memory freed but kept by malloc, e.g. inherited from the
+// parent, to the system and restarts the peak at the current size.
+void ResetPeak () {
+  malloc_trim(0);
+  std::FILE * clear = std::fopen("/proc/self/clear_refs", "w");
+  if (clear != NULL) {
+    std::fputs("5", clear);
+    std::fclose(clear);
+  }
+}
+
+// Runs in a child: keeps households in the vector or the store and
+// prints the growth of the peak RSS and the time to free them.
+void MeasureResident (const bool store, const std::size_t households) {
+  typedef std::chrono::steady_clock Clock;
+
+  ResetPeak();
+  const double before = ResidentMiB("VmRSS:");
+  uint64_t     state  = 88172645463325252ull;
+  Household    h;
+  double       seconds = 0.;
+
+  if (store) {
+    HouseholdStore s;
+    InitHouseholdStore(s);
+    for (std::size_t k = 0; k < households; ++k) {
+      MakeHousehold(state, h);
+      StoreHousehold(s, h);
+    }
+    std::printf("%-28s %10zu names %10.1f MiB in the arena\n", "",
+                s.names.names.size(),
+                static_cast<double>(ArenaCapacity(s.arena))/(1 << 20));
+    const Clock::time_point start = Clock::now();
+    ResetHouseholdStore(s);
+    seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  } else {
+    std::vector<Household> * all = new std::vector<Household>();
+    for (std::size_t k = 0; k < households; ++k) {
+      all->emplace_back();
+      MakeHousehold(state, all->back());
+    }
+    const Clock::time_point start = Clock::now();
+    delete all;
+    seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  }  // -----  end if-else  -----
+
+  std::printf("%-28s %10zu households %10.1f MiB peak RSS %10.6f s to free\n",
+              store ? "HouseholdStore" : "std::vector<Household>",
+              households, ResidentMiB("VmHWM:") - before, seconds);
+  std::fflush(stdout);
+}
+}  // -----  end of namespace  -----
+
+void BenchHouseholdStore () {
+  const std::size_t kLoadHouseholds = 100000;
+  const std::string text = MakeBatchText(kLoadHouseholds);
+
+  std::vector<Household> all;
+  HouseholdStore         store;
+  InitHouseholdStore(store);
+  std::string            error;
+
+  RunBenchmark("load std::vector<Household>", "households",
+               static_cast<double>(kLoadHouseholds), [&]() {
+    LoadIntoVector(text, all);
+    DoNotOptimize(all.size());
+  });
+  RunBenchmark("load HouseholdStore", "households",
+               static_cast<double>(kLoadHouseholds), [&]() {
+    ResetHouseholdStore(store);
+    LoadHouseholdBatch(text, store, error);
+    DoNotOptimize(store.households.size());
+  });
+
+  bool identical = store.households.size() == all.size();
+  Household h;
+  for (std::size_t k = 0; identical && k < all.size(); ++k) {
+    ExpandHousehold(store, *store.households[k], h);
+    identical = h.persons.size() == all[k].persons.size()
+                && h.expenses.size() == all[k].expenses.size();
+    for (std::size_t j = 0; identical && j < h.persons.size(); ++j) {
+      identical = h.persons[j].name == all[k].persons[j].name
+                  && !(h.persons[j].income < all[k].persons[j].income)
+                  && !(h.persons[j].income > all[k].persons[j].income);
+    }
+    for (std::size_t i = 0; identical && i < h.expenses.size(); ++i) {
+      identical = h.expenses[i].name == all[k].expenses[i].name
+                  && !(h.expenses[i].cost < all[k].expenses[i].cost)
+                  && !(h.expenses[i].cost > all[k].expenses[i].cost);
+    }
+  }  // -----  end for  -----
+  std::printf("%zu households, store and vector %s\n", all.size(),
+              identical ? "identical" : "DIFFER");
+  std::vector<Household>().swap(all);
+  ReleaseArena(store.arena);
+
+  const std::size_t households =
+    std::getenv("FAIRSHARE_BENCH_HUGE") != NULL ? 10000000 : 1000000;
+  for (int k = 0; k < 2; ++k) {
+    std::fflush(stdout);
+    const pid_t child = fork();
+    if (child == 0) {
+      MeasureResident(k == 1, households);
+      _exit(EXIT_SUCCESS);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+  }  // -----  end for  -----
+}   // -----  end of function BenchHouseholdStore  -----
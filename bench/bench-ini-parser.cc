@@ -0,0 +1,176 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-ini-parser.cc
+//
+//    Description:  Compares the memory mapped ini parser with the former
+//                  boost::property_tree implementation of ParseIniFile on
+//                  ledgers of 1 KB and 1 MB. The 1 GB ledger is only
+//                  parsed if FAIRSHARE_BENCH_HUGE is set in the
+//                  environment, as the property tree of it needs several
+//                  GB of memory. Checks that ParseHousehold rejects a
+//                  duplicate expense with its line and column and takes
+//                  only [person] followed by digits for a person.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 01:14:09 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/ini_parser.hpp>
+
+#include "ledger.h"
+#include "ini-parser.h"
+#include "helper-functions.h"
+#include "bench.h"
+
+namespace {
+// writes two persons and as many expenses as fit into size bytes
+void WriteLedger (const std::string & fileName, const std::size_t size) {
+  std::ofstream ofs(fileName);
+  ofs << "[person1]\nname   = Max\nincome = 1000\n\n"
+      << "[person2]\nname   = Maxi\nincome = 2000\n\n"
+      << "[expenses]\n";
+
+  char line[64];
+  for (std::size_t i = 0; static_cast<std::size_t>(ofs.tellp()) < size; ++i) {
+    std::snprintf(line, sizeof(line), "expense%zu = %zu.%02zu\n",
+                  i, 10 + i % 990, i % 100);
+    ofs << line;
+  }
+}
+
+void ParseWithPropertyTree (const std::string & fileName, Household & h) {
+  using boost::property_tree::ptree;
+
+  ptree pt;
+  read_ini(fileName, pt);
+
+  h.persons.clear();
+  h.expenses.clear();
+  for (auto &v : pt) {
+    if (v.first.compare(0, 6, "person") != 0) {
+      continue;
+    }
+    Person p;
+    p.income = v.second.get<double> ("income");
+    p.name   = v.second.get<std::string> ("name");
+    h.persons.push_back(p);
+  }
+
+  ptree expenses_tree = pt.get_child("expenses");
+  for (auto &v : expenses_tree) {
+    Expense e;
+    e.name = v.first;
+    e.cost = StringToDouble(v.second.data());
+    h.expenses.push_back(e);
+  }
+}
+
+// ParseHousehold of text; the error as line:column: message, else ""
+std::string ParseError (const std::string & text, Household & h) {
+  IniScanner scanner;
+  InitIniScanner(scanner, text);
+  bool pendingPerson = false;
+  if (ParseHousehold(scanner, h, false, pendingPerson) != IniSyntaxError) {
+    return "";
+  }
+  return std::to_string(scanner.error.line) + ":"
+         + std::to_string(scanner.error.column) + ": "
+         + scanner.error.message;
+}
+
+void CheckParseHousehold () {
+  const std::string persons = "[person1]\nname = Max\nincome = 1000\n"
+                              "[person2]\nname = Maxi\nincome = 2000\n";
+  Household   h;
+  std::string error;
+
+  error = ParseError(persons + "[expenses]\nrent = 1000\nfood = 200\n"
+                     "  rent = 900\n", h);
+  if (error != "10:3: Expense 'rent' is defined twice.") {
+    std::printf("duplicate expense: got '%s'\n", error.c_str());
+  }
+  // the keys are forgotten between households
+  error = ParseError(persons + "[expenses]\nrent = 1000\nfood = 200\n", h);
+  if (!error.empty() || h.expenses.size() != 2) {
+    std::printf("expenses after a duplicate: got '%s'\n", error.c_str());
+  }
+
+  error = ParseError(persons + "[personnel]\nname = Eva\nincome = 500\n"
+                     "[expenses]\nrent = 1000\n", h);
+  if (!error.empty() || h.persons.size() != 2) {
+    std::printf("[personnel]: got %zu persons, '%s'\n", h.persons.size(),
+                error.c_str());
+  }
+  error = ParseError(persons + "[person3x]\nname = Eva\n[person]\n"
+                     "name = Eva\nincome = 500\n[expenses]\nrent = 1000\n", h);
+  if (!error.empty() || h.persons.size() != 3) {
+    std::printf("[person3x] and [person]: got %zu persons, '%s'\n",
+                h.persons.size(), error.c_str());
+  }
+}
+
+void ParseWithMappedFile (const std::string & fileName, Household & h) {
+  MappedFile file;
+  MapFile(fileName, file);
+
+  IniScanner scanner;
+  InitIniScanner(scanner, std::string_view(file.data, file.size));
+
+  bool pendingPerson = false;
+  ParseHousehold(scanner, h, false, pendingPerson);
+  UnmapFile(file);
+}
+}  // -----  end of namespace  -----
+
+void BenchIniParser () {
+  CheckParseHousehold();
+
+  struct { const char * label; std::size_t size; } kSizes[] = {
+    { "1KB", std::size_t(1) << 10 },
+    { "1MB", std::size_t(1) << 20 },
+    { "1GB", std::size_t(1) << 30 },
+  };
+  const bool huge = std::getenv("FAIRSHARE_BENCH_HUGE") != NULL;
+
+  for (std::size_t k = 0; k < 3; ++k) {
+    if (kSizes[k].size > (std::size_t(1) << 20) && !huge) {
+      continue;
+    }
+    const std::string fileName =
+      "/tmp/fairshare-bench-" + std::string(kSizes[k].label) + ".ini";
+    WriteLedger(fileName, kSizes[k].size);
+
+    Household h;
+    const double bytes = static_cast<double>(kSizes[k].size);
+
+    RunBenchmark(std::string("ptree/") + kSizes[k].label, "bytes", bytes,
+                 [&]() {
+      ParseWithPropertyTree(fileName, h);
+      DoNotOptimize(h.expenses.size());
+    });
+    RunBenchmark(std::string("mmap/") + kSizes[k].label, "bytes", bytes,
+                 [&]() {
+      ParseWithMappedFile(fileName, h);
+      DoNotOptimize(h.expenses.size());
+    });
+
+    std::remove(fileName.c_str());
+  }  // -----  end for  -----
+}   // -----  end of function BenchIniParser  -----
@@ -0,0 +1,129 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-ledger-cache.cc
+//
+//    Description:  Measures the time to the first result of a large
+//                  settings file: parsing it against opening its binary
+//                  cache, and the cost of rebuilding the cache, and
+//                  checks that a change within the mtime of the cache is
+//                  not taken for a hit.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 11:27:03 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>     // AT_FDCWD
+#include <sys/stat.h>  // stat, utimensat
+#include <unistd.h>    // unlink
+
+#include "ledger.h"
+#include "allocation.h"
+#include "household-reader.h"
+#include "ledger-cache.h"
+#include "ledger-generator.h"
+#include "bench.h"
+
+void BenchLedgerCache () {
+  struct { std::size_t persons, expenses; } kSizes[] = {
+    { 2,   10000 },
+    { 2,   50000 },
+    { 100, 20000 },
+  };
+  const std::string fileName  = "/tmp/fairshare-bench-cache.ini";
+  const std::string cacheName = LedgerCacheFileName(fileName);
+
+  for (std::size_t s = 0; s < 3; ++s) {
+    LedgerSpec spec;
+    InitLedgerSpec(spec);
+    spec.persons    = kSizes[s].persons;
+    spec.expenses   = kSizes[s].expenses;
+    spec.nameLength = 16;
+
+    std::string text;
+    GenerateLedger(spec, text);
+    std::ofstream(fileName) << text;
+    unlink(cacheName.c_str());
+
+    const std::string   label = LedgerLabel(spec);
+    const double        cells = static_cast<double>(spec.persons*spec.expenses);
+    std::vector<double> shares(spec.persons*spec.expenses);
+    std::vector<double> totals(spec.persons);
+    Household           h;
+    Allocation          a;
+    LedgerCache         cache;
+    LedgerCacheResult   result = CacheHit;
+    std::string         error;
+
+    RunBenchmark("parse+Allocate/" + label, "shares", cells, [&]() {
+      LoadHouseholdFile(fileName, h, error);
+      Allocate(h.persons, h.expenses, a);
+      DoNotOptimize(a.totals[0]);
+    });
+    RunBenchmark("rebuild cache/" + label, "shares", cells, [&]() {
+      unlink(cacheName.c_str());
+      OpenLedgerCache(fileName, cache, result, error);
+      CloseLedgerCache(cache);
+    });
+    RunBenchmark("cache+AllocateShares/" + label, "shares", cells, [&]() {
+      OpenLedgerCache(fileName, cache, result, error);
+      AllocateShares(cache.incomes, cache.persons, cache.costs,
+                     cache.expenses, shares.data(), totals.data());
+      CloseLedgerCache(cache);
+      DoNotOptimize(totals[0]);
+    });
+    std::printf("%s: last open was a %s\n", label.c_str(),
+                result == CacheHit ? "hit" : "MISS");
+    RunBenchmark("cache+expand+Allocate/" + label, "shares", cells, [&]() {
+      OpenLedgerCache(fileName, cache, result, error);
+      ExpandCachedHousehold(cache, h);
+      CloseLedgerCache(cache);
+      Allocate(h.persons, h.expenses, a);
+      DoNotOptimize(a.totals[0]);
+    });
+  }  // -----  end for  -----
+
+  // A settings file rewritten with the same size right after its cache
+  // was written may keep its mtime, and the cache may share it as well.
+  LedgerSpec spec;
+  InitLedgerSpec(spec);
+  std::string text;
+  GenerateLedger(spec, text);
+  std::ofstream(fileName) << text;
+  unlink(cacheName.c_str());
+
+  LedgerCache       cache;
+  LedgerCacheResult result = CacheHit;
+  std::string       error;
+  struct stat       before;
+  OpenLedgerCache(fileName, cache, result, error);
+  CloseLedgerCache(cache);
+  stat(fileName.c_str(), &before);
+
+  const std::size_t digit = text.find_last_of("0123456789");
+  text[digit] = text[digit] == '1' ? '2' : '1';
+  std::ofstream(fileName) << text;
+  const struct timespec times[2] = { before.st_mtim, before.st_mtim };
+  utimensat(AT_FDCWD, fileName.c_str(), times, 0);
+  utimensat(AT_FDCWD, cacheName.c_str(), times, 0);
+
+  OpenLedgerCache(fileName, cache, result, error);
+  CloseLedgerCache(cache);
+  std::printf("change within the mtime of the cache: %s\n",
+              result == CacheRebuilt ? "rebuilt" : "STALE CACHE USED");
+
+  unlink(cacheName.c_str());
+  std::remove(fileName.c_str());
+}   // -----  end of function BenchLedgerCache  -----
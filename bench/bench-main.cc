@@ -0,0 +1,274 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-main.cc
+//
+//    Description:  Runs the benchmarks of fairshare. Without names all
+//                  benchmarks are run, otherwise only those whose name
+//                  contains one of the names. Every result is printed
+//                  and can be written to a results file and compared
+//                  against the results file of an earlier run.
+//
+//        Version:  1.1
+//        Created:  10/18/2026 10:02:17 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//          Usage:  ./fairshare-bench [--results file] [--baseline file]
+//                                    [--tolerance percent] [name ...]
+//                  ./fairshare-bench --generate [key=value ...]
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ledger-generator.h"
+#include "bench.h"
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+struct benchmark {
+  const char * name;
+  void      (* run)();
+};  // -----  end of struct benchmark  -----
+
+static const benchmark kBenchmarks[] = {
+  { "allocation", BenchAllocation },
+  { "ini-parser", BenchIniParser  },
+  { "number-parser", BenchNumberParser },
+  { "table-renderer", BenchTableRenderer },
+  { "output-writer", BenchOutputWriter },
+  { "share-model", BenchShareModel },
+  { "batch-executor", BenchBatchExecutor },
+  { "phases", BenchPhases },
+  { "embedded", BenchEmbedded },
+  { "household-store", BenchHouseholdStore },
+  { "ledger-cache", BenchLedgerCache },
+  { "time-series", BenchTimeSeries },
+  { "group-tree", BenchGroupTree },
+  { "policies", BenchPolicies },
+  { "settlement", BenchSettlement },
+  { "sweep",      BenchSweep },
+  { "transactions", BenchTransactions },
+  { "chunk-reader", BenchChunkReader },
+  { "summation", BenchSummation },
+};
+
+//--------------------------------------------------------------------------
+//  local variables and helpers
+//--------------------------------------------------------------------------
+namespace {
+std::vector<BenchResult> results;
+
+const char kResultsHeader[] =
+  "name\tunit\titerations\tns_per_op\titems_per_s\tbytes_per_op\t"
+  "allocs_per_op\n";
+
+void DisplayUsage (const char * execName) {
+  std::fprintf(stderr,
+    "usage: %s [--results file] [--baseline file] [--tolerance percent]"
+    " [name ...]\n"
+    "       %s --generate [households=n] [persons=n] [expenses=n]"
+    " [name-length=n]\n"
+    "                     [format=integer|fixed|long|exponent] [seed=n]\n",
+    execName, execName);
+}
+
+// writes a ledger of the spec given by the options to stdout
+int Generate (const int argc, char * argv[]) {
+  LedgerSpec spec;
+  InitLedgerSpec(spec);
+  for (int k = 0; k < argc; ++k) {
+    if (!ParseLedgerOption(argv[k], spec)) {
+      std::fprintf(stderr, "Unknown ledger option '%s'.\n", argv[k]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::string text;
+  GenerateLedger(spec, text);
+  std::fwrite(text.data(), 1, text.size(), stdout);
+  return EXIT_SUCCESS;
+}
+
+// one line per result, tab separated, after kResultsHeader
+bool WriteResults (const std::string & fileName) {
+  std::FILE * file = std::fopen(fileName.c_str(), "w");
+  if (file == NULL) {
+    return false;
+  }
+  std::fputs(kResultsHeader, file);
+  for (std::size_t k = 0; k < results.size(); ++k) {
+    const BenchResult & r = results[k];
+    std::fprintf(file, "%s\t%s\t%zu\t%.3f\t%.6g\t%.3f\t%.3f\n",
+                 r.name.c_str(), r.unit.c_str(), r.iterations, r.nsPerOp,
+                 r.itemsPerSecond, r.bytesPerOp, r.allocationsPerOp);
+  }
+  return std::fclose(file) == 0;
+}
+
+bool ReadResults (const std::string & fileName,
+                  std::map<std::string, BenchResult> & baseline) {
+  std::ifstream ifs(fileName);
+  if (!ifs) {
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(ifs, line)) {
+    std::vector<std::string> fields;
+    std::istringstream       iss(line);
+    std::string              field;
+    while (std::getline(iss, field, '\t')) {
+      fields.push_back(field);
+    }
+    if (fields.size() < 7 || fields[0] == "name") {
+      continue;
+    }
+
+    BenchResult r;
+    r.name             = fields[0];
+    r.unit             = fields[1];
+    r.iterations       = std::strtoul(fields[2].c_str(), NULL, 10);
+    r.nsPerOp          = std::strtod(fields[3].c_str(), NULL);
+    r.itemsPerSecond   = std::strtod(fields[4].c_str(), NULL);
+    r.bytesPerOp       = std::strtod(fields[5].c_str(), NULL);
+    r.allocationsPerOp = std::strtod(fields[6].c_str(), NULL);
+    baseline[r.name]   = r;
+  }  // -----  end while  -----
+  return true;
+}
+
+// ===  FUNCTION  ==========================================================
+//         Name:  CompareResults
+//  Description:  Prints the change of time and allocated bytes per call
+//                of every result against the baseline and returns the
+//                number of regressions, i.e. results that got slower or
+//                allocate more than tolerance percent. Allocations are
+//                given one byte of slack against rounding.
+// =========================================================================
+std::size_t CompareResults (const std::map<std::string, BenchResult> & baseline,
+                            const double tolerance) {
+  std::size_t regressions = 0;
+
+  std::printf("\n# baseline, tolerance %.1f%%\n", tolerance);
+  std::printf("%-40s %10s %10s\n", "name", "time", "bytes");
+  for (std::size_t k = 0; k < results.size(); ++k) {
+    const BenchResult & r = results[k];
+    auto b = baseline.find(r.name);
+    if (b == baseline.end()) {
+      std::printf("%-40s %10s %10s\n", r.name.c_str(), "new", "new");
+      continue;
+    }
+
+    const BenchResult & old  = (*b).second;
+    const double        time = 100.*(r.nsPerOp/old.nsPerOp - 1.);
+    const double        more = r.bytesPerOp - old.bytesPerOp;
+    const double        bytes = old.bytesPerOp > 0.
+                                ? 100.*more/old.bytesPerOp : 0.;
+    const bool          regressed =
+      time > tolerance
+      || (more > 1. && more > old.bytesPerOp*tolerance/100.);
+
+    std::printf("%-40s %+9.1f%% %+9.1f%%%s\n", r.name.c_str(), time, bytes,
+                regressed ? "  REGRESSION" : "");
+    if (regressed) {
+      ++regressions;
+    }
+  }  // -----  end for  -----
+  return regressions;
+}
+}  // -----  end of namespace  -----
+
+// =========================================================================
+//   Main
+// =========================================================================
+int main(int argc, char *argv[]) {
+
+  std::string              resultsFileName;
+  std::string              baselineFileName;
+  double                   tolerance = 10.;
+  std::vector<std::string> names;
+
+  for (int k = 1; k < argc; ++k) {
+    const std::string arg = argv[k];
+    if (arg == "--generate") {
+      return Generate(argc - k - 1, argv + k + 1);
+    } else if (arg == "--results" && k + 1 < argc) {
+      resultsFileName = argv[++k];
+    } else if (arg == "--baseline" && k + 1 < argc) {
+      baselineFileName = argv[++k];
+    } else if (arg == "--tolerance" && k + 1 < argc) {
+      tolerance = std::strtod(argv[++k], NULL);
+    } else if (arg.compare(0, 1, "-") == 0) {
+      DisplayUsage(argv[0]);
+      return arg == "-h" || arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+    } else {
+      names.push_back(arg);
+    }
+  }  // -----  end for  -----
+
+  // read first, so that a missing baseline does not cost a whole run
+  std::map<std::string, BenchResult> baseline;
+  if (!baselineFileName.empty() && !ReadResults(baselineFileName, baseline)) {
+    std::fprintf(stderr, "Could not read %s.\n", baselineFileName.c_str());
+    return EXIT_FAILURE;
+  }
+
+  for (std::size_t b = 0; b < sizeof(kBenchmarks)/sizeof(kBenchmarks[0]); ++b) {
+    bool selected = names.empty();
+    for (std::size_t k = 0; k < names.size(); ++k) {
+      if (std::strstr(kBenchmarks[b].name, names[k].c_str()) != NULL) {
+        selected = true;
+      }
+    }  // -----  end for  -----
+
+    if (selected) {
+      std::printf("\n# %s\n", kBenchmarks[b].name);
+      kBenchmarks[b].run();
+    }
+  }  // -----  end for  -----
+
+  if (!resultsFileName.empty() && !WriteResults(resultsFileName)) {
+    std::fprintf(stderr, "Could not write %s.\n", resultsFileName.c_str());
+    return EXIT_FAILURE;
+  }
+
+  if (!baselineFileName.empty()) {
+    const std::size_t regressions = CompareResults(baseline, tolerance);
+    std::printf("%zu of %zu results regressed\n", regressions,
+                results.size());
+    if (regressions > 0) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//--------------------------------------------------------------------------
+//  function definitions
+//--------------------------------------------------------------------------
+// ===  FUNCTION  ==========================================================
+//         Name:  ReportBenchResult
+//  Description:  Prints r and keeps it for the results file.
+// =========================================================================
+void ReportBenchResult (const BenchResult & r) {
+  std::printf("%-40s %14.1f ns/op %14.4g %s/s %10.0f B/op %8.1f allocs/op\n",
+              r.name.c_str(), r.nsPerOp, r.itemsPerSecond, r.unit.c_str(),
+              r.bytesPerOp, r.allocationsPerOp);
+  results.push_back(r);
+}   // -----  end of function ReportBenchResult  -----
@@ -0,0 +1,137 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-number-parser.cc
+//
+//    Description:  Compares ParseDouble and the column parser ParseDoubles
+//                  with the former strtod based StringToDouble on a column
+//                  of monetary amounts, and checks that all of them give
+//                  bit-identical results and that malformed amounts are
+//                  rejected.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 02:31:40 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cerrno>
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "helper-functions.h"
+#include "bench.h"
+
+namespace {
+// StringToDouble as it was before ParseDouble, without the exits
+double LegacyStringToDouble (const std::string & doubleString) {
+  char const *s = doubleString.c_str();
+  char *end;
+  errno = 0;
+
+  double d = strtod(s, &end);
+
+  if ((errno == ERANGE && d <= DBL_MAX && d >= DBL_MAX) || d > DBL_MAX) {
+    return 0.;
+  }
+  if ((errno == ERANGE && d <= DBL_MIN && d >= DBL_MIN) || d < DBL_MIN) {
+    return 0.;
+  }
+  if (*s == '\0' || *end != '\0') {
+    return 0.;
+  }
+  return d;
+}
+}  // -----  end of namespace  -----
+
+void BenchNumberParser () {
+  const std::size_t kFields = 1 << 20;
+
+  std::vector<std::string>      strings(kFields);
+  std::vector<std::string_view> fields(kFields);
+  std::vector<double>           values(kFields);
+  std::vector<ConversionError>  errors(kFields);
+
+  unsigned long long state = 88172645463325252ull;
+  for (std::size_t i = 0; i < kFields; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%llu.%02llu",
+                  (state >> 8) % 100000ull, state % 100ull);
+    strings[i] = buffer;
+  }
+  for (std::size_t i = 0; i < kFields; ++i) {
+    fields[i] = strings[i];
+  }
+
+  std::size_t mismatches = 0;
+  for (std::size_t i = 0; i < kFields; ++i) {
+    const double a = LegacyStringToDouble(strings[i]);
+    const double b = ParseDouble(fields[i]).value;
+    mismatches += (std::memcmp(&a, &b, sizeof(double)) != 0);
+  }
+  std::printf("%zu of %zu amounts differ from strtod\n", mismatches, kFields);
+
+  const char * kMalformed[] = {
+    "", "+", "-", ".", "+-5", "++5", "-+5", "--5", "+ 5", "5-", "1.2.3",
+    "1e", "inf", "-nan", "0x10",
+  };
+  const std::size_t nMalformed = sizeof(kMalformed)/sizeof(kMalformed[0]);
+  std::size_t accepted = 0;
+  for (std::size_t i = 0; i < nMalformed; ++i) {
+    if (ParseDouble(kMalformed[i]).error == ConversionOk) {
+      std::printf("accepted malformed amount '%s'\n", kMalformed[i]);
+      ++accepted;
+    }
+  }
+  std::printf("%zu of %zu malformed amounts accepted\n", accepted, nMalformed);
+
+  const char * kSigned[]       = { "+5", "-5", "+.5", "-.5", "+1e3", "-1e3" };
+  const double kSignedValues[] = { 5.,   -5.,  .5,    -.5,   1e3,    -1e3   };
+  const std::size_t nSigned = sizeof(kSigned)/sizeof(kSigned[0]);
+  std::size_t wrong = 0;
+  for (std::size_t i = 0; i < nSigned; ++i) {
+    const Conversion c = ParseDouble(kSigned[i]);
+    if (c.error != ConversionOk
+        || std::memcmp(&c.value, &kSignedValues[i], sizeof(double)) != 0) {
+      std::printf("wrong value for '%s'\n", kSigned[i]);
+      ++wrong;
+    }
+  }
+  std::printf("%zu of %zu signed amounts wrong\n", wrong, nSigned);
+
+  const double n = static_cast<double>(kFields);
+
+  RunBenchmark("StringToDouble/strtod", "fields", n, [&]() {
+    double sum = 0.;
+    for (std::size_t i = 0; i < kFields; ++i) {
+      sum += LegacyStringToDouble(strings[i]);
+    }
+    DoNotOptimize(sum);
+  });
+  RunBenchmark("ParseDouble", "fields", n, [&]() {
+    double sum = 0.;
+    for (std::size_t i = 0; i < kFields; ++i) {
+      sum += ParseDouble(fields[i]).value;
+    }
+    DoNotOptimize(sum);
+  });
+  RunBenchmark("ParseDoubles/column", "fields", n, [&]() {
+    DoNotOptimize(ParseDoubles(fields.data(), kFields, values.data(),
+                               errors.data()));
+  });
+}   // -----  end of function BenchNumberParser  -----
@@ -0,0 +1,78 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-output-writer.cc
+//
+//    Description:  Measures the throughput of the output formats on a
+//                  stream of households and checks that the buffer of the
+//                  writer stays bounded.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 05:10:33 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "output-writer.h"
+#include "bench.h"
+
+void BenchOutputWriter () {
+  const std::size_t   kCells      = 1000000;  // per run, over all households
+  const std::size_t   kSizes[][2] = { { 2, 5 }, { 100, 50 } };
+  const char *        kNames[]    = { "table", "csv", "ndjson", "binary" };
+  const OutputFormat  kFormats[]  = { OutputTable, OutputCsv, OutputNdjson,
+                                      OutputBinary };
+
+  for (std::size_t s = 0; s < 2; ++s) {
+    const std::size_t n = kSizes[s][0];
+    const std::size_t m = kSizes[s][1];
+
+    std::vector<Person>  persons(n);
+    std::vector<Expense> expenses(m);
+    for (std::size_t j = 0; j < n; ++j) {
+      persons[j].name   = "person" + std::to_string(j);
+      persons[j].income = 1000. + static_cast<double>(j % 17)*125.37;
+    }
+    for (std::size_t i = 0; i < m; ++i) {
+      expenses[i].name = "expense" + std::to_string(i);
+      expenses[i].cost = 20. + static_cast<double>(i)*7.31;
+    }
+    Allocation a;
+    Allocate(persons, expenses, a);
+
+    const std::string label = std::to_string(n) + "x" + std::to_string(m);
+    const std::size_t households = kCells/(n*m);
+    const double      cells = static_cast<double>(households*n*m);
+
+    for (std::size_t f = 0; f < 4; ++f) {
+      CountingBuffer sink;
+      std::ostream   os(&sink);
+      std::size_t    capacity = 0;
+
+      RunBenchmark(std::string(kNames[f]) + "/" + label, "cells", cells, [&]() {
+        OutputWriter w;
+        InitOutputWriter(w, os, kFormats[f], true);
+        for (std::size_t h = 0; h < households; ++h) {
+          WriteHousehold(w, persons, expenses, a);
+        }
+        capacity = std::max(capacity, w.buffer.capacity());
+        FinishOutputWriter(w);
+      });
+      std::printf("%-40s %14zu bytes buffered at most\n", "",
+                  capacity);
+    }  // -----  end for formats  -----
+  }  // -----  end for sizes  -----
+}   // -----  end of function BenchOutputWriter  -----
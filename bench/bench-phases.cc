@@ -0,0 +1,142 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-phases.cc
+//
+//    Description:  Times every phase of a single run of fairshare on
+//                  generated ledgers: ParseIniFile, StringToDouble,
+//                  CalculateRatio, LongestString, AllocateOrExit and
+//                  DisplayResults, for growing households and all
+//                  number formats of the generator.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 09:31:40 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "output-writer.h"
+#include "fairshare.h"
+#include "helper-functions.h"
+#include "ledger-generator.h"
+#include "bench.h"
+
+namespace {
+// the incomes and costs of a generated ledger, as written
+void CollectNumbers (const std::string & text,
+                     std::vector<std::string> & numbers) {
+  numbers.clear();
+  std::size_t begin = 0;
+  while (begin < text.size()) {
+    std::size_t end = text.find('\n', begin);
+    if (end == std::string::npos) {
+      end = text.size();
+    }
+    const std::size_t equal = text.find(" = ", begin);
+    if (equal < end && text.compare(begin, 4, "name") != 0) {
+      numbers.push_back(text.substr(equal + 3, end - equal - 3));
+    }
+    begin = end + 1;
+  }  // -----  end while  -----
+}
+}  // -----  end of namespace  -----
+
+void BenchPhases () {
+  struct { std::size_t persons, expenses, nameLength; } kSizes[] = {
+    { 2,   4,    8  },
+    { 10,  100,  16 },
+    { 100, 1000, 32 },
+  };
+  const NumberFormat kFormats[] = {
+    NumberInteger, NumberFixed, NumberLong, NumberExponent,
+  };
+  const std::string fileName = "/tmp/fairshare-bench-phases.ini";
+  options.noCache = true;  // time the parser, see ledger-cache for the cache
+
+  std::string              text;
+  std::vector<std::string> numbers;
+  Allocation               allocation;
+  CountingBuffer           sink;
+  std::ostream             os(&sink);
+
+  for (std::size_t s = 0; s < 3; ++s) {
+    LedgerSpec spec;
+    InitLedgerSpec(spec);
+    spec.persons    = kSizes[s].persons;
+    spec.expenses   = kSizes[s].expenses;
+    spec.nameLength = kSizes[s].nameLength;
+
+    // reading depends on the number format, everything after it not
+    for (std::size_t f = 0; f < 4; ++f) {
+      spec.format = kFormats[f];
+      GenerateLedger(spec, text);
+      std::ofstream(fileName) << text;
+
+      const std::string label = LedgerLabel(spec);
+      RunBenchmark("ParseIniFile/" + label, "bytes",
+                   static_cast<double>(text.size()), [&]() {
+        ParseIniFile(fileName);
+        DoNotOptimize(expenses.size());
+      });
+
+      CollectNumbers(text, numbers);
+      RunBenchmark("StringToDouble/" + label, "numbers",
+                   static_cast<double>(numbers.size()), [&]() {
+        double sum = 0.;
+        for (std::size_t k = 0; k < numbers.size(); ++k) {
+          sum += StringToDouble(numbers[k]);
+        }
+        DoNotOptimize(sum);
+      });
+    }  // -----  end for  -----
+
+    spec.format = NumberFixed;
+    GenerateLedger(spec, text);
+    std::ofstream(fileName) << text;
+    ParseIniFile(fileName);
+
+    const std::string label = LedgerLabel(spec);
+    const double      n     = static_cast<double>(persons.size());
+    const double      e     = static_cast<double>(expenses.size());
+
+    RunBenchmark("CalculateRatio/" + label, "persons", n, [&]() {
+      const double ratio = CalculateRatio(persons);
+      DoNotOptimize(ratio);
+    });
+    RunBenchmark("LongestString/" + label, "names", n + e, [&]() {
+      const int longest = std::max(LongestString(persons),
+                                   LongestString(expenses));
+      DoNotOptimize(longest);
+    });
+    RunBenchmark("AllocateOrExit/" + label, "shares", n*e, [&]() {
+      AllocateOrExit(persons, expenses, allocation);
+      DoNotOptimize(allocation.totals[0]);
+    });
+
+    sink.bytes = 0;
+    DisplayResults(persons, expenses, allocation, os);
+    const double tableBytes = static_cast<double>(sink.bytes);
+    RunBenchmark("DisplayResults/" + label, "bytes", tableBytes, [&]() {
+      DisplayResults(persons, expenses, allocation, os);
+    });
+  }  // -----  end for  -----
+
+  std::remove(fileName.c_str());
+}   // -----  end of function BenchPhases  -----
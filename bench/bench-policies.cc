@@ -0,0 +1,177 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-policies.cc
+//
+//    Description:  Compares splitting ledgers whose expenses mix all four
+//                  policies with the single policy path of AllocateShares,
+//                  and the grouped kernels of AllocatePolicies with a
+//                  switch over the policy of every cell. Larger ledgers
+//                  are run if FAIRSHARE_BENCH_HUGE is set.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 02:07:33 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <algorithm> // max
+#include <cmath>     // fabs
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>   // getenv
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "bench.h"
+
+namespace {
+// n persons and m expenses; with mixed the policies take turns, so that
+// neighbouring expenses never share one
+void MakeLedger (const std::size_t n, const std::size_t m, const bool mixed,
+                 std::vector<Person> & persons,
+                 std::vector<Expense> & expenses) {
+  uint64_t state = 0x9e3779b97f4a7c15ull;
+  persons.resize(n);
+  for (std::size_t j = 0; j < n; ++j) {
+    state = state*6364136223846793005ull + 1442695040888963407ull;
+    persons[j].name   = "p" + std::to_string(j);
+    persons[j].income = 1000. + static_cast<double>((state >> 33) % 4000);
+  }
+  expenses.resize(m);
+  for (std::size_t i = 0; i < m; ++i) {
+    state = state*6364136223846793005ull + 1442695040888963407ull;
+    Expense & e = expenses[i];
+    e.name   = "e" + std::to_string(i);
+    e.cost   = 10. + static_cast<double>((state >> 33) % 1000);
+    e.policy = mixed ? static_cast<ExpensePolicy>(i % 4) : PolicyIncome;
+    e.weights.clear();
+    if (e.policy == PolicyWeighted || e.policy == PolicyFixed) {
+      for (std::size_t j = 0; j < n; ++j) {
+        state = state*6364136223846793005ull + 1442695040888963407ull;
+        e.weights.push_back(static_cast<double>((state >> 33) % 100)/10.);
+      }
+    }
+  }  // -----  end for  -----
+}
+
+// what AllocatePolicies replaces: every cell asks for its policy
+void SplitPerCell (const std::vector<Person>  & persons,
+                   const std::vector<Expense> & expenses,
+                   std::vector<double> & sums,
+                   std::vector<double> & shares) {
+  const std::size_t n = persons.size();
+  const std::size_t m = expenses.size();
+  shares.resize(n*m);
+
+  double sumIncomes = 0.;
+  for (std::size_t j = 0; j < n; ++j) {
+    sumIncomes += persons[j].income;
+  }
+  // the sums of the weights once per expense, as AllocatePolicies does
+  sums.assign(m, 0.);
+  for (std::size_t i = 0; i < m; ++i) {
+    for (std::size_t k = 0; k < expenses[i].weights.size(); ++k) {
+      sums[i] += expenses[i].weights[k];
+    }
+  }
+  for (std::size_t j = 0; j < n; ++j) {
+    for (std::size_t i = 0; i < m; ++i) {
+      const Expense & e     = expenses[i];
+      double          share = 0.;
+      switch (e.policy) {
+        case PolicyIncome:
+          share = persons[j].income/sumIncomes*e.cost;
+          break;
+        case PolicyEqual:
+          share = e.cost/static_cast<double>(n);
+          break;
+        case PolicyWeighted:
+          share = e.weights[j]/sums[i]*e.cost;
+          break;
+        case PolicyFixed:
+          share = e.weights[j]
+                  + persons[j].income/sumIncomes*(e.cost - sums[i]);
+          break;
+        default:
+          break;
+      }  // -----  end switch  -----
+      shares[j*m + i] = share;
+    }  // -----  end for expenses  -----
+  }  // -----  end for persons  -----
+}
+}  // -----  end of namespace  -----
+
+void BenchPolicies () {
+  struct { std::size_t persons, expenses; } kSizes[] = {
+    { 4,    16 },
+    { 64,   256 },
+    { 1000, 1000 },
+  };
+  const std::size_t sizes = std::getenv("FAIRSHARE_BENCH_HUGE") != NULL ? 3 : 2;
+
+  for (std::size_t s = 0; s < sizes; ++s) {
+    const std::size_t n     = kSizes[s].persons;
+    const std::size_t m     = kSizes[s].expenses;
+    const double      cells = static_cast<double>(n*m);
+    const std::string label = std::to_string(n) + "x" + std::to_string(m);
+
+    std::vector<Person>  persons;
+    std::vector<Expense> single;
+    std::vector<Expense> mixed;
+    MakeLedger(n, m, false, persons, single);
+    MakeLedger(n, m, true,  persons, mixed);
+
+    Allocation a;
+    RunBenchmark("Allocate single policy/" + label, "cells", cells, [&]() {
+      Allocate(persons, single, a);
+      DoNotOptimize(a.totals[0]);
+    });
+    RunBenchmark("AllocatePolicies single policy/" + label, "cells", cells,
+                 [&]() {
+      AllocatePolicies(persons, single, a);
+      DoNotOptimize(a.totals[0]);
+    });
+    RunBenchmark("Allocate mixed policies/" + label, "cells", cells, [&]() {
+      Allocate(persons, mixed, a);
+      DoNotOptimize(a.totals[0]);
+    });
+    std::vector<double> sums;
+    std::vector<double> shares;
+    RunBenchmark("switch per cell mixed policies/" + label, "cells", cells,
+                 [&]() {
+      SplitPerCell(persons, mixed, sums, shares);
+      DoNotOptimize(shares[0]);
+    });
+    RunBenchmark("AllocateInCents single policy/" + label, "cells", cells,
+                 [&]() {
+      AllocateInCents(persons, single, a);
+      DoNotOptimize(a.totals[0]);
+    });
+    RunBenchmark("AllocateInCents mixed policies/" + label, "cells", cells,
+                 [&]() {
+      AllocateInCents(persons, mixed, a);
+      DoNotOptimize(a.totals[0]);
+    });
+
+    Allocate(persons, mixed, a);
+    double deviation = 0.;
+    for (std::size_t k = 0; k < n*m; ++k) {
+      deviation = std::max(deviation, std::fabs(a.shares[k] - shares[k]));
+    }
+    double paid = 0.;
+    for (std::size_t j = 0; j < n; ++j) {
+      paid += a.totals[j];
+    }
+    std::printf("%s: grouped and per cell differ by at most %.3g, "
+                "%.2f of %.2f paid\n", label.c_str(), deviation, paid,
+                a.sumCosts);
+  }  // -----  end for  -----
+}   // -----  end of function BenchPolicies  -----
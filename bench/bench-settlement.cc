@@ -0,0 +1,155 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-settlement.cc
+//
+//    Description:  Times the settlement engine on groups of thousands of
+//                  members: the greedy plan on random balances, the run
+//                  from a payments file to the plan on an allocation
+//                  done beforehand, and the exact plan on small groups,
+//                  whose transfers are compared with the greedy ones. Larger groups are run if
+//                  FAIRSHARE_BENCH_HUGE is set.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 03:18:52 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>   // getenv
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "settlement.h"
+#include "bench.h"
+
+namespace {
+uint64_t Next (uint64_t & state) {
+  state = state*6364136223846793005ull + 1442695040888963407ull;
+  return state >> 33;
+}
+
+// n random balances of up to 1000.00 that add up to zero
+void MakeBalances (const std::size_t n, std::vector<int64_t> & balances) {
+  uint64_t state = 0x9e3779b97f4a7c15ull;
+  int64_t  sum   = 0;
+  balances.resize(n);
+  for (std::size_t j = 0; j + 1 < n; ++j) {
+    balances[j] = static_cast<int64_t>(Next(state) % 200001) - 100000;
+    sum        += balances[j];
+  }
+  balances[n - 1] = -sum;
+}
+
+// n balances made of pairs and triples that add up to zero, shuffled, so
+// that the fewest transfers are well below n - 1
+void MakeGroupedBalances (const std::size_t n,
+                          std::vector<int64_t> & balances) {
+  uint64_t state = 0x2545f4914f6cdd1dull;
+  balances.clear();
+  while (balances.size() < n) {
+    const int64_t a = static_cast<int64_t>(Next(state) % 100000) + 1;
+    if (n - balances.size() == 2 || (n - balances.size() > 3
+                                     && Next(state) % 2 == 0)) {
+      balances.push_back(a);
+      balances.push_back(-a);
+    } else {
+      const int64_t b = static_cast<int64_t>(Next(state) % 100000) + 1;
+      balances.push_back(a);
+      balances.push_back(b);
+      balances.push_back(-a - b);
+    }
+  }  // -----  end while  -----
+  for (std::size_t j = n; j-- > 1; ) {
+    std::swap(balances[j], balances[Next(state) % (j + 1)]);
+  }
+}
+
+// a household of n members sharing m expenses, each paid by one of them
+void MakePayments (const std::size_t n, const std::size_t m,
+                   std::vector<Person> & persons,
+                   std::vector<Expense> & expenses, std::string & text) {
+  uint64_t state = 0x9e3779b97f4a7c15ull;
+  persons.resize(n);
+  for (std::size_t j = 0; j < n; ++j) {
+    persons[j].name   = "member" + std::to_string(j);
+    persons[j].income = 1000. + static_cast<double>(Next(state) % 4000);
+  }
+  expenses.resize(m);
+  text = "[payments]\n";
+  for (std::size_t i = 0; i < m; ++i) {
+    expenses[i].name = "expense" + std::to_string(i);
+    expenses[i].cost = static_cast<double>(100 + Next(state) % 100000);
+    text += persons[Next(state) % n].name + " = " + expenses[i].name + " "
+            + std::to_string(static_cast<int64_t>(expenses[i].cost)) + "\n";
+  }
+}
+}  // -----  end of namespace  -----
+
+void BenchSettlement () {
+  const std::size_t kMembers[] = { 1000, 10000, 100000, 1000000 };
+  const std::size_t sizes = std::getenv("FAIRSHARE_BENCH_HUGE") != NULL ? 4 : 3;
+
+  Settlement s;
+  InitSettlement(s);
+  for (std::size_t k = 0; k < sizes; ++k) {
+    const std::size_t n     = kMembers[k];
+    const std::string label = std::to_string(n);
+    MakeBalances(n, s.balances);
+    RunBenchmark("PlanTransfers greedy/" + label, "members",
+                 static_cast<double>(n), [&]() {
+      PlanTransfers(s, false);
+      DoNotOptimize(s.transfers.data());
+    });
+    std::printf("%s members: %zu transfers\n", label.c_str(),
+                s.transfers.size());
+  }  // -----  end for  -----
+
+  const std::size_t kHouseholds[] = { 1000, 10000, 100000 };
+  for (std::size_t k = 0; k < 3; ++k) {
+    const std::size_t    n = kHouseholds[k];
+    const std::size_t    m = 64;
+    std::vector<Person>  persons;
+    std::vector<Expense> expenses;
+    std::string          text;
+    std::string          error;
+    Allocation           a;
+    MakePayments(n, m, persons, expenses, text);
+    AllocateHousehold(persons, expenses, true, a);
+    RunBenchmark("ParsePayments+Settle+Plan/" + std::to_string(n), "members",
+                 static_cast<double>(n), [&]() {
+      ParsePayments(text, "bench", persons, expenses, s, error);
+      SettleBalances(expenses, a, s, error);
+      PlanTransfers(s, false);
+      DoNotOptimize(s.transfers.data());
+    });
+    std::printf("%zu members, %zu expenses: %zu transfers%s%s\n", n, m,
+                s.transfers.size(), error.empty() ? "" : ", ",
+                error.c_str());
+  }  // -----  end for  -----
+
+  const std::size_t kExact[] = { 12, 16, 20 };
+  for (std::size_t k = 0; k < 3; ++k) {
+    const std::size_t n     = kExact[k];
+    const std::string label = std::to_string(n);
+    MakeGroupedBalances(n, s.balances);
+    PlanTransfers(s, false);
+    const std::size_t greedy = s.transfers.size();
+    RunBenchmark("PlanTransfers exact/" + label, "members",
+                 static_cast<double>(n), [&]() {
+      PlanTransfers(s, true);
+      DoNotOptimize(s.transfers.data());
+    });
+    std::printf("%s members: %zu transfers greedy, %zu exact\n",
+                label.c_str(), greedy, s.transfers.size());
+  }  // -----  end for  -----
+}   // -----  end of function BenchSettlement  -----
@@ -0,0 +1,98 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-share-model.cc
+//
+//    Description:  Compares the latency of an income or cost update in
+//                  the incremental share model with a full Allocate as
+//                  the group grows, and checks the model against the
+//                  full recompute after many random updates.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 07:34:12 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "share-model.h"
+#include "bench.h"
+
+void BenchShareModel () {
+  const std::size_t kPersons[]  = { 10, 100, 1000, 10000 };
+  const std::size_t kExpenses   = 100;
+  const std::size_t kUpdates    = 100000;
+
+  for (std::size_t s = 0; s < 4; ++s) {
+    const std::size_t n = kPersons[s];
+
+    std::vector<Person>  persons(n);
+    std::vector<Expense> expenses(kExpenses);
+    for (std::size_t j = 0; j < n; ++j) {
+      persons[j].name   = "person" + std::to_string(j);
+      persons[j].income = 1000. + static_cast<double>(j % 17)*125.37;
+    }
+    for (std::size_t i = 0; i < kExpenses; ++i) {
+      expenses[i].name = "expense" + std::to_string(i);
+      expenses[i].cost = 20. + static_cast<double>(i)*7.31;
+    }
+
+    ShareModel m;
+    InitShareModel(m, persons, expenses);
+    Allocation a;
+
+    const std::string label = std::to_string(n) + "x" + std::to_string(kExpenses);
+    std::size_t k = 0;
+    double      x = 0.;
+
+    RunBenchmark("Allocate/" + label, "updates", 1., [&]() {
+      persons[k % n].income += 1.;
+      ++k;
+      Allocate(persons, expenses, a);
+      DoNotOptimize(a.totals[0]);
+    });
+    RunBenchmark("UpdateIncome+1 share/" + label, "updates", 1., [&]() {
+      UpdateIncome(m, k % n, m.incomes[k % n] + 1.);
+      ++k;
+      x = ModelShare(m, 0, 0);
+      DoNotOptimize(x);
+    });
+    std::vector<double> column(n);
+    RunBenchmark("UpdateCost+column/" + label, "updates", 1., [&]() {
+      UpdateCost(m, k % kExpenses, m.costs[k % kExpenses] + 1.);
+      ++k;
+      ExpenseColumn(m, k % kExpenses, column.data());
+      DoNotOptimize(column[0]);
+    });
+
+    // random walk of updates, some of them cancelling most of a sum
+    InitShareModel(m, persons, expenses);
+    uint64_t state = 88172645463325252ull;
+    for (std::size_t u = 0; u < kUpdates; ++u) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      const double r = static_cast<double>(state % 100000)/100.;
+      if (state & 1) {
+        UpdateIncome(m, (state >> 8) % n, 1. + r);
+      } else {
+        UpdateCost(m, (state >> 8) % kExpenses, (state & 2) ? r : -r);
+      }
+    }
+    std::printf("%s: %zu updates, %lu resums, deviation from a full "
+                "recompute %.3g\n", label.c_str(), kUpdates,
+                static_cast<unsigned long>(m.resums),
+                ShareModelDeviation(m, a));
+  }  // -----  end for  -----
+}   // -----  end of function BenchShareModel  -----
@@ -0,0 +1,116 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-summation.cc
+//
+//    Description:  Compares the reproducible sums of summation.cc with a
+//                  plain loop, which this file, like every other, lets
+//                  -ffast-math vectorize and reorder: on the costs of a
+//                  household, on a column of a million amounts, and in
+//                  AllocateShares on a batch of small households. Also
+//                  prints the errors of all of them against an exact sum.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 01:37:52 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "allocation.h"
+#include "summation.h"
+#include "bench.h"
+
+namespace {
+double SumNaive (const double * x, const std::size_t n) {
+  double sum = 0.;
+  for (std::size_t k = 0; k < n; ++k) {
+    sum += x[k];
+  }
+  return sum;
+}
+
+// amounts in cents from 0.01 to 10^7, the exact sum of which is known
+// from the integers
+void MakeAmounts (const std::size_t n, std::vector<double> & x,
+                  int64_t & cents) {
+  uint64_t state = 88172645463325252ull;
+  x.resize(n);
+  cents = 0;
+  for (std::size_t k = 0; k < n; ++k) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    const int64_t c = static_cast<int64_t>(state % 1000000000ull) + 1;
+    x[k]   = static_cast<double>(c)/100.;
+    cents += c;
+  }
+}
+}  // -----  end of namespace  -----
+
+void BenchSummation () {
+  const std::size_t kSizes[] = { 8, 1000000 };
+  for (std::size_t s = 0; s < 2; ++s) {
+    const std::size_t   n     = kSizes[s];
+    const std::string   label = std::to_string(n);
+    std::vector<double> x;
+    int64_t             cents = 0;
+    MakeAmounts(n, x, cents);
+
+    double naive       = 0.;
+    double pairwise    = 0.;
+    double compensated = 0.;
+    RunBenchmark("SumNaive/" + label, "values", static_cast<double>(n),
+                 [&]() {
+      naive = SumNaive(x.data(), n);
+      DoNotOptimize(naive);
+    });
+    RunBenchmark("SumPairwise/" + label, "values", static_cast<double>(n),
+                 [&]() {
+      pairwise = SumPairwise(x.data(), n);
+      DoNotOptimize(pairwise);
+    });
+    RunBenchmark("SumCompensated/" + label, "values", static_cast<double>(n),
+                 [&]() {
+      compensated = SumCompensated(x.data(), n);
+      DoNotOptimize(compensated);
+    });
+
+    const double exact = static_cast<double>(cents)/100.;
+    std::printf("errors in ulps of the sum of %s amounts: naive %.1f, "
+                "pairwise %.1f, compensated %.1f\n", label.c_str(),
+                std::fabs(naive - exact)/(exact*2.220446049250313e-16),
+                std::fabs(pairwise - exact)/(exact*2.220446049250313e-16),
+                std::fabs(compensated - exact)/(exact*2.220446049250313e-16));
+  }  // -----  end for  -----
+
+  // the compensated sums where they are used, 100000 households of 3
+  // persons with 8 expenses
+  const std::size_t   kHouseholds = 100000;
+  const std::size_t   kExpenses   = 8;
+  std::vector<double> costs;
+  int64_t             cents = 0;
+  MakeAmounts(kHouseholds*kExpenses, costs, cents);
+  const double        incomes[] = { 1800., 2450.5, 990. };
+  std::vector<double> shares(3*kExpenses);
+  std::vector<double> totals(3);
+  RunBenchmark("AllocateShares/3 members", "households",
+               static_cast<double>(kHouseholds), [&]() {
+    double sum = 0.;
+    for (std::size_t h = 0; h < kHouseholds; ++h) {
+      sum += AllocateShares(incomes, 3, costs.data() + h*kExpenses, kExpenses,
+                            shares.data(), totals.data());
+    }
+    DoNotOptimize(sum);
+  });
+}   // -----  end of function BenchSummation  -----
@@ -0,0 +1,175 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-sweep.cc
+//
+//    Description:  Times the sweep engine on a million scenarios: the
+//                  kernel alone over one and two axes, for 2 and 8
+//                  persons, and with the binary and CSV writers, next to
+//                  the same scenarios split one by one with
+//                  AllocatePolicies.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 07:26:50 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "sweep.h"
+#include "output-writer.h"
+#include "bench.h"
+
+namespace {
+// n persons sharing an expense of every policy, like the example of the
+// README
+void MakeHousehold (const std::size_t n, std::vector<Person> & persons,
+                    std::vector<Expense> & expenses) {
+  persons.resize(n);
+  for (std::size_t j = 0; j < n; ++j) {
+    persons[j].name   = "person" + std::to_string(j + 1);
+    persons[j].income = 1000. + 500.*static_cast<double>(j);
+  }
+  const char *        kNames[]    = { "rent", "telecom", "power", "garage",
+                                      "food" };
+  const double        kCosts[]    = { 1200., 60., 80., 100., 400. };
+  const ExpensePolicy kPolicies[] = { PolicyIncome, PolicyEqual,
+                                      PolicyWeighted, PolicyFixed,
+                                      PolicyIncome };
+  expenses.resize(5);
+  for (std::size_t i = 0; i < 5; ++i) {
+    expenses[i].name   = kNames[i];
+    expenses[i].cost   = kCosts[i];
+    expenses[i].policy = kPolicies[i];
+    expenses[i].weights.clear();
+    if (kPolicies[i] == PolicyWeighted || kPolicies[i] == PolicyFixed) {
+      expenses[i].weights.assign(n, 10.);
+    }
+  }
+}
+
+// the sweep of the given specs, evaluated once
+bool MakeSweep (const std::vector<Person> & persons,
+                const std::vector<Expense> & expenses,
+                const std::vector<std::string> & specs, Sweep & s) {
+  std::string error;
+  s.axes.resize(specs.size());
+  for (std::size_t k = 0; k < specs.size(); ++k) {
+    if (!ParseSweepAxis(specs[k], persons, expenses, s.axes[k], error)) {
+      std::printf("%s\n", error.c_str());
+      return false;
+    }
+  }
+  if (!PrepareSweep(persons, expenses, s, error)) {
+    std::printf("%s\n", error.c_str());
+    return false;
+  }
+  return true;
+}
+
+void Rewind (Sweep & s) {
+  s.first = 0;
+  s.size  = 0;
+}
+}  // -----  end of namespace  -----
+
+void BenchSweep () {
+  std::vector<Person>  persons;
+  std::vector<Expense> expenses;
+  Sweep                s;
+
+  const std::size_t kPersons[] = { 2, 8 };
+  for (std::size_t k = 0; k < 2; ++k) {
+    const std::size_t n     = kPersons[k];
+    const std::string label = std::to_string(n) + " persons/1000000";
+    MakeHousehold(n, persons, expenses);
+
+    if (!MakeSweep(persons, expenses, { "1=1:1000000:1" }, s)) {
+      return;
+    }
+    RunBenchmark("Sweep 1 axis, " + label, "scenarios",
+                 static_cast<double>(s.scenarios), [&]() {
+      Rewind(s);
+      double sum = 0.;
+      while (NextSweepBlock(s)) {
+        sum += s.shares[0];
+      }
+      DoNotOptimize(sum);
+    });
+
+    if (!MakeSweep(persons, expenses,
+                   { "2=100:100000:100", "rent=1:1000:1" }, s)) {
+      return;
+    }
+    RunBenchmark("Sweep 2 axes, " + label, "scenarios",
+                 static_cast<double>(s.scenarios), [&]() {
+      Rewind(s);
+      double sum = 0.;
+      while (NextSweepBlock(s)) {
+        sum += s.shares[0];
+      }
+      DoNotOptimize(sum);
+    });
+  }  // -----  end for  -----
+
+  MakeHousehold(2, persons, expenses);
+  if (!MakeSweep(persons, expenses,
+                 { "2=100:100000:100", "rent=1:1000:1" }, s)) {
+    return;
+  }
+  CountingBuffer counter;
+  std::ostream   os(&counter);
+  RunBenchmark("Sweep 2 axes + binary, 2 persons/1000000", "scenarios",
+               static_cast<double>(s.scenarios), [&]() {
+    Rewind(s);
+    OutputWriter w;
+    InitSweepWriter(w, os, OutputBinary, persons, expenses, s);
+    while (NextSweepBlock(s)) {
+      WriteSweepBlock(w, s);
+    }
+    FinishOutputWriter(w);
+  });
+
+  if (!MakeSweep(persons, expenses,
+                 { "2=100:10000:100", "rent=1:1000:1" }, s)) {
+    return;
+  }
+  RunBenchmark("Sweep 2 axes + csv, 2 persons/100000", "scenarios",
+               static_cast<double>(s.scenarios), [&]() {
+    Rewind(s);
+    OutputWriter w;
+    InitSweepWriter(w, os, OutputCsv, persons, expenses, s);
+    while (NextSweepBlock(s)) {
+      WriteSweepBlock(w, s);
+    }
+    FinishOutputWriter(w);
+  });
+
+  // the same scenarios split one household at a time
+  Allocation a;
+  RunBenchmark("AllocatePolicies per scenario, 2 persons/100000",
+               "scenarios", 100000., [&]() {
+    double sum = 0.;
+    for (std::size_t x = 1; x <= 100; ++x) {
+      persons[1].income = 100.*static_cast<double>(x);
+      for (std::size_t r = 1; r <= 1000; ++r) {
+        expenses[0].cost = static_cast<double>(r);
+        AllocatePolicies(persons, expenses, a);
+        sum += a.totals[0];
+      }
+    }
+    DoNotOptimize(sum);
+  });
+}   // -----  end of function BenchSweep  -----
@@ -0,0 +1,255 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-table-renderer.cc
+//
+//    Description:  Compares RenderTable with the former iostream
+//                  implementation of DisplayResults on large tables and
+//                  checks that both produce the same bytes.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 04:02:55 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "table-renderer.h"
+#include "global-constants.h"
+#include "bench.h"
+
+namespace {
+// DisplayResults and LongestString as they were before RenderTable
+int LegacyLongestString (const std::vector<Expense> & expenses) {
+
+  size_t size = 0;
+
+  // go through the names of the expenses
+  for (auto e = expenses.begin(); e != expenses.end(); ++e) {
+    if ((*e).name.size() > size) {
+      size = (*e).name.size();
+    }  // -----  end if  ----- 
+  }  // -----  end for  ----- 
+
+  // go through the costs of the expenses
+  double sumCosts =0.;
+  for (auto e = expenses.begin(); e != expenses.end(); ++e) {
+      sumCosts += (*e).cost;
+  }  // -----  end for  ----- 
+    std::ostringstream sstream;
+    sstream << std::setprecision(2) << std::fixed << sumCosts;
+    std::string costAsString = sstream.str(); 
+
+    if (costAsString.size() > size) {
+      size = costAsString.size();
+    }  // -----  end if  ----- 
+
+  return static_cast<int>(size);
+}  // -----  end of function LongestString  -----
+
+int LegacyLongestString (const std::vector<Person> & persons) {
+
+  size_t size = 0;
+
+  // go through the names of the persons
+  for (auto p = persons.begin(); p != persons.end(); ++p) {
+    if ((*p).name.size() > size) {
+      size = (*p).name.size();
+    }  // -----  end if  ----- 
+
+    // go through the income of the persons
+    std::ostringstream sstream;
+    sstream << std::setprecision(2) << std::fixed << (*p).income;
+    std::string incomeAsString = sstream.str(); 
+
+    if (incomeAsString.size() > size) {
+      size = incomeAsString.size();
+    }  // -----  end if  ----- 
+  }  // -----  end for  ----- 
+
+  return static_cast<int>(size);
+}  // -----  end of function LongestString  -----
+
+void LegacyDisplayResults (const std::vector<Person> & p, const std::vector<Expense> &e,
+                           const Allocation & a, std::ostream & os) {
+
+  using namespace std;
+
+  int width_expense = LegacyLongestString(e);
+  int width_person  = LegacyLongestString(p);
+  int width_income  = 10; // widths of the string "Name/Costs"
+
+  int width = width_income;
+  if (width_expense > width) {
+    width = width_expense;
+  }  // -----  end if  ----- 
+  if (width_person > width) {
+    width = width_person;
+  }  // -----  end if  ----- 
+  width += 4; // to add a space before the word and three spaces behind
+
+  ostringstream topLine;
+  ostringstream separatorLine;
+
+  // We have to add +1 to the width, for the top line, bottom line,
+  // separator line, since the output of separator symbol "+" is added to
+  // the total width of the line, but for us "width" means the width of the
+  // "inner" column
+  topLine
+    << " "
+    << setfill('=')
+    << setw(width+1)  << "="  // cost   column
+    << setw(width+1)  << "="; // income column
+  for (auto i = e.begin(); i != e.end(); ++i) {
+    topLine
+      << setw(width+1) << "=";
+  }  // -----  end for  ----- 
+  topLine
+    << setw(width+1)  << "=" // total column
+    << setfill(' ')
+    << '\n';
+
+  separatorLine 
+    << " "
+    << setfill('-')
+    << setw(width+1)  << "+"
+    << setw(width+1)  << "+";
+  for (auto i = e.begin(); i != e.end(); ++i) {
+  separatorLine
+    << setw(width+1) << "+";
+  }  // -----  end for  ----- 
+  separatorLine
+    << setw(width+1)  << "|"
+    << setfill(' ')
+    << '\n';
+
+  // here we have to substract -1 from the width, as we have as a separator
+  // not simply a one char "|", but two chars " |"
+  os 
+    << '\n'
+    << '\n'
+    << " "
+    << left
+    << setw(width-1)
+    << " " << " |" 
+    << setw(width-1) << setprecision(2) << fixed << left
+    << " Income" << " |";
+  for (auto i = e.begin(); i != e.end(); ++i) {
+    os
+    << " "  
+    << setw(width-2) << setprecision(2) << fixed << left
+    << (*i).name << " |";
+  }  // -----  end for  ----- 
+  os 
+    << setw(width-1) << fixed << left
+    << " Total" << " |" 
+    << '\n'
+    << topLine.str();
+
+  os 
+    << " "
+    << right
+    << setw(width-1)
+    << "Name/Costs" << " |" 
+    << setw(width-1) << setprecision(2) << fixed << right
+    << " " <<  " |";
+  for (auto i = e.begin(); i != e.end(); ++i) {
+    os
+      << setw(width-1) << setprecision(2) << fixed << right
+      << (*i).cost << " |";
+  }  // -----  end for  ----- 
+  os 
+    << setw(width-1) << setprecision(2) << fixed << right
+    << a.sumCosts << " |" 
+    << '\n'
+    << separatorLine.str();
+
+  for (size_t j = 0; j < p.size(); ++j) {
+    os 
+      << " "
+      << right
+      << setw(width-1)
+      << p[j].name << " |" 
+      << setw(width-1) << setprecision(2) << fixed << right
+      << p[j].income << " |";
+
+    for (size_t i = 0; i < e.size(); ++i) {
+      os 
+        << setw(width-1) << setprecision(2) << fixed << right
+        << Share(a, j, i) << " |";
+    }  // -----  end for expenses  ----- 
+    os 
+      << setw(width-1) << setprecision(2) << fixed << right
+      << a.totals[j] << " |" 
+      << '\n';
+      if (j+1 != p.size()) {
+        os << separatorLine.str();
+      }
+  }  // -----  end for persons  ----- 
+
+  double percentTotal = a.sumCosts*a.ratio;
+  os
+    << '\n'
+    << '\n'
+    <<"Every person pays a fair share of "
+    << bold << 100*percentTotal <<"%" << normal
+    <<" of her/his income."
+    << '\n';
+}  // -----  end of function DisplayResults  -----
+
+}  // -----  end of namespace  -----
+
+void BenchTableRenderer () {
+  const std::size_t kSizes[][2] = { { 2, 5 }, { 100, 50 }, { 1000, 200 } };
+
+  for (std::size_t s = 0; s < 3; ++s) {
+    const std::size_t n = kSizes[s][0];
+    const std::size_t m = kSizes[s][1];
+
+    std::vector<Person>  persons(n);
+    std::vector<Expense> expenses(m);
+    for (std::size_t j = 0; j < n; ++j) {
+      persons[j].name   = "person" + std::to_string(j);
+      persons[j].income = 1000. + static_cast<double>(j % 17)*125.37;
+    }
+    for (std::size_t i = 0; i < m; ++i) {
+      expenses[i].name = "expense" + std::to_string(i);
+      expenses[i].cost = 20. + static_cast<double>(i)*7.31;
+    }
+    Allocation a;
+    Allocate(persons, expenses, a);
+
+    const std::string label = std::to_string(n) + "x" + std::to_string(m);
+    const double      cells = static_cast<double>(n*m);
+
+    std::ostringstream legacy;
+    LegacyDisplayResults(persons, expenses, a, legacy);
+    TableBuffer table;
+    RenderTable(persons, expenses, a, table);
+    std::printf("%s: output %s\n", label.c_str(),
+                legacy.str() == table.text ? "identical" : "DIFFERS");
+
+    RunBenchmark("iostream/" + label, "cells", cells, [&]() {
+      std::ostringstream os;
+      LegacyDisplayResults(persons, expenses, a, os);
+      DoNotOptimize(os.tellp());
+    });
+    RunBenchmark("RenderTable/" + label, "cells", cells, [&]() {
+      RenderTable(persons, expenses, a, table);
+      DoNotOptimize(table.text.size());
+    });
+  }  // -----  end for  -----
+}   // -----  end of function BenchTableRenderer  -----
@@ -0,0 +1,119 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-time-series.cc
+//
+//    Description:  Compares a series batch of ten years of monthly
+//                  amounts per household with running the same months
+//                  as separate snapshot households, as before --series.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 11:52:40 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "output-writer.h"
+#include "batch-executor.h"
+#include "bench.h"
+
+namespace {
+const std::size_t kPeriods = 120;
+
+// Appends household h as one series household to series and as
+// kPeriods snapshot households to months. The second income and the
+// utilities change every month, the rest is constant.
+void AppendHousehold (const std::size_t h, std::string & series,
+                      std::string & months) {
+  const std::size_t n = 2 + h % 4;
+  std::string incomes;
+  std::string utilities;
+  for (std::size_t t = 0; t < kPeriods; ++t) {
+    incomes   += " " + std::to_string(1800 + (h*7 + t*13) % 900) + ".25";
+    utilities += " " + std::to_string(100 + (h + t*31) % 100) + ".50";
+  }
+
+  for (std::size_t j = 0; j < n; ++j) {
+    series += "[person" + std::to_string(j + 1) + "]\nname = p"
+              + std::to_string(j) + "\nincome ="
+              + (j == 1 ? incomes : " " + std::to_string(1000 + 500*j))
+              + "\n";
+  }
+  series += "[expenses]\nrent = 1000\nutilities =" + utilities
+            + "\nfood = 200\ntelephone = 19.99\ninsurance = 77.10\n";
+
+  for (std::size_t t = 0; t < kPeriods; ++t) {
+    for (std::size_t j = 0; j < n; ++j) {
+      months += "[person" + std::to_string(j + 1) + "]\nname = p"
+                + std::to_string(j) + "\nincome = "
+                + (j == 1 ? incomes.substr(1 + 8*t, 7)
+                          : std::to_string(1000 + 500*j))
+                + "\n";
+    }
+    months += "[expenses]\nrent = 1000\nutilities = "
+              + utilities.substr(1 + 7*t, 6)
+              + "\nfood = 200\ntelephone = 19.99\ninsurance = 77.10\n";
+  }
+}
+}  // -----  end of namespace  -----
+
+void BenchTimeSeries () {
+  const std::size_t kHouseholds = 1000;
+  const unsigned    cores       = std::thread::hardware_concurrency();
+
+  std::string series;
+  std::string months;
+  for (std::size_t h = 0; h < kHouseholds; ++h) {
+    AppendHousehold(h, series, months);
+  }
+  std::printf("%zu households of %zu months: series %zu bytes, "
+              "monthly households %zu bytes\n", kHouseholds, kPeriods,
+              series.size(), months.size());
+
+  BatchJob job;
+  job.fileName = "bench";
+  job.cents    = false;
+  job.format   = OutputCsv;
+  job.rejects  = NULL;
+
+  uint64_t    households = 0;
+  std::string error;
+  const std::string label = std::to_string(kHouseholds) + "x"
+                            + std::to_string(kPeriods) + " months";
+  for (unsigned threads = 1; threads <= cores; threads = 2*threads) {
+    job.threads = threads;
+    const std::string suffix = "/" + label + "/" + std::to_string(threads)
+                               + " threads";
+
+    CountingBuffer sink;
+    std::ostream   os(&sink);
+    job.text   = months;
+    job.series = false;
+    RunBenchmark("monthly households csv" + suffix, "household-months",
+                 static_cast<double>(kHouseholds*kPeriods), [&]() {
+      RunBatchJob(job, os, households, error);
+    });
+    job.text   = series;
+    job.series = true;
+    RunBenchmark("series csv" + suffix, "household-months",
+                 static_cast<double>(kHouseholds*kPeriods), [&]() {
+      RunBatchJob(job, os, households, error);
+    });
+    job.format = OutputTable;
+    RunBenchmark("series table" + suffix, "household-months",
+                 static_cast<double>(kHouseholds*kPeriods), [&]() {
+      RunBatchJob(job, os, households, error);
+    });
+    job.format = OutputCsv;
+  }  // -----  end for  -----
+}   // -----  end of function BenchTimeSeries  -----
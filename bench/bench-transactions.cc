@@ -0,0 +1,115 @@
+//
+// =========================================================================
+//
+//       Filename:  bench-transactions.cc
+//
+//    Description:  Times the ingester of bank statements on exports of a
+//                  million transactions with a thousand descriptions:
+//                  the scan of text in memory, and reading a file in
+//                  chunks, in bytes per second. A file of ten million
+//                  transactions is read if FAIRSHARE_BENCH_HUGE is set.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 09:02:16 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>   // getenv
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "transactions.h"
+#include "bench.h"
+
+namespace {
+const char kRules[] =
+  "[format]\n"
+  "separator = ;\n"
+  "decimal   = ,\n"
+  "key       = 3\n"
+  "amount    = 4\n"
+  "[rules]\n"
+  "rent  = landlord\n"
+  "food  = grocer\n"
+  "power = utility\n";
+
+uint64_t Next (uint64_t & state) {
+  state = state*6364136223846793005ull + 1442695040888963407ull;
+  return state >> 33;
+}
+
+// n lines of a German export, some descriptions quoted
+void MakeExport (const std::size_t n, std::string & text) {
+  const char * kKinds[] = { "landlord", "grocer", "utility", "salary" };
+  uint64_t     state    = 0x9e3779b97f4a7c15ull;
+  text = "Date;Value date;Description;Amount\n";
+  for (std::size_t k = 0; k < n; ++k) {
+    const uint64_t d     = Next(state) % 1000;
+    const uint64_t cents = Next(state) % 200000;
+    const bool     quote = d % 7 == 0;
+    text += "12.03.2026;13.03.2026;";
+    text += quote ? "\"" : "";
+    text += kKinds[d % 4];
+    text += " no. " + std::to_string(d) + " reference 4711";
+    text += quote ? "\";-" : ";-";
+    text += std::to_string(cents/100) + "," + std::to_string(cents/10 % 10)
+            + std::to_string(cents % 10) + "\n";
+  }
+}
+}  // -----  end of namespace  -----
+
+void BenchTransactions () {
+  const std::string fileName = "/tmp/fairshare-bench-transactions.csv";
+  const bool        huge     = std::getenv("FAIRSHARE_BENCH_HUGE") != NULL;
+
+  TransactionLedger t;
+  std::string       error;
+  InitTransactionLedger(t);
+  if (!ParseTransactionRules(kRules, "bench", t, error)) {
+    std::printf("%s\n", error.c_str());
+    return;
+  }
+
+  std::string text;
+  MakeExport(1000000, text);
+  RunBenchmark("ScanTransactions/1000000", "bytes",
+               static_cast<double>(text.size()), [&]() {
+    std::size_t consumed = 0;
+    t.lines = 0;
+    ScanTransactions(text, t, consumed, error);
+    DoNotOptimize(consumed);
+  });
+
+  const std::size_t kLines[] = { 1000000, 10000000 };
+  for (std::size_t k = 0; k < (huge ? 2 : 1); ++k) {
+    MakeExport(kLines[k], text);
+    std::ofstream(fileName) << text;
+    const std::string label = std::to_string(kLines[k]);
+    RunBenchmark("IngestTransactions/" + label, "bytes",
+                 static_cast<double>(text.size()), [&]() {
+      IngestTransactions(fileName, t, error);
+      DoNotOptimize(t.transactions);
+    });
+
+    std::vector<Expense>  expenses;
+    TransactionSummary    summary;
+    ApplyTransactions(t, expenses, summary);
+    std::printf("%s transactions, %.1f MB, %zu descriptions, %zu expenses, "
+                "%llu unmatched%s%s\n", label.c_str(),
+                static_cast<double>(text.size())/1e6, t.cents.size(),
+                expenses.size(),
+                static_cast<unsigned long long>(summary.unmatchedTransactions),
+                error.empty() ? "" : ", ", error.c_str());
+  }  // -----  end for  -----
+  std::remove(fileName.c_str());
+}   // -----  end of function BenchTransactions  -----
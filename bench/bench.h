@@ -0,0 +1,151 @@
+//
+// =========================================================================
+//
+//       Filename:  bench.h
+//
+//    Description:  Declares a minimal benchmark harness and the
+//                  benchmarks of the fairshare-bench executable.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 10:02:17 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  BENCH_INC
+#define  BENCH_INC
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <streambuf>
+#include <string>
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+struct bench_result {
+  std::string name;
+  std::string unit;           // what one item is, e.g. "cells"
+  std::size_t iterations;
+  double      nsPerOp;
+  double      itemsPerSecond;
+  double      bytesPerOp;     // allocated by operator new per call
+  double      allocationsPerOp;
+};  // -----  end of struct bench_result  -----
+
+typedef struct bench_result BenchResult;
+
+// Totals of the operator new of the benchmark binary, see
+// allocation-counter.cc.
+struct allocation_counters {
+  uint64_t allocations;
+  uint64_t bytes;
+};  // -----  end of struct allocation_counters  -----
+
+typedef struct allocation_counters AllocationCounters;
+
+//--------------------------------------------------------------------------
+//  harness
+//--------------------------------------------------------------------------
+// A stream buffer that counts and drops everything written to it, to
+// measure writers without the cost of a file or terminal.
+class CountingBuffer : public std::streambuf {
+ public:
+  std::streamsize bytes = 0;
+
+ protected:
+  std::streamsize xsputn (const char *, std::streamsize n) override {
+    bytes += n;
+    return n;
+  }
+  int_type overflow (int_type c) override {
+    ++bytes;
+    return c;
+  }
+};
+
+// Keeps the compiler from optimising away a computed value.
+template <typename T>
+inline void DoNotOptimize (const T & value) {
+  __asm__ __volatile__ ("" : : "r"(&value) : "memory");
+}
+
+AllocationCounters CountAllocations ();
+void               ReportBenchResult (const BenchResult & r);
+
+// ===  FUNCTION  ==========================================================
+//         Name:  RunBenchmark
+//  Description:  Calls f() in batches of doubling size until a batch
+//                takes at least kMinSeconds and reports the time per
+//                call, the throughput in items (itemsPerOp per call)
+//                per second and the memory allocated per call.
+// =========================================================================
+template <typename F>
+BenchResult RunBenchmark (const std::string & name, const std::string & unit,
+                          const double itemsPerOp, F f) {
+  typedef std::chrono::steady_clock Clock;
+  const double kMinSeconds = 0.2;
+
+  f(); // warm up caches
+
+  std::size_t        iterations = 1;
+  double             seconds    = 0.;
+  AllocationCounters before;
+  for (;;) {
+    before = CountAllocations();
+    const Clock::time_point start = Clock::now();
+    for (std::size_t k = 0; k < iterations; ++k) {
+      f();
+    }
+    seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (seconds >= kMinSeconds) {
+      break;
+    }
+    iterations *= 2;
+  }  // -----  end for  -----
+  const AllocationCounters after = CountAllocations();
+
+  BenchResult r;
+  r.name             = name;
+  r.unit             = unit;
+  r.iterations       = iterations;
+  r.nsPerOp          = 1e9*seconds/static_cast<double>(iterations);
+  r.itemsPerSecond   = itemsPerOp*static_cast<double>(iterations)/seconds;
+  r.bytesPerOp       = static_cast<double>(after.bytes - before.bytes)
+                       / static_cast<double>(iterations);
+  r.allocationsPerOp = static_cast<double>(after.allocations
+                                           - before.allocations)
+                       / static_cast<double>(iterations);
+  ReportBenchResult(r);
+  return r;
+}  // -----  end of function RunBenchmark  -----
+
+//--------------------------------------------------------------------------
+//  benchmarks
+//--------------------------------------------------------------------------
+void BenchAllocation ();
+void BenchIniParser  ();
+void BenchNumberParser ();
+void BenchTableRenderer ();
+void BenchOutputWriter ();
+void BenchShareModel ();
+void BenchBatchExecutor ();
+void BenchPhases ();
+void BenchEmbedded ();
+void BenchHouseholdStore ();
+void BenchLedgerCache ();
+void BenchTimeSeries ();
+void BenchGroupTree ();
+void BenchPolicies ();
+void BenchSettlement ();
+void BenchSweep ();
+void BenchTransactions ();
+void BenchChunkReader ();
+void BenchSummation ();
+
+#endif   //---- #ifndef BENCH_INC  -----
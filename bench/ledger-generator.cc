@@ -0,0 +1,202 @@
+//
+// =========================================================================
+//
+//       Filename:  ledger-generator.cc
+//
+//    Description:  Writes synthetic ledgers in the format of settings.ini.
+//                  The same spec always gives the same text, so results
+//                  of different runs and machines stay comparable.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 09:31:40 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "ledger-generator.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+uint64_t Next (uint64_t & state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+// uniform in [low, high)
+double Uniform (uint64_t & state, const double low, const double high) {
+  const double u = static_cast<double>(Next(state) >> 11)*0x1p-53;
+  return low + (high - low)*u;
+}
+
+// prefix followed by the number and random letters up to length
+void AppendName (std::string & text, const char prefix, const std::size_t k,
+                 const std::size_t length, uint64_t & state) {
+  const std::size_t begin = text.size();
+  text += prefix;
+  text += std::to_string(k);
+  while (text.size() - begin < length) {
+    text += static_cast<char>('a' + Next(state) % 26);
+  }
+}
+
+void AppendNumber (std::string & text, const double value,
+                   const NumberFormat format) {
+  char number[64];
+  int  size = 0;
+  switch (format) {
+    case NumberInteger:
+      size = std::snprintf(number, sizeof(number), "%.0f", value);
+      break;
+    case NumberFixed:
+      size = std::snprintf(number, sizeof(number), "%.2f", value);
+      break;
+    case NumberLong:
+      size = std::snprintf(number, sizeof(number), "%.15g", value);
+      break;
+    case NumberExponent:
+      size = std::snprintf(number, sizeof(number), "%e", value);
+      break;
+    default:
+      break;
+  }  // -----  end switch  -----
+  text.append(number, static_cast<std::size_t>(size));
+}
+
+bool ParseSize (const std::string & value, std::size_t & size) {
+  char * end = NULL;
+  errno = 0;
+  const unsigned long long n = std::strtoull(value.c_str(), &end, 10);
+  if (value.empty() || *end != '\0' || errno != 0) {
+    return false;
+  }
+  size = static_cast<std::size_t>(n);
+  return true;
+}
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  InitLedgerSpec
+//  Description:  One household like the settings.ini of the README.
+// =========================================================================
+void InitLedgerSpec (LedgerSpec & spec) {
+  spec.households = 1;
+  spec.persons    = 2;
+  spec.expenses   = 4;
+  spec.nameLength = 8;
+  spec.format     = NumberFixed;
+  spec.seed       = 88172645463325252ull;
+}   // -----  end of function InitLedgerSpec  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ParseLedgerOption
+//  Description:  Sets one field of spec from an option key=value, with
+//                the keys households, persons, expenses, name-length,
+//                format (integer, fixed, long or exponent) and seed.
+//                Returns false for an unknown key or a bad value.
+// =========================================================================
+bool ParseLedgerOption (const std::string & option, LedgerSpec & spec) {
+  const std::size_t equal = option.find('=');
+  if (equal == std::string::npos) {
+    return false;
+  }
+  const std::string key   = option.substr(0, equal);
+  const std::string value = option.substr(equal + 1);
+
+  if (key == "households") {
+    return ParseSize(value, spec.households);
+  } else if (key == "persons") {
+    return ParseSize(value, spec.persons);
+  } else if (key == "expenses") {
+    return ParseSize(value, spec.expenses);
+  } else if (key == "name-length") {
+    return ParseSize(value, spec.nameLength);
+  } else if (key == "seed") {
+    std::size_t seed = 0;
+    if (!ParseSize(value, seed) || seed == 0) {
+      return false;
+    }
+    spec.seed = seed;
+    return true;
+  } else if (key == "format") {
+    const NumberFormat kFormats[] = {
+      NumberInteger, NumberFixed, NumberLong, NumberExponent,
+    };
+    for (std::size_t k = 0; k < 4; ++k) {
+      if (value == NumberFormatName(kFormats[k])) {
+        spec.format = kFormats[k];
+        return true;
+      }
+    }
+  }  // -----  end if-else  -----
+  return false;
+}   // -----  end of function ParseLedgerOption  -----
+
+const char *NumberFormatName (const NumberFormat format) {
+  switch (format) {
+    case NumberInteger:  return "integer";
+    case NumberFixed:    return "fixed";
+    case NumberLong:     return "long";
+    case NumberExponent: return "exponent";
+    default:             return "unknown";
+  }  // -----  end switch  -----
+}   // -----  end of function NumberFormatName  -----
+
+// e.g. 10x100/name16/fixed for 10 persons and 100 expenses
+std::string LedgerLabel (const LedgerSpec & spec) {
+  std::string label;
+  if (spec.households > 1) {
+    label = std::to_string(spec.households) + "h/";
+  }
+  return label + std::to_string(spec.persons) + "x"
+         + std::to_string(spec.expenses) + "/name"
+         + std::to_string(spec.nameLength) + "/"
+         + NumberFormatName(spec.format);
+}   // -----  end of function LedgerLabel  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  GenerateLedger
+//  Description:  Replaces text by spec.households households, each with
+//                spec.persons [personN] sections and an [expenses]
+//                section of spec.expenses entries. Incomes lie between
+//                500 and 10000, costs between 1 and 2000.
+// =========================================================================
+void GenerateLedger (const LedgerSpec & spec, std::string & text) {
+  uint64_t state = spec.seed;
+
+  text.clear();
+  for (std::size_t h = 0; h < spec.households; ++h) {
+    for (std::size_t j = 0; j < spec.persons; ++j) {
+      text += "[person";
+      text += std::to_string(j + 1);
+      text += "]\nname   = ";
+      AppendName(text, 'p', j + 1, spec.nameLength, state);
+      text += "\nincome = ";
+      AppendNumber(text, Uniform(state, 500., 10000.), spec.format);
+      text += "\n\n";
+    }  // -----  end for  -----
+
+    text += "[expenses]\n";
+    for (std::size_t i = 0; i < spec.expenses; ++i) {
+      AppendName(text, 'e', i + 1, spec.nameLength, state);
+      text += " = ";
+      AppendNumber(text, Uniform(state, 1., 2000.), spec.format);
+      text += '\n';
+    }  // -----  end for  -----
+    text += '\n';
+  }  // -----  end for  -----
+}   // -----  end of function GenerateLedger  -----
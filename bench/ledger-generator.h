@@ -0,0 +1,62 @@
+//
+// =========================================================================
+//
+//       Filename:  ledger-generator.h
+//
+//    Description:  Declares the generator of synthetic ledgers in the
+//                  format of settings.ini, used by the benchmarks and by
+//                  fairshare-bench --generate.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 09:31:40 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  LEDGER_GENERATOR_INC
+#define  LEDGER_GENERATOR_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//--------------------------------------------------------------------------
+//  enumerates
+//--------------------------------------------------------------------------
+// how incomes and costs are written
+enum NumberFormat : unsigned short {
+  NumberInteger,   // 1234
+  NumberFixed,     // 1234.56
+  NumberLong,      // 1234.56789012345, all 15 significant digits
+  NumberExponent,  // 1.234568e+03
+};        // ----------  end of enum NumberFormat  ----------
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+struct ledger_spec {
+  std::size_t  households;  // more than one gives a --batch file
+  std::size_t  persons;     // per household
+  std::size_t  expenses;    // per household
+  std::size_t  nameLength;  // of every person and expense name
+  NumberFormat format;
+  uint64_t     seed;
+};  // -----  end of struct ledger_spec  -----
+
+typedef struct ledger_spec LedgerSpec;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+void        InitLedgerSpec    (LedgerSpec & spec);
+bool        ParseLedgerOption (const std::string & option, LedgerSpec & spec);
+const char *NumberFormatName  (NumberFormat format);
+std::string LedgerLabel       (const LedgerSpec & spec);
+
+void        GenerateLedger    (const LedgerSpec & spec, std::string & text);
+
+#endif   //---- #ifndef LEDGER_GENERATOR_INC  -----
@@ -0,0 +1,111 @@
+//
+// =========================================================================
+//
+//       Filename:  allocation.h
+//
+//    Description:  Declares the allocation kernel that splits every
+//                  expense among an arbitrary number of persons such that
+//                  everybody pays the same percentage of ones income,
+//                  and the kernels of the other expense policies.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 09:20:41 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  ALLOCATION_INC
+#define  ALLOCATION_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ledger.h"
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// The inputs are copied into contiguous arrays once, so that the kernel
+// runs over plain doubles instead of the strided Person/Expense records.
+// All buffers are reused when the same Allocation is filled again.
+struct allocation {
+  std::vector<double> incomes;  // one entry per person
+  std::vector<double> costs;    // one entry per expense
+  std::vector<double> shares;   // persons x expenses, row-major
+  std::vector<double> totals;   // sum of all shares of one person
+  double              sumCosts;
+  double              ratio;    // 1/(sum of all incomes)
+
+  // only used by AllocateInCents, all amounts in cents
+  std::vector<int64_t>     centIncomes;
+  std::vector<int64_t>     centCosts;
+  std::vector<int64_t>     centShares;  // persons x expenses, row-major
+  std::vector<int64_t>     centTotals;
+  std::vector<uint64_t>    centScratch; // see AllocateCentsScratch
+
+  // only used with expense policies, see AllocatePolicies
+  std::vector<uint32_t>    byPolicy;       // expense ids grouped by policy
+  std::vector<std::size_t> policyBegin;    // of every group in byPolicy
+  std::vector<double>      slopes;         // per expense, times the income
+  std::vector<double>      offsets;        // per expense, paid by everybody
+  std::vector<double>      scales;         // per expense, times the weight
+  std::vector<const double *> ownWeights;  // of one group, see AddOwnGroup
+  std::vector<double>      ownScales;      // of one group
+  std::vector<int64_t>     centWeights;    // one per person
+  std::vector<int64_t>     centGroupCosts; // in the order of byPolicy
+  std::vector<int64_t>     centBlock;      // persons x expenses of a group
+  std::vector<int64_t>     centSums;       // one per person
+};  // -----  end of struct allocation  -----
+
+typedef struct allocation Allocation;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+double AllocateShares (const double * incomes, std::size_t nPersons,
+                       const double * costs,   std::size_t nExpenses,
+                       double * shares, double * totals);
+double AllocateSharesGeneric (const double * incomes, std::size_t nPersons,
+                              const double * costs,   std::size_t nExpenses,
+                              double * shares, double * totals);
+
+void   Allocate       (const std::vector<Person>  & p,
+                       const std::vector<Expense> & e,
+                       Allocation & a);
+
+int64_t ToCents       (double amount);
+
+std::size_t AllocateCentsScratch (std::size_t nPersons);
+
+bool   AllocateCents  (const int64_t * incomes, std::size_t nPersons,
+                       const int64_t * costs,   std::size_t nExpenses,
+                       int64_t * shares, int64_t * totals,
+                       uint64_t * scratch);
+
+bool   HasPolicies    (const std::vector<Expense> & e);
+
+void   AllocatePolicies(const std::vector<Person>  & p,
+                        const std::vector<Expense> & e,
+                        Allocation & a);
+
+const char * CheckPolicies (const std::vector<Person>  & p,
+                            const std::vector<Expense> & e, bool cents);
+
+bool   AllocateInCents(const std::vector<Person>  & p,
+                       const std::vector<Expense> & e,
+                       Allocation & a);
+
+const char * AllocateHousehold (const std::vector<Person>  & p,
+                                const std::vector<Expense> & e,
+                                bool cents, Allocation & a);
+
+inline double Share   (const Allocation & a, std::size_t person,
+                       std::size_t expense) {
+  return a.shares[person*a.costs.size() + expense];
+}
+#endif   //---- #ifndef ALLOCATION_INC  -----
@@ -0,0 +1,69 @@
+//
+// =========================================================================
+//
+//       Filename:  arena.h
+//
+//    Description:  Declares a resettable arena: memory is handed out from
+//                  large blocks by moving a pointer and given back all at
+//                  once, in O(1), by resetting the arena.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 10:48:21 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  ARENA_INC
+#define  ARENA_INC
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+struct arena_block {
+  std::unique_ptr<char[]> data;
+  std::size_t             size;
+};  // -----  end of struct arena_block  -----
+
+typedef struct arena_block ArenaBlock;
+
+// Blocks are kept when the arena is reset and filled again in the same
+// order, so a batch of the same size as the one before does not allocate.
+struct arena {
+  std::vector<ArenaBlock> blocks;
+  std::size_t             blockSize;  // of every block but oversized ones
+  std::size_t             block;      // index of the block in use
+  char *                  cur;        // next free byte in the block in use
+  char *                  end;        // of the block in use
+  std::size_t             used;       // bytes handed out since the reset
+};  // -----  end of struct arena  -----
+
+typedef struct arena Arena;
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+extern const std::size_t kArenaBlockBytes;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+void        InitArena     (Arena & a, std::size_t blockSize);
+void *      ArenaAllocate (Arena & a, std::size_t size, std::size_t alignment);
+void        ResetArena    (Arena & a);
+void        ReleaseArena  (Arena & a);
+std::size_t ArenaCapacity (const Arena & a);
+
+// room for n objects of type T, which must not need a destructor
+template <typename T>
+inline T * ArenaArray (Arena & a, const std::size_t n) {
+  return static_cast<T *>(ArenaAllocate(a, n*sizeof(T), alignof(T)));
+}
+#endif   //---- #ifndef ARENA_INC  -----
@@ -0,0 +1,73 @@
+//
+// =========================================================================
+//
+//       Filename:  batch-executor.h
+//
+//    Description:  Declares the parallel batch executor, which parses,
+//                  allocates and formats the households of a batch file
+//                  on all cores and writes the results in input order.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 08:45:09 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  BATCH_EXECUTOR_INC
+#define  BATCH_EXECUTOR_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "output-writer.h"
+#include "validation.h"
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// A batch file is a sequence of settings.ini groups:
+//
+//   [person1] ... [personN] [expenses]  [person1] ... [expenses]  ...
+//
+// A household ends with the first [person] section that follows its
+// [expenses] section, or with the end of the file. The text of one
+// household in the batch file, see SplitHouseholds:
+struct household_span {
+  std::size_t begin;  // offset of the first byte
+  std::size_t end;    // offset behind the last byte
+};  // -----  end of struct household_span  -----
+
+typedef struct household_span HouseholdSpan;
+
+struct batch_job {
+  std::string_view text;      // the whole batch file
+  std::string      fileName;  // for error messages
+  bool             cents;
+  bool             series;    // households of TimeSeries, see time-series.h
+  OutputFormat     format;
+  unsigned         threads;   // including the calling thread
+  RejectLog *      rejects;   // bad households are skipped and copied
+                              // here, NULL stops at the first one
+};  // -----  end of struct batch_job  -----
+
+typedef struct batch_job BatchJob;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+std::size_t SplitHouseholds (std::string_view text, std::size_t & position,
+                             std::size_t maxSpans,
+                             std::vector<HouseholdSpan> & spans);
+
+bool        RunBatchJob     (const BatchJob & job, std::ostream & os,
+                             uint64_t & households, std::string & error);
+
+#endif   //---- #ifndef BATCH_EXECUTOR_INC  -----
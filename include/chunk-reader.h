@@ -0,0 +1,151 @@
+//
+// =========================================================================
+//
+//       Filename:  chunk-reader.h
+//
+//    Description:  Declares the chunked reader of large text files: the
+//                  file is read with read() into one buffer at a time,
+//                  the bytes not consumed yet move to its front, and the
+//                  lines are found with memchr or counted in words of
+//                  bytes the compiler vectorizes.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 10:14:03 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  CHUNK_READER_INC
+#define  CHUNK_READER_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>  // _mm_cmpeq_epi8, _mm_movemask_epi8
+#endif
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+extern const std::size_t kChunkReaderBytes;
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// The text of a chunk is [begin, end) of the buffer: what is left of the
+// last chunk, followed by what was read after it. A scanner consumes the
+// complete lines and leaves the start of a line cut by the end of the
+// buffer for the next one, so a line may be as long as the buffer.
+struct chunk_reader {
+  int               fd;
+  std::vector<char> buffer;          // capacity, and a byte for a newline
+  std::size_t       capacity;
+  std::size_t       begin;           // of the bytes not consumed yet
+  std::size_t       end;             // of the bytes read
+  uint64_t          bytesRead;
+  bool              atEnd;           // nothing more to read
+  bool              endWithNewline;  // add one after an unfinished last line
+};  // -----  end of struct chunk_reader  -----
+
+typedef struct chunk_reader ChunkReader;
+
+// Where one byte, say the newline, is in the 64 bytes of a text from
+// base on, bit k for base[k]. A scanner moves it along the text to find
+// the ends of its lines, and another one to find the separators within
+// a line, without a call of memchr for each of them.
+struct byte_bits {
+  const char * base;
+  uint64_t     bits;
+  char         byte;
+};  // -----  end of struct byte_bits  -----
+
+typedef struct byte_bits ByteBits;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+bool        OpenChunkReader  (const std::string & fileName,
+                              std::size_t capacity, bool endWithNewline,
+                              ChunkReader & r);
+bool        FillChunk        (ChunkReader & r);
+void        CloseChunkReader (ChunkReader & r);
+
+std::size_t CountNewlines    (std::string_view text);
+bool        CountCommentLines(std::string_view text, int & count,
+                              std::size_t & consumed);
+
+inline std::string_view ChunkText (const ChunkReader & r) {
+  return std::string_view(r.buffer.data() + r.begin, r.end - r.begin);
+}
+
+inline void ConsumeChunk (ChunkReader & r, const std::size_t n) {
+  r.begin += n;
+}
+
+// the buffer is full of a line that does not end in it
+inline bool ChunkLineTooLong (const ChunkReader & r) {
+  return r.begin == 0 && r.end == r.capacity && !r.atEnd;
+}
+
+// Bit k of the result is set if p[k] is c, for those of the 64 bytes
+// from p on that are before end. Blocks of 16 bytes are compared at once
+// while they are before end, the rest one byte at a time.
+inline uint64_t MatchBytes (const char * p, const char * end, const char c) {
+  const std::size_t n    = end - p < 64
+                           ? static_cast<std::size_t>(end - p) : 64;
+  uint64_t          bits = 0;
+  std::size_t       k    = 0;
+#ifdef __SSE2__
+  const __m128i pattern = _mm_set1_epi8(c);
+  for (; k + 16 <= n; k += 16) {
+    const __m128i block = _mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(p + k));
+    bits |= static_cast<uint64_t>(static_cast<unsigned>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)))) << k;
+  }
+#endif
+  for (; k < n; ++k) {
+    bits |= static_cast<uint64_t>(p[k] == c) << k;
+  }
+  return bits;
+}
+
+inline void StartByteBits (ByteBits & b, const char * p, const char * end,
+                           const char c) {
+  b.base = p;
+  b.bits = MatchBytes(p, end, c);
+  b.byte = c;
+}
+
+// Returns the first b.byte at or after p and before limit, or limit if
+// there is none; end is the end of the text. p may not be before what
+// the call before returned.
+inline const char * NextByte (ByteBits & b, const char * p,
+                              const char * limit, const char * end) {
+  for (;;) {
+    if (p - b.base >= 64) {
+      b.base = p;
+      b.bits = MatchBytes(p, end, b.byte);
+    }
+    const uint64_t rest = b.bits >> (p - b.base);
+    if (rest != 0) {
+      const char * q = p + __builtin_ctzll(rest);
+      return q < limit ? q : limit;
+    }
+    if (limit - b.base <= 64) {
+      return limit;
+    }
+    b.base += 64;
+    b.bits  = MatchBytes(b.base, end, b.byte);
+    p       = b.base;
+  }  // -----  end for  -----
+}
+#endif   //---- #ifndef CHUNK_READER_INC  -----
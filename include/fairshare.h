@@ -25,17 +25,40 @@
 //--------------------------------------------------------------------------
 //  pods
 //--------------------------------------------------------------------------
-struct person {
-  std::string name;
-  double      income;
-};  // -----  end of struct person  -----
-struct expense {
-  std::string name;
-  double      cost;
-};  // -----  end of struct expense  -----
-
-typedef struct person Person;
-typedef struct expense Expense;
+struct income_override {
+  size_t person;   // counted from 1, as in -1 and -2
+  double income;
+};  // -----  end of struct income_override  -----
+
+typedef struct income_override IncomeOverride;
+
+struct options {
+  std::string                 batchFileName;
+  std::string                 seriesFileName;  // --series
+  std::string                 treeFileName;    // --tree
+  std::string                 settleFileName;  // --settle, the payments
+  bool                        exact;           // fewest transfers
+  std::vector<IncomeOverride> incomes;
+  bool                        cents;  // split in whole cents
+  OutputFormat                format;
+  std::string                 socketPath;  // --serve
+  unsigned                    jobs;        // threads of --batch, 0 for all
+  bool                        noCache;     // parse settings.ini every time
+  std::string                 statsFileName;  // --stats, "-" for stderr
+  std::string                 rejectFileName; // --rejects
+  std::vector<std::string>    sweeps;         // --sweep, key=start:stop:step
+  std::string                 transactionFileName;  // --transactions
+  std::string                 rulesFileName;        // --rules
+};  // -----  end of struct options  -----
+
+typedef struct options Options;
+
+//--------------------------------------------------------------------------
+//  global variables declarations, defined in fairshare.cc
+//--------------------------------------------------------------------------
+extern std::vector<Person>  persons;
+extern std::vector<Expense> expenses;
+extern Options              options;
 
 //--------------------------------------------------------------------------
 //  function declarations
@@ -45,13 +68,29 @@ void   DisplayHelp (const char *execName,
 
 void   CheckIncomeIsNonZeroOrExit (const std::vector<Person> & p);
 void   GetArgsToMain  (int ac, char *av[]);
+void   ApplyIncomeOverridesOrExit (std::vector<Person> & p,
+                                   const std::vector<IncomeOverride> & o);
+void   RunBatch       (const std::string & fileName, bool series,
+                       std::ostream & os);
+void   RunGroupTree   (const std::string & fileName, std::ostream & os);
+void   RunSettlement  (const std::string & fileName,
+                       const std::vector<Person> & p,
+                       const std::vector<Expense> & e, std::ostream & os);
+void   IngestTransactionsOrExit (const std::string & fileName,
+                                 const std::string & rulesFileName,
+                                 std::vector<Expense> & e);
+void   RunSweep       (const std::vector<Person> & p,
+                       const std::vector<Expense> & e, std::ostream & os);
 void   ParseIniFile   (const std::string & fileName);
+void   WriteStatsAtExit ();
 
 int    LongestString  (const std::vector<Expense> & e);
 int    LongestString  (const std::vector<Person > & p);
 
 double CalculateRatio (const std::vector<Person > & p);
+void   AllocateOrExit (const std::vector<Person> & p, const std::vector<Expense> &e,
+                       Allocation & a);
 
-void   DisplayResults (const std::vector<Person> & p, const std::vector<Expense> &e);
-void   DisplayInputs  (const std::vector<Person> & p, const std::vector<Expense> &e);
+void   DisplayResults (const std::vector<Person> & p, const std::vector<Expense> &e,
+                       const Allocation & a, std::ostream & os);
 #endif   //---- #ifndef FAIRSHARE_INC  -----
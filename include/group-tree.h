@@ -0,0 +1,122 @@
+//
+// =========================================================================
+//
+//       Filename:  group-tree.h
+//
+//    Description:  Declares a tree of groups, e.g. portfolio, buildings
+//                  and households, where every group has its own
+//                  expenses. The costs of a group are split among the
+//                  groups and persons below it by income.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 12:41:18 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  GROUP_TREE_INC
+#define  GROUP_TREE_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "arena.h"
+#include "name-table.h"
+#include "summation.h"
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// A tree file is a sequence of groups. Every group starts with a
+// [group name] section, which may name the group above it; the [person]
+// and [expenses] sections up to the next group belong to it:
+//
+//   [group building]
+//   [expenses]
+//   caretaker = 400
+//
+//   [group flat 1]
+//   parent = building
+//   [person1]
+//   name   = Max
+//   income = 1000
+//   [expenses]
+//   rent   = 700
+//
+// A parent has to come before its children, so the groups are stored in
+// the order of the file as flat arrays in which every parent precedes
+// its children. The incomes are then summed up the tree in one sweep
+// from the back and the costs handed down in one sweep from the front.
+//
+// Handing down the costs of a group by income means that everybody
+// below it pays the same part of the income for them. A person of group
+// g therefore pays income*rates[g], where rates[g] adds the costs of g
+// per income of g to the rate of its parent.
+struct group_tree {
+  Arena                         arena;        // bytes of the group names
+  NameTable                     names;        // group name to group id
+
+  // per group, parents first
+  std::vector<uint32_t>         parents;      // kNoParentGroup for roots
+  std::vector<uint32_t>         depths;       // roots are at depth 0
+  std::vector<std::size_t>      firstPerson;  // one more than groups
+  std::vector<double>           costs;        // own expenses of the group
+  std::vector<double>           incomes;      // of the group and below
+  std::vector<double>           rates;        // paid per income, see above
+  std::vector<uint32_t>         order;        // depth first, for display
+
+  // per person, the persons of one group one after the other; the names
+  // are views into the text of the tree file
+  std::vector<std::string_view> personNames;
+  std::vector<double>           personIncomes;
+
+  // compensated sums per group, of the costs in ParseGroupTree and of
+  // the incomes below it in EvaluateGroupTree, so that neither depends
+  // on how the build orders the additions
+  std::vector<CompensatedSum>   sums;
+
+  // scratch of EvaluateGroupTree, reused by the next tree
+  std::vector<std::size_t>      firstChild;
+  std::vector<uint32_t>         children;
+  std::vector<uint32_t>         stack;
+};  // -----  end of struct group_tree  -----
+
+typedef struct group_tree GroupTree;
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+extern const uint32_t kNoParentGroup;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+void   InitGroupTree     (GroupTree & t);
+bool   ParseGroupTree    (std::string_view text, const std::string & fileName,
+                          GroupTree & t, std::string & error);
+bool   EvaluateGroupTree (GroupTree & t, std::string & error);
+
+inline std::size_t Groups (const GroupTree & t) {
+  return t.parents.size();
+}
+inline std::string_view GroupName (const GroupTree & t, const std::size_t g) {
+  return NameOf(t.names, static_cast<uint32_t>(g));
+}
+// the part of the costs of the groups above g that a person of g pays
+// per income
+inline double InheritedRate (const GroupTree & t, const std::size_t g) {
+  return t.parents[g] == kNoParentGroup ? 0. : t.rates[t.parents[g]];
+}
+// the part of the own costs of g, computed directly instead of as the
+// difference of two rates
+inline double OwnRate (const GroupTree & t, const std::size_t g) {
+  return t.costs[g] <= 0. && t.costs[g] >= 0. ? 0. : t.costs[g]/t.incomes[g];
+}
+#endif   //---- #ifndef GROUP_TREE_INC  -----
@@ -20,7 +20,32 @@
 #ifndef  HELPER_FUNCTIONS_INC
 #define  HELPER_FUNCTIONS_INC
 
+#include <cstddef>
+#include <string_view>
+
+//--------------------------------------------------------------------------
+//  enumerates
+//--------------------------------------------------------------------------
+enum ConversionError : unsigned short {
+  ConversionOk,
+  ConversionEmpty,       // nothing to convert
+  ConversionInvalid,     // not a number, or trailing characters
+  ConversionOutOfRange,  // does not fit into a finite double
+};        // ----------  end of enum ConversionError  ----------
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+struct conversion {
+  double          value;
+  ConversionError error;
+};  // -----  end of struct conversion  -----
+
+typedef struct conversion Conversion;
+
 bool FileExists                    (const std::string   & fileName );
+bool CheckFileExists               (const std::string   & fileName,
+                                          std::string   & error    );
 void CheckFileExistsOrExit         (const std::string   & fileName );
 void OpenNewFileToWriteOrExit      (const std::string   & fileName,
                                           std::ofstream & ofs      );
@@ -63,6 +88,11 @@ bool        IsFiniteNumber (const double x);
 
 double      StringToDouble (const std::string & doubleAsString);
 
+Conversion  ParseDouble    (std::string_view s);
+std::size_t ParseDoubles   (const std::string_view * fields, std::size_t n,
+                            double * values, ConversionError * errors);
+const char *ConversionErrorMessage (ConversionError error);
+
 template <typename T>
 std::string NumberToString (const T & number){
   std::ostringstream convert; // stream used for the conversion
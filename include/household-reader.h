@@ -0,0 +1,36 @@
+//
+// =========================================================================
+//
+//       Filename:  household-reader.h
+//
+//    Description:  Declares the readers of a household in the
+//                  settings.ini format, from a text or a file.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 11:05:52 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  HOUSEHOLD_READER_INC
+#define  HOUSEHOLD_READER_INC
+
+#include <string>
+#include <string_view>
+
+#include "ledger.h"
+#include "ini-parser.h"
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+bool ParseHouseholdText (std::string_view text, const std::string & fileName,
+                         Household & h, std::string & error);
+bool LoadHouseholdFile  (const std::string & fileName, Household & h,
+                         std::string & error);
+
+#endif   //---- #ifndef HOUSEHOLD_READER_INC  -----
@@ -0,0 +1,76 @@
+//
+// =========================================================================
+//
+//       Filename:  household-store.h
+//
+//    Description:  Declares the household store, which keeps a whole
+//                  batch of households in memory in compact records:
+//                  names are interned to 32 bit ids and all records,
+//                  amounts and name bytes live in one arena, so that the
+//                  batch is freed in O(1).
+//
+//        Version:  1.0
+//        Created:  10/18/2026 10:48:21 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  HOUSEHOLD_STORE_INC
+#define  HOUSEHOLD_STORE_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ledger.h"
+#include "arena.h"
+#include "name-table.h"
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// One household, followed in the arena by its arrays.
+struct stored_household {
+  uint32_t         persons;
+  uint32_t         expenses;
+  const double   * incomes;       // one per person
+  const double   * costs;         // one per expense
+  const double   * weights;       // persons per weighted or fixed expense
+  const uint32_t * personNames;   // ids in the name table
+  const uint32_t * expenseNames;
+  const ExpensePolicy * policies; // one per expense
+};  // -----  end of struct stored_household  -----
+
+typedef struct stored_household StoredHousehold;
+
+struct household_store {
+  Arena                                arena;  // records and name bytes
+  NameTable                            names;
+  std::vector<const StoredHousehold *> households;
+};  // -----  end of struct household_store  -----
+
+typedef struct household_store HouseholdStore;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+void                    InitHouseholdStore  (HouseholdStore & s);
+void                    ResetHouseholdStore (HouseholdStore & s);
+
+const StoredHousehold * StoreHousehold      (HouseholdStore & s,
+                                             const Household & h);
+void                    ExpandHousehold     (const HouseholdStore & s,
+                                             const StoredHousehold & r,
+                                             Household & h);
+
+bool                    LoadHouseholdBatch  (std::string_view text,
+                                             HouseholdStore & s,
+                                             std::string & error);
+
+#endif   //---- #ifndef HOUSEHOLD_STORE_INC  -----
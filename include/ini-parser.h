@@ -0,0 +1,89 @@
+//
+// =========================================================================
+//
+//       Filename:  ini-parser.h
+//
+//    Description:  Declares a zero-copy parser for files in the format of
+//                  settings.ini. The file is memory mapped and scanned in
+//                  place; sections, keys and values are handed out as
+//                  views into the mapping.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 01:14:09 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  INI_PARSER_INC
+#define  INI_PARSER_INC
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "ledger.h"
+#include "name-table.h"
+
+//--------------------------------------------------------------------------
+//  enumerates
+//--------------------------------------------------------------------------
+enum IniToken : unsigned short {
+  IniSection,     // [section]
+  IniKeyValue,    // key = value
+  IniEnd,         // end of input
+  IniSyntaxError, // syntax error, see IniScanner::error
+};        // ----------  end of enum IniToken  ----------
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+struct mapped_file {
+  const char * data;
+  std::size_t  size;
+};  // -----  end of struct mapped_file  -----
+
+typedef struct mapped_file MappedFile;
+
+struct ini_error {
+  std::size_t line;     // counted from 1
+  std::size_t column;   // counted from 1
+  std::string message;
+};  // -----  end of struct ini_error  -----
+
+typedef struct ini_error IniError;
+
+// Comments start with ';' or '#' and take the whole line. Blanks around
+// section names, keys and values are stripped.
+struct ini_scanner {
+  const char *     begin;       // of the input
+  const char *     cur;         // start of the next line to scan
+  const char *     end;         // of the input
+  std::size_t      line;        // of the last token
+  const char *     lineBegin;   // of the last token
+  std::string_view section;     // valid after IniSection
+  std::string_view key;         // valid after IniKeyValue
+  std::string_view value;       // valid after IniKeyValue
+  IniError         error;       // valid after IniSyntaxError
+  NameTable        expenseKeys; // of the household ParseHousehold reads
+};  // -----  end of struct ini_scanner  -----
+
+typedef struct ini_scanner IniScanner;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+bool     MapFile           (const std::string & fileName, MappedFile & f);
+void     UnmapFile         (MappedFile & f);
+
+void     InitIniScanner    (IniScanner & s, std::string_view text);
+IniToken NextIniToken      (IniScanner & s);
+std::size_t IniColumn      (const IniScanner & s, const char * position);
+bool     IsPersonSection   (std::string_view section);
+
+IniToken ParseHousehold    (IniScanner & s, Household & h,
+                            bool stopAtNextHousehold, bool & pendingPerson);
+#endif   //---- #ifndef INI_PARSER_INC  -----
@@ -0,0 +1,120 @@
+//
+// =========================================================================
+//
+//       Filename:  ledger-cache.h
+//
+//    Description:  Declares the binary ledger cache: a compiled snapshot
+//                  of a settings file that is mapped into memory and
+//                  read in place, so that a run with an unchanged
+//                  settings file does not parse it again.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 11:27:03 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  LEDGER_CACHE_INC
+#define  LEDGER_CACHE_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ledger.h"
+#include "ini-parser.h"
+
+//--------------------------------------------------------------------------
+//  enumerates
+//--------------------------------------------------------------------------
+// where the ledger of OpenLedgerCache came from
+enum LedgerCacheResult : unsigned short {
+  CacheHit,       // size and mtime of the settings file matched, and the
+                  // cache is newer than that mtime
+  CacheHashHit,   // size and hash matched, the mtime was recorded again
+  CacheRebuilt,   // the settings file was parsed and the cache written
+  CacheInMemory,  // parsed, but the cache could not be written
+};        // ----------  end of enum LedgerCacheResult  ----------
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// The file starts with this header, followed by
+//
+//   double   incomes[persons]
+//   double   costs[expenses]
+//   double   weights[weights]         persons of them for every weighted
+//                                     and fixed expense, in their order
+//   uint32_t personNames[persons]     ids of the name table
+//   uint32_t expenseNames[expenses]
+//   uint32_t policies[expenses]       ExpensePolicy
+//   uint32_t nameOffsets[names + 1]   into the name bytes
+//   char     nameBytes[nameBytes]
+//
+// in the byte order of the machine that wrote it.
+struct ledger_cache_header {
+  char     magic[4];     // kLedgerCacheMagic
+  uint32_t version;      // kLedgerCacheVersion
+  uint32_t byteOrder;    // 0x01020304 as written
+  uint32_t persons;
+  uint32_t expenses;
+  uint32_t names;
+  uint64_t sourceSize;   // of the settings file
+  int64_t  sourceMtime;  // of the settings file, ns since the epoch
+  uint64_t sourceHash;   // FNV-1a of the settings file
+  uint64_t nameBytes;
+  uint64_t weights;
+  uint64_t fileSize;     // of the whole cache
+};  // -----  end of struct ledger_cache_header  -----
+
+typedef struct ledger_cache_header LedgerCacheHeader;
+
+// A view of a cache, either mapped or, if it could not be written, built
+// in image. The pointers are valid until CloseLedgerCache.
+struct ledger_cache {
+  MappedFile            file;
+  std::vector<uint64_t> image;
+  uint32_t              persons;
+  uint32_t              expenses;
+  uint32_t              names;
+  const double *        incomes;
+  const double *        costs;
+  const double *        weights;
+  const uint32_t *      personNames;
+  const uint32_t *      expenseNames;
+  const uint32_t *      policies;
+  const uint32_t *      nameOffsets;
+  const char *          nameBytes;
+};  // -----  end of struct ledger_cache  -----
+
+typedef struct ledger_cache LedgerCache;
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+extern const char     kLedgerCacheMagic[4];
+extern const uint32_t kLedgerCacheVersion;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+std::string LedgerCacheFileName   (const std::string & iniFileName);
+
+bool        OpenLedgerCache       (const std::string & iniFileName,
+                                   LedgerCache & c, LedgerCacheResult & result,
+                                   std::string & error);
+void        CloseLedgerCache      (LedgerCache & c);
+
+void        ExpandCachedHousehold (const LedgerCache & c, Household & h);
+
+inline std::string_view CachedName (const LedgerCache & c, const uint32_t id) {
+  return std::string_view(c.nameBytes + c.nameOffsets[id],
+                          c.nameOffsets[id + 1] - c.nameOffsets[id]);
+}
+#endif   //---- #ifndef LEDGER_CACHE_INC  -----
@@ -0,0 +1,64 @@
+//
+// =========================================================================
+//
+//       Filename:  ledger.h
+//
+//    Description:  Declares the plain data records a ledger is made of:
+//                  the persons sharing the costs and the expenses, and
+//                  the policies by which an expense is split.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 09:12:04 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  LEDGER_INC
+#define  LEDGER_INC
+
+#include <string>
+#include <vector>
+
+//--------------------------------------------------------------------------
+//  enumerates
+//--------------------------------------------------------------------------
+// how an expense is split among the persons, see AllocateShares and
+// AllocatePolicies
+enum ExpensePolicy : unsigned short {
+  PolicyIncome,    // by income, the default
+  PolicyEqual,     // the same amount for everybody
+  PolicyWeighted,  // by a column of the persons, e.g. metered usage
+  PolicyFixed,     // a fixed amount per person, the rest by income
+};        // ----------  end of enum ExpensePolicy  ----------
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+struct person {
+  std::string name;
+  double      income;
+};  // -----  end of struct person  -----
+struct expense {
+  std::string         name;
+  double              cost;
+  ExpensePolicy       policy = PolicyIncome;
+  std::vector<double> weights;  // one per person with PolicyWeighted and
+                                // PolicyFixed, otherwise empty
+};  // -----  end of struct expense  -----
+
+typedef struct person Person;
+typedef struct expense Expense;
+
+// one set of persons sharing one set of expenses, e.g. one settings.ini
+struct household {
+  std::vector<Person>  persons;
+  std::vector<Expense> expenses;
+};  // -----  end of struct household  -----
+
+typedef struct household Household;
+
+#endif   //---- #ifndef LEDGER_INC  -----
@@ -0,0 +1,77 @@
+//
+// =========================================================================
+//
+//       Filename:  libfairshare.h
+//
+//    Description:  Declares the embeddable API of libfairshare. Every
+//                  function works only on the arguments it is given,
+//                  so any number of threads may call them at once, and
+//                  reports errors by its status instead of exiting. The
+//                  split functions write into buffers of the caller and
+//                  do not allocate.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 10:12:55 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  LIBFAIRSHARE_INC
+#define  LIBFAIRSHARE_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ledger.h"
+
+//--------------------------------------------------------------------------
+//  enumerates
+//--------------------------------------------------------------------------
+enum FairshareStatus : unsigned short {
+  FairshareOk,
+  FairshareNoPersons,         // nobody to split the expenses between
+  FairshareZeroIncome,        // an income is zero
+  FairshareZeroSum,           // the incomes add up to zero
+  FairshareNegativeIncome,    // splitting in cents needs incomes >= 0
+  FairshareBufferTooSmall,    // an output or scratch buffer is too small
+  FairshareEmptyNumber,       // the amount to parse is empty
+  FairshareInvalidNumber,     // not a number, or trailing characters
+  FairshareNumberOutOfRange,  // does not fit into a finite double
+  FairshareReadError,         // a file could not be read or parsed
+};        // ----------  end of enum FairshareStatus  ----------
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+// shares has persons x expenses entries, row-major, totals one per person
+FairshareStatus FairshareSplit         (const double * incomes,
+                                        std::size_t persons,
+                                        const double * costs,
+                                        std::size_t expenses,
+                                        double * shares, std::size_t sharesSize,
+                                        double * totals, std::size_t totalsSize);
+
+std::size_t     FairshareCentsScratch  (std::size_t persons,
+                                        std::size_t expenses);
+FairshareStatus FairshareSplitCents    (const double * incomes,
+                                        std::size_t persons,
+                                        const double * costs,
+                                        std::size_t expenses,
+                                        double * shares, std::size_t sharesSize,
+                                        double * totals, std::size_t totalsSize,
+                                        int64_t * scratch,
+                                        std::size_t scratchSize);
+
+FairshareStatus FairshareParseAmount   (const char * text, std::size_t size,
+                                        double & amount);
+FairshareStatus FairshareLoadHousehold (const std::string & fileName,
+                                        Household & h, std::string & error);
+
+const char *    FairshareStatusMessage (FairshareStatus status);
+
+#endif   //---- #ifndef LIBFAIRSHARE_INC  -----
@@ -0,0 +1,65 @@
+//
+// =========================================================================
+//
+//       Filename:  name-table.h
+//
+//    Description:  Declares the name interning table, which maps every
+//                  distinct person or expense name to a 32 bit id and
+//                  keeps a single copy of its bytes in an arena.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 10:48:21 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  NAME_TABLE_INC
+#define  NAME_TABLE_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "arena.h"
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// A slot is only in use if its generation is the one of the table, so
+// that the table is emptied in O(1) by counting up the generation.
+struct name_slot {
+  uint32_t hash;
+  uint32_t id;
+  uint32_t generation;
+};  // -----  end of struct name_slot  -----
+
+typedef struct name_slot NameSlot;
+
+// open addressing with linear probing, at most half full
+struct name_table {
+  std::vector<NameSlot>         slots;  // a power of two
+  std::vector<std::string_view> names;  // by id, the bytes in the arena
+  uint32_t                      generation;
+};  // -----  end of struct name_table  -----
+
+typedef struct name_table NameTable;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+void     InitNameTable  (NameTable & t);
+uint32_t InternName     (NameTable & t, Arena & a, std::string_view name);
+uint32_t InternView     (NameTable & t, std::string_view name);
+bool     FindName       (const NameTable & t, std::string_view name,
+                         uint32_t & id);
+void     ResetNameTable (NameTable & t);
+
+inline std::string_view NameOf (const NameTable & t, const uint32_t id) {
+  return t.names[id];
+}
+#endif   //---- #ifndef NAME_TABLE_INC  -----
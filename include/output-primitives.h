@@ -0,0 +1,84 @@
+//
+// =========================================================================
+//
+//       Filename:  output-primitives.h
+//
+//    Description:  Declares the pieces the writers of output-writer.cc
+//                  and output-<mode>.cc format their records with: the
+//                  flushing of the buffer, CSV and JSON fields, the cells
+//                  of the tables and the little-endian binary values.
+//                  Internal to the writers, not part of libfairshare.h.
+//
+//        Version:  1.0
+//        Created:  10/20/2026 02:12:08 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  OUTPUT_PRIMITIVES_INC
+#define  OUTPUT_PRIMITIVES_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>   // memcpy
+#include <string>
+#include <string_view>
+
+#include "output-writer.h"
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+// writes w.buffer to w.os; without a stream, w collects everything
+void Flush            (OutputWriter & w);
+
+void AppendNumber     (std::string & out, double x);
+void AppendNumber     (std::string & out, uint64_t x);
+void AppendCents      (std::string & out, int64_t cents);
+void AppendCsvField   (std::string & out, std::string_view s);
+void AppendJsonString (std::string & out, std::string_view s);
+void AppendJsonNumber (std::string & out, double x);
+
+// separator and s right aligned in a column of width, and the rule
+// below the header of a table of persons columns
+void AppendCell       (std::string & out, const char * s, std::size_t length,
+                       std::size_t width, const char * separator);
+void AppendRule       (std::string & out, std::size_t width,
+                       std::size_t persons);
+
+void PutUint32        (std::string & out, uint32_t x);
+void PutUint64        (std::string & out, uint64_t x);
+void PutDouble        (std::string & out, double x);
+
+inline void FlushIfFull (OutputWriter & w) {
+  if (w.buffer.size() >= w.flushBytes && w.os != NULL) {
+    Flush(w);
+  }
+}
+
+// -ffast-math assumes there are no infinities, hence isfinite would be
+// folded to true
+inline bool IsFinite (const double x) {
+  uint64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return (bits >> 52 & 0x7ff) != 0x7ff;
+}
+
+// like PutDouble, into memory reserved beforehand, for whole blocks
+inline char * StoreDouble (char * out, const double x) {
+  uint64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  const char bytes[8] = {
+    static_cast<char>(bits),       static_cast<char>(bits >> 8),
+    static_cast<char>(bits >> 16), static_cast<char>(bits >> 24),
+    static_cast<char>(bits >> 32), static_cast<char>(bits >> 40),
+    static_cast<char>(bits >> 48), static_cast<char>(bits >> 56) };
+  std::memcpy(out, bytes, sizeof(bytes));
+  return out + 8;
+}
+
+#endif   //---- #ifndef OUTPUT_PRIMITIVES_INC  -----
@@ -0,0 +1,146 @@
+//
+// =========================================================================
+//
+//       Filename:  output-writer.h
+//
+//    Description:  Declares the writer of the results in the formats of
+//                  --output-format: the table of DisplayResults, CSV,
+//                  newline delimited JSON and a little-endian columnar
+//                  binary format.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 05:10:33 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  OUTPUT_WRITER_INC
+#define  OUTPUT_WRITER_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "table-renderer.h"
+#include "time-series.h"
+#include "group-tree.h"
+#include "settlement.h"
+#include "sweep.h"
+
+//--------------------------------------------------------------------------
+//  enumerates
+//--------------------------------------------------------------------------
+enum OutputFormat : unsigned short {
+  OutputTable,   // the colored table of DisplayResults
+  OutputCsv,     // one row per person and expense
+  OutputNdjson,  // one JSON object per person and expense
+  OutputBinary,  // one columnar block per household
+};        // ----------  end of enum OutputFormat  ----------
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+// The binary format starts with kBinaryMagic and the version as uint32.
+// Every household follows as one block, all integers little-endian:
+//
+//   uint64 household   counted from 1
+//   uint32 persons     n
+//   uint32 expenses    m
+//   uint32 member[n*m]   person of each row, counted from 1
+//   uint32 expense[n*m]  expense of each row, counted from 1
+//   double amount[n*m]   IEEE 754 binary64
+//
+// The rows are ordered by person, then by expense.
+extern const char     kBinaryMagic[4];
+extern const uint32_t kBinaryVersion;
+
+// A sweep in binary starts with kSweepMagic and the version as uint32,
+// followed by one header and one record per scenario:
+//
+//   uint32 axes        k
+//   uint32 persons     n
+//   uint64 scenarios
+//   k times:
+//     uint32 kind      0 for an income, 1 for the cost of an expense
+//     uint32 index     of the person or expense, counted from 1
+//     double start
+//     double step
+//     uint64 count
+//   per scenario, row-major, the last axis running fastest:
+//     double percent    fair share, of income
+//     double total[n]
+extern const char     kSweepMagic[4];
+extern const uint32_t kSweepVersion;
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// The rows are collected in buffer and written to os whenever it holds
+// more than flushBytes, so the memory does not grow with the number of
+// households, nor with the size of one household.
+struct output_writer {
+  std::ostream * os;          // NULL while collecting a chunk
+  OutputFormat   format;
+  bool           numbered;    // table only: "Household n:" before a table
+  uint64_t       households;  // written so far
+  std::size_t    flushBytes;
+  std::string    buffer;
+  std::string    row;         // the person columns of the current rows
+  std::string    fields;      // the expense columns of all rows, formatted
+  std::vector<std::size_t> fieldEnds;  // end of each expense in fields
+  std::size_t    width;       // series table only: width of a column
+  TableBuffer    table;
+};  // -----  end of struct output_writer  -----
+
+typedef struct output_writer OutputWriter;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+bool ParseOutputFormat  (const std::string & name, OutputFormat & format);
+
+void InitOutputWriter   (OutputWriter & w, std::ostream & os,
+                         OutputFormat format, bool numbered);
+void WriteHousehold     (OutputWriter & w,
+                         const std::vector<Person>  & p,
+                         const std::vector<Expense> & e,
+                         const Allocation & a);
+void FinishOutputWriter (OutputWriter & w);
+
+void InitSeriesWriter        (OutputWriter & w, std::ostream & os,
+                              OutputFormat format);
+void StartSeriesHousehold    (OutputWriter & w, const TimeSeries & ts);
+void WriteSeriesPeriod       (OutputWriter & w, const TimeSeries & ts,
+                              const SeriesState & state);
+void FinishSeriesHousehold   (OutputWriter & w, const TimeSeries & ts,
+                              const SeriesState & state);
+
+void InitGroupTreeWriter     (OutputWriter & w, std::ostream & os,
+                              OutputFormat format);
+void WriteGroupTree          (OutputWriter & w, const GroupTree & t);
+
+void InitSettlementWriter    (OutputWriter & w, std::ostream & os,
+                              OutputFormat format);
+void WriteSettlement         (OutputWriter & w, const std::vector<Person> & p,
+                              const Settlement & s);
+
+void InitSweepWriter         (OutputWriter & w, std::ostream & os,
+                              OutputFormat format,
+                              const std::vector<Person>  & p,
+                              const std::vector<Expense> & e,
+                              const Sweep & s);
+void WriteSweepBlock         (OutputWriter & w, const Sweep & s);
+
+void StartOutputChunk   (OutputWriter & w, OutputFormat format,
+                         bool numbered, uint64_t households);
+void WriteOutputChunk   (OutputWriter & w, const std::string & chunk);
+
+#endif   //---- #ifndef OUTPUT_WRITER_INC  -----
@@ -0,0 +1,60 @@
+//
+// =========================================================================
+//
+//       Filename:  server.h
+//
+//    Description:  Declares the server mode of fairshare: a long running
+//                  process that keeps settings.ini parsed in memory and
+//                  answers share queries over a Unix domain socket.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 06:21:47 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  SERVER_INC
+#define  SERVER_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "output-writer.h"
+#include "stats.h"
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// Everything a query needs besides the settings, reused between queries
+// so that answering does not allocate once the buffers have grown.
+struct query_scratch {
+  std::vector<Person> persons;  // the persons with the overrides applied
+  Allocation          allocation;
+  OutputWriter        writer;
+  std::ostringstream  output;
+};  // -----  end of struct query_scratch  -----
+
+typedef struct query_scratch QueryScratch;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+bool     AnswerQuery       (const Household & settings,
+                            const std::string & request, bool cents,
+                            OutputFormat format, QueryScratch & s,
+                            std::string & response);
+
+int      Serve             (const std::string & socketPath,
+                            const std::string & settingsFileName,
+                            bool cents, OutputFormat format);
+
+#endif   //---- #ifndef SERVER_INC  -----
@@ -0,0 +1,101 @@
+//
+// =========================================================================
+//
+//       Filename:  settlement.h
+//
+//    Description:  Declares the settlement engine: the payments the
+//                  persons of a household actually made, their balances
+//                  against their fair shares and a plan of transfers
+//                  that evens the balances out.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 03:18:52 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  SETTLEMENT_INC
+#define  SETTLEMENT_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "arena.h"
+#include "name-table.h"
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// from pays to the amount in cents
+struct transfer {
+  uint32_t from;    // person, counted from 0
+  uint32_t to;
+  int64_t  cents;
+};  // -----  end of struct transfer  -----
+
+typedef struct transfer Transfer;
+
+// A payments file has a [payments] section with one line per payment,
+// the person as key and the expense and the amount as value:
+//
+//   [payments]
+//   Max  = rent 1200
+//   Maxi = telecom 60
+//   Maxi = power 80
+//
+// A person may pay an expense in several parts, but the payments of
+// every expense have to add up to its cost. All amounts are kept in
+// cents, so that the balances add up to zero exactly.
+struct settlement {
+  std::vector<int64_t>  paid;       // per person
+  std::vector<int64_t>  paidCosts;  // per expense
+  std::vector<int64_t>  owed;       // per person, the fair share
+  std::vector<int64_t>  balances;   // per person, paid - owed
+  std::vector<Transfer> transfers;  // the plan
+  bool                  exact;      // the plan has the fewest transfers
+
+  // scratch of ParsePayments, the names of the household to their ids
+  Arena                 arena;
+  NameTable             personNames;
+  NameTable             expenseNames;
+  std::vector<uint32_t> personOf;   // name id to the first such person
+  std::vector<uint32_t> expenseOf;
+
+  // scratch of PlanTransfers
+  std::vector<uint32_t> members;    // persons with a balance
+  std::vector<int64_t>  remaining;  // per person, of the balance
+  std::vector<uint32_t> creditors;  // heaps of persons by remaining
+  std::vector<uint32_t> debtors;
+  std::vector<int64_t>  subsetSums; // exact only, one per subset
+  std::vector<uint8_t>  subsetGroups;
+  std::vector<uint32_t> group;
+};  // -----  end of struct settlement  -----
+
+typedef struct settlement Settlement;
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+extern const std::size_t kMaxExactMembers;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+void InitSettlement   (Settlement & s);
+bool ParsePayments    (std::string_view text, const std::string & fileName,
+                       const std::vector<Person>  & p,
+                       const std::vector<Expense> & e,
+                       Settlement & s, std::string & error);
+bool SettleBalances   (const std::vector<Expense> & e, const Allocation & a,
+                       Settlement & s, std::string & error);
+void PlanTransfers    (Settlement & s, bool exact);
+#endif   //---- #ifndef SETTLEMENT_INC  -----
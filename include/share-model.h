@@ -0,0 +1,85 @@
+//
+// =========================================================================
+//
+//       Filename:  share-model.h
+//
+//    Description:  Declares the incremental share model: the inputs of
+//                  an allocation together with the running sums of all
+//                  incomes and costs, so that changing one income or one
+//                  cost is O(1) and every share is evaluated on demand.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 07:34:12 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  SHARE_MODEL_INC
+#define  SHARE_MODEL_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// Every share is income(j)/sumIncomes*cost(i), so after an update only
+// the two sums have to be adjusted. Changing an income changes every
+// share, changing a cost only its column and the totals; both are read
+// through the lazy view below instead of being stored.
+//
+// The running sums pick up a rounding error with every update. The
+// bounds of these errors are tracked and a sum is added up again from
+// scratch once its bound exceeds kModelTolerance relative to the sum,
+// e.g. when most of it cancelled.
+struct share_model {
+  std::vector<double> incomes;
+  std::vector<double> costs;
+  double              sumIncomes;
+  double              sumCosts;
+  double              ratio;        // 1/sumIncomes
+  double              incomeError;  // bound of the error of sumIncomes
+  double              costError;    // bound of the error of sumCosts
+  uint64_t            updates;      // since InitShareModel
+  uint64_t            resums;       // sums added up again, for statistics
+};  // -----  end of struct share_model  -----
+
+typedef struct share_model ShareModel;
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+extern const double kModelTolerance;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+void   InitShareModel      (ShareModel & m, const std::vector<Person>  & p,
+                            const std::vector<Expense> & e);
+void   UpdateIncome        (ShareModel & m, std::size_t person, double income);
+void   UpdateCost          (ShareModel & m, std::size_t expense, double cost);
+
+void   ExpenseColumn       (const ShareModel & m, std::size_t expense,
+                            double * shares);
+double ShareModelDeviation (const ShareModel & m, Allocation & scratch);
+
+// the lazy view, O(1) each
+inline double ModelShare   (const ShareModel & m, std::size_t person,
+                            std::size_t expense) {
+  return m.incomes[person]*m.ratio*m.costs[expense];
+}
+inline double ModelTotal   (const ShareModel & m, std::size_t person) {
+  return m.incomes[person]*m.ratio*m.sumCosts;
+}
+inline double ModelPercent (const ShareModel & m) {
+  return 100.*m.sumCosts*m.ratio;
+}
+#endif   //---- #ifndef SHARE_MODEL_INC  -----
@@ -0,0 +1,127 @@
+//
+// =========================================================================
+//
+//       Filename:  stats.h
+//
+//    Description:  Declares the instrumentation of a run: timers of its
+//                  phases, counters of records and bytes, and the log2
+//                  histograms both are recorded into. Everything but the
+//                  histograms compiles to nothing unless FAIRSHARE_STATS
+//                  is defined, as in the debug and stats builds.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 05:02:37 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  STATS_INC
+#define  STATS_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//--------------------------------------------------------------------------
+//  enums
+//--------------------------------------------------------------------------
+enum StatsPhase : unsigned short {
+  PhaseArguments,    // GetArgsToMain
+  PhaseParse,        // ParseIniFile, through the cache or not
+  PhaseCheckIncome,  // CheckIncomeIsNonZeroOrExit
+  PhaseAllocate,     // AllocateOrExit, the ratio and the shares
+  PhaseOutput,       // DisplayResults and the other writers
+  PhaseHousehold,    // one household of --batch or --series
+  PhaseQuery,        // one query of --serve
+};        // ----------  end of enum StatsPhase  ----------
+
+enum StatsCounter : unsigned short {
+  CounterRecords,         // persons and expenses parsed
+  CounterBytesRead,       // of the files mapped
+  CounterBytesWritten,    // to the output stream
+  CounterAllocations,     // calls of operator new, if counted
+  CounterAllocatedBytes,
+};        // ----------  end of enum StatsCounter  ----------
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+// one bucket per power of two nanoseconds, the last one is open ended
+const std::size_t kLatencyBuckets = 48;
+const std::size_t kStatsPhases    = 7;
+const std::size_t kStatsCounters  = 5;
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// Request latencies in log2 buckets: bucket b counts the requests that
+// took [2^b, 2^(b+1)) nanoseconds.
+struct latency_histogram {
+  uint64_t counts[kLatencyBuckets];
+  uint64_t requests;
+  uint64_t maxNs;
+};  // -----  end of struct latency_histogram  -----
+
+typedef struct latency_histogram LatencyHistogram;
+
+// Every thread records into its own RunStats, without atomics; a thread
+// adds them to those of the process with MergeThreadStats before it ends.
+struct run_stats {
+  LatencyHistogram phases[kStatsPhases];  // one sample per call
+  uint64_t         phaseNs[kStatsPhases]; // summed over all calls
+  uint64_t         counters[kStatsCounters];
+};  // -----  end of struct run_stats  -----
+
+typedef struct run_stats RunStats;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+void     ClearLatencies    (LatencyHistogram & h);
+void     RecordLatency     (LatencyHistogram & h, uint64_t ns);
+uint64_t LatencyPercentile (const LatencyHistogram & h, double p);
+void     WriteLatencies    (const LatencyHistogram & h, std::string & out);
+
+#ifdef FAIRSHARE_STATS
+
+const bool kStatsCompiledIn = true;
+
+uint64_t StatsClockNs      ();
+void     RecordPhase       (StatsPhase phase, uint64_t ns);
+void     CountStat         (StatsCounter counter, uint64_t n);
+void     MergeThreadStats  ();
+bool     CollectStats      (RunStats & s);
+void     WriteStatsJson    (const RunStats & s, std::string & out);
+
+// Times the scope it lives in as one call of phase.
+struct phase_timer {
+  explicit phase_timer (const StatsPhase p) : phase(p), start(StatsClockNs()) {}
+  ~phase_timer () { RecordPhase(phase, StatsClockNs() - start); }
+
+  StatsPhase phase;
+  uint64_t   start;
+};  // -----  end of struct phase_timer  -----
+
+#else
+
+const bool kStatsCompiledIn = false;
+
+inline void RecordPhase      (StatsPhase, uint64_t) {}
+inline void CountStat        (StatsCounter, uint64_t) {}
+inline void MergeThreadStats () {}
+inline bool CollectStats     (RunStats &) { return false; }
+inline void WriteStatsJson   (const RunStats &, std::string &) {}
+
+struct phase_timer {
+  explicit phase_timer (StatsPhase) {}
+};  // -----  end of struct phase_timer  -----
+
+#endif   //---- #ifdef FAIRSHARE_STATS  -----
+
+typedef struct phase_timer PhaseTimer;
+
+#endif   //---- #ifndef STATS_INC  -----
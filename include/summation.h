@@ -0,0 +1,68 @@
+//
+// =========================================================================
+//
+//       Filename:  summation.h
+//
+//    Description:  Declares the sums of incomes and costs that give the
+//                  same bits in the debug, release and stats builds:
+//                  pairwise and compensated (Kahan-Babuska) sums of
+//                  arrays, a compensated accumulator for records, and
+//                  compensated running totals.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 01:37:52 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  SUMMATION_INC
+#define  SUMMATION_INC
+
+#include <cstddef>
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// The value of the sum is sum + error, error being what the rounding of
+// every addition to sum lost. The functions are defined in summation.cc,
+// which the Makefile compiles without -ffast-math, and never inline: in
+// a translation unit with -ffast-math the compiler would be free to
+// simplify the compensation away.
+struct compensated_sum {
+  double sum;
+  double error;
+};  // -----  end of struct compensated_sum  -----
+
+typedef struct compensated_sum CompensatedSum;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+double SumPairwise            (const double * x, std::size_t n);
+double SumCompensated         (const double * x, std::size_t n);
+
+// SumPairwise of exactly N values, N from 1 to 8, without a branch on the
+// length; n is ignored, so that it fits the tables of kernels by size
+template <std::size_t N>
+double SumFixed               (const double * x, std::size_t n);
+
+void   InitCompensatedSum     (CompensatedSum & s);
+void   AddCompensated         (CompensatedSum & s, double x);
+double CompensatedTotal       (const CompensatedSum & s);
+
+void   AccumulateCompensated  (double * totals, double * errors,
+                               const double * x, std::size_t n);
+
+extern template double SumFixed<1> (const double *, std::size_t);
+extern template double SumFixed<2> (const double *, std::size_t);
+extern template double SumFixed<3> (const double *, std::size_t);
+extern template double SumFixed<4> (const double *, std::size_t);
+extern template double SumFixed<5> (const double *, std::size_t);
+extern template double SumFixed<6> (const double *, std::size_t);
+extern template double SumFixed<7> (const double *, std::size_t);
+extern template double SumFixed<8> (const double *, std::size_t);
+#endif   //---- #ifndef SUMMATION_INC  -----
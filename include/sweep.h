@@ -0,0 +1,122 @@
+//
+// =========================================================================
+//
+//       Filename:  sweep.h
+//
+//    Description:  Declares the sweep engine: a grid of scenarios in which
+//                  the incomes of some persons and the costs of some
+//                  expenses run over ranges, evaluated in blocks of
+//                  consecutive scenarios by a kernel over the scenario
+//                  dimension.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 07:26:50 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  SWEEP_INC
+#define  SWEEP_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ledger.h"
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+extern const std::size_t kSweepBlock;         // scenarios per block
+extern const uint64_t    kMaxSweepScenarios;
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// One dimension of the grid, given as key=start:stop:step where the key
+// is the number of a person, counted from 1 as in -i n:income, or the
+// name of an expense. The values are start + k*step for k < count, the
+// last one being the one closest to stop that does not pass it.
+struct sweep_axis {
+  bool        expense;  // sweeps the cost of an expense, else an income
+  std::size_t index;    // of the person or expense, counted from 0
+  double      start;
+  double      step;
+  uint64_t    count;
+};  // -----  end of struct sweep_axis  -----
+
+typedef struct sweep_axis SweepAxis;
+
+// Every policy splits an expense of cost c as income(j)*slope +
+// offset(j), see allocation.cc, with the slope c - fixed amounts per
+// income and offset(j) an equal part, a weighted part or a fixed amount.
+// Summed over the expenses, person j pays
+//
+//   total(j) = income(j)*rate + constant(j),  rate = split/income sum,
+//
+// where split is the part of the costs split by income. A swept cost v
+// adds alpha*v to split and beta(j)*v to constant(j); a swept income v
+// adds v to the income sum. The fair share, as in the table of
+// DisplayResults, is the sum of all costs per income sum.
+//
+// The scenarios are numbered row-major, the last axis running fastest,
+// and evaluated kSweepBlock at a time: the values of every axis are laid
+// out per scenario of the block, then every quantity above is one loop
+// over the block without branches.
+struct sweep {
+  std::vector<SweepAxis>   axes;
+  std::size_t              persons;
+  uint64_t                 scenarios;  // product of the counts
+  std::vector<uint64_t>    strides;    // scenarios per step of an axis
+
+  // the household without the swept amounts
+  double                   incomeSum;  // of the persons not swept
+  double                   split;      // costs split by income
+  double                   costSum;    // of the expenses not swept
+  std::vector<double>      incomes;    // per person, 0 if swept
+  std::vector<double>      constants;  // per person
+  std::vector<std::size_t> sweptBy;    // per person, axis or axes.size()
+  std::vector<double>      alphas;     // per axis, 0 for incomes
+  std::vector<double>      betas;      // per axis and person, row-major
+
+  // the current block, see NextSweepBlock
+  uint64_t                 first;      // scenario, counted from 0
+  std::size_t              size;       // scenarios in the block
+  std::vector<double>      values;     // per axis and scenario, row-major
+  std::vector<double>      ramp;       // 0, 1, 2, ... to count the last axis
+  std::vector<double>      sums;       // income sum per scenario
+  std::vector<double>      splits;     // split per scenario
+  std::vector<double>      costs;      // cost sum per scenario
+  std::vector<double>      rates;      // per scenario
+  std::vector<double>      shares;     // fair share per scenario
+  std::vector<double>      totals;     // per person and scenario, row-major
+};  // -----  end of struct sweep  -----
+
+typedef struct sweep Sweep;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+bool ParseSweepAxis  (std::string_view spec, const std::vector<Person> & p,
+                      const std::vector<Expense> & e, SweepAxis & axis,
+                      std::string & error);
+bool PrepareSweep    (const std::vector<Person> & p,
+                      const std::vector<Expense> & e, Sweep & s,
+                      std::string & error);
+bool NextSweepBlock  (Sweep & s);
+
+inline double SweepValue (const Sweep & s, const std::size_t axis,
+                          const std::size_t t) {
+  return s.values[axis*kSweepBlock + t];
+}
+inline double SweepTotal (const Sweep & s, const std::size_t person,
+                          const std::size_t t) {
+  return s.totals[person*kSweepBlock + t];
+}
+#endif   //---- #ifndef SWEEP_INC  -----
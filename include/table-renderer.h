@@ -0,0 +1,50 @@
+//
+// =========================================================================
+//
+//       Filename:  table-renderer.h
+//
+//    Description:  Declares the renderer of the results table, see
+//                  DisplayResults for the layout.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 04:02:55 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  TABLE_RENDERER_INC
+#define  TABLE_RENDERER_INC
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// All buffers are reused when the same TableBuffer renders again.
+struct table_buffer {
+  std::string              text;     // the rendered table
+  std::vector<char>        numbers;  // all formatted numbers, back to back
+  std::vector<std::size_t> ends;     // end of each number in numbers
+};  // -----  end of struct table_buffer  -----
+
+typedef struct table_buffer TableBuffer;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+std::size_t FormatFixed2 (double x, char * first, char * last);
+
+void        RenderTable  (const std::vector<Person>  & p,
+                          const std::vector<Expense> & e,
+                          const Allocation & a, TableBuffer & b);
+
+#endif   //---- #ifndef TABLE_RENDERER_INC  -----
@@ -0,0 +1,110 @@
+//
+// =========================================================================
+//
+//       Filename:  time-series.h
+//
+//    Description:  Declares households whose incomes and costs change
+//                  from period to period, e.g. month by month, and the
+//                  streaming engine that splits them one period at a
+//                  time while it keeps the running totals.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 11:52:40 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  TIME_SERIES_INC
+#define  TIME_SERIES_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ini-parser.h"
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// A series household is written like settings.ini, but every income and
+// every cost is a list of amounts separated by blanks, one per period:
+//
+//   [person1]
+//   name   = Max
+//   income = 1000 1000 1000 1200 1200 1200
+//   [expenses]
+//   rent      = 600
+//   utilities = 80 95 110 70 60 55
+//
+// A single amount holds in every period. All longer lists of a household
+// must have the same length, which is the number of periods.
+//
+// The inputs are stored period-major, so that the incomes and costs of
+// one period are contiguous and go to the kernels as they are. Only the
+// inputs are kept, never the shares of all periods: a household of P
+// periods takes P*(persons + expenses) doubles.
+struct time_series {
+  std::vector<std::string> personNames;
+  std::vector<std::string> expenseNames;
+  std::size_t              periods;
+  std::vector<double>      incomes;  // periods x persons
+  std::vector<double>      costs;    // periods x expenses
+
+  // scratch of the parser: the amounts of all lists in the order of the
+  // file, and per person and per expense where its list begins and ends
+  std::vector<double>      rowValues;
+  std::vector<std::size_t> incomeRows;  // begin, end of every person
+  std::vector<std::size_t> costRows;    // begin, end of every expense
+};  // -----  end of struct time_series  -----
+
+typedef struct time_series TimeSeries;
+
+// The state of the engine between two periods. shares and totals are
+// those of the last period split, cumulative and cumulativeTotals their
+// sums over all periods so far, compensated by the errors, see
+// AccumulateCompensated. All buffers are reused by the next household.
+struct series_state {
+  std::size_t           period;            // periods split so far
+  bool                  cents;
+  std::vector<double>   shares;            // persons x expenses, row-major
+  std::vector<double>   totals;            // one per person
+  std::vector<double>   cumulative;        // persons x expenses
+  std::vector<double>   cumulativeTotals;  // one per person
+  std::vector<double>   cumulativeErrors;
+  std::vector<double>   cumulativeTotalErrors;
+
+  // only used with cents, see AllocateCents
+  std::vector<int64_t>  centIncomes;
+  std::vector<int64_t>  centCosts;
+  std::vector<int64_t>  centShares;
+  std::vector<int64_t>  centTotals;
+  std::vector<uint64_t> centScratch;
+  std::vector<int64_t>  centCumulative;
+  std::vector<int64_t>  centCumulativeTotals;
+};  // -----  end of struct series_state  -----
+
+typedef struct series_state SeriesState;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+IniToken     ParseSeriesHousehold (IniScanner & s, TimeSeries & ts,
+                                   bool stopAtNextHousehold,
+                                   bool & pendingPerson);
+
+const char * StartSeries          (const TimeSeries & ts, bool cents,
+                                   SeriesState & state);
+void         NextPeriod           (const TimeSeries & ts, SeriesState & state);
+
+inline std::size_t SeriesPersons  (const TimeSeries & ts) {
+  return ts.personNames.size();
+}
+inline std::size_t SeriesExpenses (const TimeSeries & ts) {
+  return ts.expenseNames.size();
+}
+#endif   //---- #ifndef TIME_SERIES_INC  -----
@@ -0,0 +1,126 @@
+//
+// =========================================================================
+//
+//       Filename:  transactions.h
+//
+//    Description:  Declares the ingester of bank statements: CSV exports
+//                  of transactions are read in chunks, their amounts
+//                  added up per description in a hash table, and the
+//                  sums mapped to expenses by a table of rules.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 09:02:16 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  TRANSACTIONS_INC
+#define  TRANSACTIONS_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ledger.h"
+#include "arena.h"
+#include "name-table.h"
+#include "chunk-reader.h"
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+extern const std::size_t kTransactionChunkBytes;  // also the longest line
+extern const std::size_t kMaxTransactionKeys;     // distinct descriptions
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// A rules file describes the columns of the export and maps the
+// descriptions of the transactions to expenses:
+//
+//   [format]
+//   separator = ;        ; a character or tab, ',' by default
+//   decimal   = ,        ; '.' by default, the other one groups thousands
+//   key       = 3        ; the column of the description, counted from 1
+//   amount    = 5
+//   header    = 1        ; lines before the first transaction, 1 by default
+//   debits    = negative ; or positive, the sign of money spent
+//
+//   [rules]
+//   rent  = Hausverwaltung
+//   food  = REWE
+//   food  = EDEKA
+//
+// A transaction belongs to the expense of the first rule whose text is
+// part of its description; fields may be quoted as in RFC 4180.
+struct transaction_rule {
+  std::string expense;
+  std::string text;
+};  // -----  end of struct transaction_rule  -----
+
+typedef struct transaction_rule TransactionRule;
+
+struct transaction_format {
+  char        separator;
+  char        decimal;
+  std::size_t keyColumn;     // counted from 0
+  std::size_t amountColumn;  // counted from 0
+  std::size_t headerLines;
+  bool        debitsNegative;
+};  // -----  end of struct transaction_format  -----
+
+typedef struct transaction_format TransactionFormat;
+
+// The amounts are added up in cents per distinct description, so memory
+// grows with the number of descriptions, not of transactions; the rules
+// are matched once per description after the file is read. A file with
+// more than kMaxTransactionKeys descriptions is an error, as its key
+// column most likely holds something unique per transaction, such as a
+// reference number, and would take memory in proportion to its size.
+struct transaction_ledger {
+  TransactionFormat            format;
+  std::vector<TransactionRule> rules;
+  Arena                        arena;        // the bytes of the keys
+  NameTable                    keys;         // descriptions, by id
+  std::vector<int64_t>         cents;        // sum per key
+  std::vector<uint64_t>        counts;       // transactions per key
+  uint64_t                     lines;        // read so far
+  uint64_t                     transactions;
+  std::string                  fileName;     // for the errors
+  ChunkReader                  reader;
+};  // -----  end of struct transaction_ledger  -----
+
+typedef struct transaction_ledger TransactionLedger;
+
+// what ApplyTransactions did
+struct transaction_summary {
+  std::size_t expenses;          // set from the transactions
+  std::size_t added;             // of them not in settings.ini
+  uint64_t    unmatchedKeys;
+  uint64_t    unmatchedTransactions;
+  int64_t     unmatchedCents;
+};  // -----  end of struct transaction_summary  -----
+
+typedef struct transaction_summary TransactionSummary;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+void InitTransactionLedger  (TransactionLedger & t);
+bool ParseTransactionRules  (std::string_view text,
+                             const std::string & fileName,
+                             TransactionLedger & t, std::string & error);
+bool ScanTransactions       (std::string_view text, TransactionLedger & t,
+                             std::size_t & consumed, std::string & error);
+bool IngestTransactions     (const std::string & fileName,
+                             TransactionLedger & t, std::string & error);
+void ApplyTransactions      (const TransactionLedger & t,
+                             std::vector<Expense> & e,
+                             TransactionSummary & summary);
+#endif   //---- #ifndef TRANSACTIONS_INC  -----
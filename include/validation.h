@@ -0,0 +1,78 @@
+//
+// =========================================================================
+//
+//       Filename:  validation.h
+//
+//    Description:  Declares the validation stage: structured errors of
+//                  single records, i.e. households, the checks that find
+//                  them without exiting, and the reject file that bad
+//                  households are quarantined to while a batch goes on.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 06:14:05 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+#ifndef  VALIDATION_INC
+#define  VALIDATION_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ledger.h"
+
+//--------------------------------------------------------------------------
+//  pods
+//--------------------------------------------------------------------------
+// Why a record was rejected and where. Errors of the parser know the
+// line and the section; errors found after parsing name the person as
+// section person<n>, counted from 1 as in -i n:income, and have no line.
+struct record_error {
+  uint64_t    record;   // household, counted from 1, 0 for settings.ini
+  std::size_t line;     // in the file, counted from 1, 0 if unknown
+  std::size_t column;
+  std::string section;  // empty if unknown
+  std::string key;      // empty if unknown
+  std::string reason;
+};  // -----  end of struct record_error  -----
+
+typedef struct record_error RecordError;
+
+// The reject file is itself a batch file: every rejected household is
+// copied verbatim, preceded by a comment with its error, so it can be
+// fixed and run again.
+struct reject_log {
+  std::ostream * os;
+  std::string    fileName;  // of the input, for the comments
+  std::string    buffer;
+  uint64_t       records;   // rejected so far
+};  // -----  end of struct reject_log  -----
+
+typedef struct reject_log RejectLog;
+
+//--------------------------------------------------------------------------
+//  function declarations
+//--------------------------------------------------------------------------
+std::size_t CheckIncomes      (const std::vector<Person> & p, uint64_t record,
+                               std::vector<RecordError> & errors);
+void        DescribeAllocationError (const std::vector<Person> & p,
+                                     uint64_t record, const char * reason,
+                                     std::vector<RecordError> & errors);
+std::string FormatRecordError (const std::string & fileName,
+                               const RecordError & e);
+
+void        InitRejectLog     (RejectLog & r, std::ostream * os,
+                               const std::string & fileName);
+void        RejectRecord      (RejectLog & r, const RecordError * errors,
+                               std::size_t n, std::string_view text);
+void        FinishRejectLog   (RejectLog & r);
+#endif   //---- #ifndef VALIDATION_INC  -----
@@ -0,0 +1,443 @@
+//
+// =========================================================================
+//
+//       Filename:  allocation-cents.cc
+//
+//    Description:  Defines AllocateCents, the split of expenses in whole
+//                  cents by the largest remainder method. Person j first
+//                  gets
+//
+//                    floor(cost * income(j) / sum(incomes))
+//
+//                  and the cents left over, fewer than the number of
+//                  persons, go one each to the persons with the largest
+//                  remainders of that division; ties go to the person
+//                  listed first.
+//
+//                  The amounts are integers held exactly in doubles, and
+//                  the floors are rounded with the bits of the floating
+//                  point format, so this file is compiled without
+//                  -ffast-math in every build, see the Makefile.
+//
+//        Version:  1.0
+//        Created:  10/20/2026 09:12:44 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <algorithm>  // copy, fill, max, min, nth_element
+#include <cstddef>
+#include <cstdint>
+#include <cstring>    // memcpy
+#include <functional> // greater
+#include <limits>
+
+#include "allocation.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+__extension__ typedef __int128 int128;
+
+// Integers below 2^51 are exact in a double, and so are the sums and
+// differences the kernels form of them. x + kRound rounds x to an integer
+// for |x| < 2^51, and the integer is the difference of the bits of the
+// sum and of kRound, both being in [2^52, 2^53) where the unit in the
+// last place is 1.
+const double  kExactLimit = 2251799813685248.;  // 2^51
+const double  kRound      = 6755399441055744.;  // 1.5*2^52
+
+// households of up to that many persons rank their remainders against
+// each other in registers, see AllocateCentsFixed
+const std::size_t kMaxFixedCents = 8;
+
+// SelectRemainder: up to kSelectSmall remainders go to nth_element
+// directly, more are counted into up to kSelectBuckets buckets first
+const std::size_t kSelectSmall   = 32;
+const std::size_t kSelectBuckets = 256;
+
+// AllocateCentsColumns: the expenses split at a time, their shares of one
+// person filling a cache line
+const std::size_t kCentsBlock = 8;
+
+inline int64_t Bits (const double x) {
+  int64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return bits;
+}
+
+inline double FromBits (const int64_t bits) {
+  double x;
+  std::memcpy(&x, &bits, sizeof(x));
+  return x;
+}
+
+// the integer x, |x| < 2^51, as double; unlike the conversion instruction
+// this vectorizes without AVX-512
+inline double ToDouble (const int64_t x) {
+  return FromBits(x + Bits(kRound)) - kRound;
+}
+
+// 1 if c, else 0, selected in doubles: the bits of the smallest denormal
+// are 1. A comparison of doubles selecting an integer does not vectorize
+// with SSE2, this does.
+inline int64_t Unit (const bool c) {
+  return Bits(c ? std::numeric_limits<double>::denorm_min() : 0.);
+}
+
+// q = floor(p/w) and r = p - q*w, 0 <= r < w, for integers |p| < 2^51
+// and 0 < w < 2^51. p*invW is off the quotient by far less than one, so
+// rounding it gives the floor or the floor plus one, which the sign of
+// the exact remainder tells apart. No branches, so that the loops around
+// it vectorize.
+inline void DivideFloor (const double p, const double w, const double invW,
+                         int64_t & q, double & r) {
+  const double  t   = p*invW + kRound;
+  const double  r0  = p - (t - kRound)*w;
+  const bool    low = r0 < 0.;
+  q = Bits(t) - Bits(kRound) - Unit(low);
+  r = r0 + (low ? w : 0.);
+}
+
+// The kernel for households of N persons goes expense by expense, with
+// the N persons unrolled, and the compiler vectorizes it across the
+// expenses. Person j gets a leftover cent if fewer than leftover persons
+// rank before it: those with a larger remainder, or an equal one and
+// listed before. Every comparison of two persons is made once.
+template <std::size_t N>
+void AllocateCentsFixed (const int64_t * incomes, const int64_t * costs,
+                         const std::size_t nExpenses, int64_t * shares,
+                         int64_t * totals) {
+  double income[N];
+  double w = 0.;
+#pragma GCC unroll 8
+  for (std::size_t j = 0; j < N; ++j) {
+    income[j] = ToDouble(incomes[j]);
+    w        += income[j];
+  }
+  const double invW = 1./w;
+
+  int64_t total[N] = {};
+  for (std::size_t i = 0; i < nExpenses; ++i) {
+    const double cost = ToDouble(costs[i]);
+    int64_t q[N];
+    double  r[N];
+    double  rank[N] = {};
+    int64_t distributed = 0;
+#pragma GCC unroll 8
+    for (std::size_t j = 0; j < N; ++j) {
+      DivideFloor(cost*income[j], w, invW, q[j], r[j]);
+      distributed += q[j];
+    }
+#pragma GCC unroll 8
+    for (std::size_t l = 0; l < N; ++l) {
+#pragma GCC unroll 8
+      for (std::size_t j = l + 1; j < N; ++j) {
+        const bool before = r[l] >= r[j];  // l ranks before j
+        rank[j] += before ? 1. : 0.;
+        rank[l] += before ? 0. : 1.;
+      }
+    }
+    const double leftover = ToDouble(costs[i] - distributed);
+
+#pragma GCC unroll 8
+    for (std::size_t j = 0; j < N; ++j) {
+      const int64_t share = q[j] + Unit(rank[j] < leftover);
+      shares[j*nExpenses + i] = share;
+      total[j]               += share;
+    }
+  }  // -----  end for expenses  -----
+
+#pragma GCC unroll 8
+  for (std::size_t j = 0; j < N; ++j) {
+    totals[j] = total[j];
+  }
+}
+
+// Two persons share at most one leftover cent, and their remainders add
+// up to it times the sum of the incomes: the first person gets the cent
+// if its remainder is at least half that sum, which is rounding its
+// exact share half up, and the second person the rest of the cost.
+void AllocateCentsPair (const int64_t * incomes, const int64_t * costs,
+                        const std::size_t nExpenses, int64_t * shares,
+                        int64_t * totals) {
+  const double income = ToDouble(incomes[0]);
+  const double w      = income + ToDouble(incomes[1]);
+  const double invW   = 1./w;
+
+  int64_t *__restrict first       = shares;
+  int64_t *__restrict second      = shares + nExpenses;
+  int64_t             totalFirst  = 0;
+  int64_t             totalSecond = 0;
+  for (std::size_t i = 0; i < nExpenses; ++i) {
+    int64_t q;
+    double  r;
+    DivideFloor(ToDouble(costs[i])*income, w, invW, q, r);
+    const int64_t share = q + Unit(r + r >= w);
+    first[i]     = share;
+    second[i]    = costs[i] - share;
+    totalFirst  += share;
+    totalSecond += costs[i] - share;
+  }
+  totals[0] = totalFirst;
+  totals[1] = totalSecond;
+}
+
+// Returns the leftover-th largest of the n remainders, 0 < leftover < n,
+// which are in [0, w). Larger sets are counted into buckets by their
+// fraction of w first; those of the bucket that holds the threshold are
+// copied to candidates and the threshold is found by nth_element.
+// Remainders equal to the threshold beyond the leftover cents, in the
+// order of the persons, are set to -1 so that they do not get a cent.
+double SelectRemainder (double * remainders, const std::size_t n,
+                        const std::size_t leftover, const double w,
+                        double * candidates) {
+  std::size_t above = 0;  // remainders above the candidates
+  std::size_t count = 0;
+  if (n <= kSelectSmall) {
+    std::copy(remainders, remainders + n, candidates);
+    count = n;
+  } else {
+    std::size_t buckets = kSelectBuckets;
+    while (buckets > kSelectSmall/2 && 4*buckets > n) {
+      buckets /= 2;
+    }
+    const double  scale = static_cast<double>(buckets)/w;
+    const int64_t last  = static_cast<int64_t>(buckets) - 1;
+
+    std::size_t counts[kSelectBuckets];
+    std::fill(counts, counts + buckets, 0);
+    for (std::size_t j = 0; j < n; ++j) {
+      ++counts[std::min(last, static_cast<int64_t>(remainders[j]*scale))];
+    }
+    int64_t bucket = last;
+    while (above + counts[bucket] < leftover) {
+      above += counts[bucket--];
+    }
+    for (std::size_t j = 0; j < n; ++j) {
+      candidates[count] = remainders[j];
+      count += std::min(last, static_cast<int64_t>(remainders[j]*scale))
+               == bucket;
+    }
+  }  // -----  end if  -----
+
+  const std::size_t k = leftover - above - 1;
+  std::nth_element(candidates, candidates + k, candidates + count,
+                   std::greater<double>());
+  const double threshold = candidates[k];
+
+  // the k-th candidate and the tiesBefore ones before it equal to it get
+  // a cent, the tiesAfter ones after it do not; those before are not
+  // smaller, those after not larger
+  std::size_t tiesBefore = 0;
+  std::size_t tiesAfter  = 0;
+  for (std::size_t l = 0; l < k; ++l) {
+    tiesBefore += candidates[l] <= threshold ? 1 : 0;
+  }
+  for (std::size_t l = k + 1; l < count; ++l) {
+    tiesAfter += candidates[l] >= threshold ? 1 : 0;
+  }
+  if (tiesAfter > 0) {
+    std::size_t given = 0;
+    for (std::size_t j = 0; j < n; ++j) {
+      const bool tie = remainders[j] >= threshold
+                       && remainders[j] <= threshold;
+      if (tie && given++ > tiesBefore) {
+        remainders[j] = -1.;
+      }
+    }
+  }  // -----  end if  -----
+  return threshold;
+}
+
+// The kernel for any number of persons goes through the expenses in
+// blocks of kCentsBlock. The first pass over the persons writes the
+// floors and the remainders of an expense to scratch, without branches,
+// and vectorizes. The leftover cents go to the persons whose remainder is
+// not below the threshold SelectRemainder finds, in a second pass that
+// writes the shares of a block person by person, a cache line each.
+// scratch holds (2*kCentsBlock + 1)*nPersons values.
+void AllocateCentsColumns (const int64_t * incomes, const std::size_t nPersons,
+                           const int64_t * costs, const std::size_t nExpenses,
+                           const int64_t sumIncomes, int64_t * shares,
+                           int64_t * totals, uint64_t * scratch) {
+  const double w    = ToDouble(sumIncomes);
+  const double invW = 1./w;
+  int64_t *    quotients  = reinterpret_cast<int64_t *>(scratch);
+  double *     remainders =
+    reinterpret_cast<double *>(scratch + kCentsBlock*nPersons);
+  double *     candidates =
+    reinterpret_cast<double *>(scratch + 2*kCentsBlock*nPersons);
+  double       threshold[kCentsBlock];
+
+  for (std::size_t j = 0; j < nPersons; ++j) {
+    totals[j] = 0;
+  }
+  for (std::size_t i0 = 0; i0 < nExpenses; i0 += kCentsBlock) {
+    const std::size_t width = std::min(kCentsBlock, nExpenses - i0);
+    for (std::size_t k = 0; k < width; ++k) {
+      int64_t *__restrict q    = quotients + k*nPersons;
+      double *__restrict  r    = remainders + k*nPersons;
+      const double        cost = ToDouble(costs[i0 + k]);
+      int64_t             distributed = 0;
+      for (std::size_t j = 0; j < nPersons; ++j) {
+        DivideFloor(cost*ToDouble(incomes[j]), w, invW, q[j], r[j]);
+        distributed += q[j];
+      }  // -----  end for persons  -----
+
+      // 0 <= leftover < nPersons, as every floor is off by less than a
+      // cent
+      const std::size_t leftover =
+        static_cast<std::size_t>(costs[i0 + k] - distributed);
+      threshold[k] = leftover == 0 ? w  // no remainder is that large
+        : SelectRemainder(r, nPersons, leftover, w, candidates);
+    }  // -----  end for expenses  -----
+
+    for (std::size_t j = 0; j < nPersons; ++j) {
+      int64_t *__restrict row   = shares + j*nExpenses + i0;
+      int64_t             total = 0;
+      for (std::size_t k = 0; k < width; ++k) {
+        const int64_t share = quotients[k*nPersons + j]
+          + Unit(remainders[k*nPersons + j] >= threshold[k]);
+        row[k] = share;
+        total += share;
+      }
+      totals[j] += total;
+    }  // -----  end for persons  -----
+  }  // -----  end for blocks  -----
+}
+
+// The kernel for amounts too large for the others, expense by expense in
+// 128 bit integers.
+void AllocateCentsWide (const int64_t * incomes, const std::size_t nPersons,
+                        const int64_t * costs,   const std::size_t nExpenses,
+                        const int64_t sumIncomes, int64_t * shares,
+                        int64_t * totals, uint64_t * scratch) {
+  int64_t *  quotients  = reinterpret_cast<int64_t *>(scratch);
+  int64_t *  remainders = quotients + nPersons;
+  uint64_t * order      = scratch + 2*nPersons;
+
+  for (std::size_t j = 0; j < nPersons; ++j) {
+    totals[j] = 0;
+  }
+  for (std::size_t i = 0; i < nExpenses; ++i) {
+    const int64_t cost        = costs[i];
+    int64_t       distributed = 0;
+    for (std::size_t j = 0; j < nPersons; ++j) {
+      const int128 product = static_cast<int128>(cost)*incomes[j];
+      int128 q = product/sumIncomes;
+      int128 r = product%sumIncomes;
+      if (r < 0) {
+        --q;
+        r += sumIncomes;
+      }
+      quotients[j]  = static_cast<int64_t>(q);
+      remainders[j] = static_cast<int64_t>(r);
+      distributed  += quotients[j];
+    }  // -----  end for persons  -----
+
+    const std::size_t leftover = static_cast<std::size_t>(cost - distributed);
+    if (leftover > 0) {
+      for (std::size_t j = 0; j < nPersons; ++j) {
+        order[j] = j;
+      }
+      std::nth_element(order, order + leftover - 1, order + nPersons,
+                       [remainders](uint64_t a, uint64_t b) {
+        return remainders[a] > remainders[b]
+          || (remainders[a] == remainders[b] && a < b);
+      });
+      for (std::size_t k = 0; k < leftover; ++k) {
+        ++quotients[order[k]];
+      }
+    }  // -----  end if  -----
+
+    for (std::size_t j = 0; j < nPersons; ++j) {
+      shares[j*nExpenses + i] = quotients[j];
+      totals[j]              += quotients[j];
+    }  // -----  end for  -----
+  }  // -----  end for expenses  -----
+}
+
+typedef void (*CentsKernel) (const int64_t * incomes, const int64_t * costs,
+                             std::size_t nExpenses, int64_t * shares,
+                             int64_t * totals);
+
+const CentsKernel kCentsKernels[kMaxFixedCents + 1] = {
+  NULL,                      AllocateCentsFixed<1>,
+  AllocateCentsPair,         AllocateCentsFixed<3>,
+  AllocateCentsFixed<4>,     AllocateCentsFixed<5>,
+  AllocateCentsFixed<6>,     AllocateCentsFixed<7>,
+  AllocateCentsFixed<8>,
+};
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  AllocateCentsScratch
+//  Description:  Returns the number of values AllocateCents needs as
+//                scratch for nPersons.
+// =========================================================================
+std::size_t AllocateCentsScratch (const std::size_t nPersons) {
+  return (2*kCentsBlock + 1)*nPersons;
+}   // -----  end of function AllocateCentsScratch  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  AllocateCents
+//  Description:  Splits every expense in whole cents such that the shares
+//                (nPersons x nExpenses, row-major) add up to the cost
+//                exactly, see the top of this file, and writes the sum of
+//                each row into totals. scratch holds at least
+//                AllocateCentsScratch(nPersons) values.
+//
+//                As long as the sum of the incomes and all products of a
+//                cost and an income are below 2^51 cents, the floors and
+//                remainders are exact in doubles and computed in loops
+//                the compiler vectorizes, see AllocateCentsFixed and
+//                AllocateCentsColumns. Larger amounts
+//                use 128 bit integers. The result does not depend on the
+//                kernel. Returns false if an income is negative or all
+//                incomes are zero.
+// =========================================================================
+bool AllocateCents (const int64_t * incomes, const std::size_t nPersons,
+                    const int64_t * costs,   const std::size_t nExpenses,
+                    int64_t * shares, int64_t * totals, uint64_t * scratch) {
+
+  int64_t sumIncomes = 0;
+  int64_t maxIncome  = 0;
+  for (std::size_t j = 0; j < nPersons; ++j) {
+    if (incomes[j] < 0) {
+      return false;
+    }
+    sumIncomes += incomes[j];
+    maxIncome   = std::max(maxIncome, incomes[j]);
+  }  // -----  end for  -----
+  if (sumIncomes <= 0) {
+    return false;
+  }
+
+  int64_t maxCost = 0;
+  for (std::size_t i = 0; i < nExpenses; ++i) {
+    maxCost = std::max(maxCost, costs[i] < 0 ? -costs[i] : costs[i]);
+  }  // -----  end for  -----
+
+  const double w     = static_cast<double>(sumIncomes);
+  const bool   exact = w < kExactLimit
+    && static_cast<double>(maxCost)*static_cast<double>(maxIncome)
+       < kExactLimit;
+
+  if (exact && nPersons <= kMaxFixedCents) {
+    kCentsKernels[nPersons](incomes, costs, nExpenses, shares, totals);
+  } else if (exact) {
+    AllocateCentsColumns(incomes, nPersons, costs, nExpenses, sumIncomes,
+                         shares, totals, scratch);
+  } else {
+    AllocateCentsWide(incomes, nPersons, costs, nExpenses, sumIncomes,
+                      shares, totals, scratch);
+  }
+  return true;
+}  // -----  end of function AllocateCents  -----
@@ -0,0 +1,62 @@
+//
+// =========================================================================
+//
+//       Filename:  allocation-stats.cc
+//
+//    Description:  Counts the calls and bytes of operator new of the
+//                  fairshare program for --stats. Only linked into the
+//                  program, so that neither the library nor the
+//                  benchmarks, which count allocations themselves, get a
+//                  second operator new, and empty unless FAIRSHARE_STATS
+//                  is defined.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 05:02:37 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "stats.h"
+
+#ifdef FAIRSHARE_STATS
+
+void * operator new (std::size_t size) {
+  CountStat(CounterAllocations, 1);
+  CountStat(CounterAllocatedBytes, size);
+  void * p = std::malloc(size > 0 ? size : 1);
+  if (p == NULL) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void * operator new[] (std::size_t size) {
+  return ::operator new(size);
+}
+
+void operator delete (void * p) noexcept {
+  std::free(p);
+}
+
+void operator delete[] (void * p) noexcept {
+  std::free(p);
+}
+
+void operator delete (void * p, std::size_t) noexcept {
+  std::free(p);
+}
+
+void operator delete[] (void * p, std::size_t) noexcept {
+  std::free(p);
+}
+
+#endif   //---- #ifdef FAIRSHARE_STATS  -----
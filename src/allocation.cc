@@ -0,0 +1,673 @@
+//
+// =========================================================================
+//
+//       Filename:  allocation.cc
+//
+//    Description:  Defines the allocation kernel. Every person j pays
+//
+//                    share(j,i) = income(j)/(sum of all incomes) * cost(i)
+//
+//                  of expense i, hence everybody pays the same percentage
+//                  of ones income. Expenses with another policy are split
+//                  by the kernels of AllocatePolicies.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 09:20:41 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <array>
+#include <cmath>      // llround
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ledger.h"
+#include "summation.h"
+#include "allocation.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+const std::size_t kPolicies = 4;
+
+// The policies split expense i of cost c among the persons j as
+//
+//   share(j,i) = income(j)*slope(i) + offset(i) + weight(j,i)*scale(i)
+//
+//   income:    slope  = c/(sum of all incomes)
+//   equal:     offset = c/persons
+//   weighted:  scale  = c/(sum of all weights)
+//   fixed:     slope  = (c - sum of all fixed amounts)/(sum of all incomes),
+//              scale  = 1, the weights being the fixed amounts
+//
+// Every policy is a specialization of PolicyKernel, whose Prepare sets the
+// coefficients of one expense. The first two terms of all expenses are
+// then written by one loop per person that the compiler vectorizes, and
+// their totals follow from the sums of slopes and offsets. Only policies
+// with kOwn add the last term, again person by person, so that the
+// shares are written row by row and never down a column.
+template <ExpensePolicy P>
+struct PolicyKernel;
+
+template <>
+struct PolicyKernel<PolicyIncome> {
+  static constexpr bool kOwn = false;
+  static void Prepare (const Expense & e, const double ratio, std::size_t,
+                       double & slope, double & offset, double & scale) {
+    slope  = e.cost*ratio;
+    offset = 0.;
+    scale  = 0.;
+  }
+};  // -----  end of struct PolicyKernel<PolicyIncome>  -----
+
+template <>
+struct PolicyKernel<PolicyEqual> {
+  static constexpr bool kOwn = false;
+  static void Prepare (const Expense & e, double, const std::size_t n,
+                       double & slope, double & offset, double & scale) {
+    slope  = 0.;
+    offset = e.cost/static_cast<double>(n);
+    scale  = 0.;
+  }
+};  // -----  end of struct PolicyKernel<PolicyEqual>  -----
+
+template <>
+struct PolicyKernel<PolicyWeighted> {
+  static constexpr bool kOwn = true;
+  static void Prepare (const Expense & e, double, const std::size_t n,
+                       double & slope, double & offset, double & scale) {
+    const double sumWeights = SumPairwise(e.weights.data(), n);
+    slope  = 0.;
+    offset = 0.;
+    scale  = e.cost/sumWeights;
+  }
+};  // -----  end of struct PolicyKernel<PolicyWeighted>  -----
+
+template <>
+struct PolicyKernel<PolicyFixed> {
+  static constexpr bool kOwn = true;
+  static void Prepare (const Expense & e, const double ratio,
+                       const std::size_t n, double & slope, double & offset,
+                       double & scale) {
+    const double fixed = SumPairwise(e.weights.data(), n);
+    slope  = (e.cost - fixed)*ratio;
+    offset = 0.;
+    scale  = 1.;
+  }
+};  // -----  end of struct PolicyKernel<PolicyFixed>  -----
+
+// the expenses of policy P, as grouped by GroupByPolicy
+template <ExpensePolicy P>
+const uint32_t * GroupBegin (const Allocation & a) {
+  return a.byPolicy.data() + a.policyBegin[P];
+}
+template <ExpensePolicy P>
+const uint32_t * GroupEnd (const Allocation & a) {
+  return a.byPolicy.data() + a.policyBegin[P + 1];
+}
+
+template <ExpensePolicy P>
+void PrepareGroup (const std::vector<Expense> & e, const double ratio,
+                   const std::size_t n, Allocation & a) {
+  for (const uint32_t * i = GroupBegin<P>(a); i != GroupEnd<P>(a); ++i) {
+    PolicyKernel<P>::Prepare(e[*i], ratio, n, a.slopes[*i], a.offsets[*i],
+                             a.scales[*i]);
+  }
+}
+
+template <ExpensePolicy P>
+void AddOwnGroup (const std::vector<Expense> & e, const std::size_t n,
+                  Allocation & a) {
+  const uint32_t * first = GroupBegin<P>(a);
+  const uint32_t * last  = GroupEnd<P>(a);
+  if (!PolicyKernel<P>::kOwn || first == last) {
+    return;
+  }
+  // the weights of the group side by side, so that the loop below reads
+  // them without going through the expenses
+  const std::size_t count = static_cast<std::size_t>(last - first);
+  a.ownWeights.resize(count);
+  a.ownScales.resize(count);
+  for (std::size_t k = 0; k < count; ++k) {
+    a.ownWeights[k] = e[first[k]].weights.data();
+    a.ownScales[k]  = a.scales[first[k]];
+  }
+
+  // the own terms come one at a time and are added to the total of the
+  // rows compensated
+  const std::size_t m = e.size();
+  for (std::size_t j = 0; j < n; ++j) {
+    double *       row = a.shares.data() + j*m;
+    CompensatedSum total;
+    InitCompensatedSum(total);
+    AddCompensated(total, a.totals[j]);
+    for (std::size_t k = 0; k < count; ++k) {
+      const double own = a.ownWeights[k][j]*a.ownScales[k];
+      row[first[k]] += own;
+      AddCompensated(total, own);
+    }
+    a.totals[j] = CompensatedTotal(total);
+  }  // -----  end for  -----
+}
+
+// sorts the ids of the expenses by policy into a.byPolicy, counted into
+// place in the order of the ledger
+void GroupByPolicy (const std::vector<Expense> & e, Allocation & a) {
+  std::vector<std::size_t> & begin = a.policyBegin;
+  begin.assign(kPolicies + 2, 0);
+  for (std::size_t i = 0; i < e.size(); ++i) {
+    ++begin[e[i].policy + 2];
+  }
+  for (std::size_t p = 2; p < kPolicies + 2; ++p) {
+    begin[p] += begin[p - 1];
+  }
+  a.byPolicy.resize(e.size());
+  for (std::size_t i = 0; i < e.size(); ++i) {
+    a.byPolicy[begin[e[i].policy + 1]++] = static_cast<uint32_t>(i);
+  }
+  // begin[p] is now where the expenses of policy p begin
+}
+
+// Splits the expenses ids[0..count) in cents by weights with
+// AllocateCents and writes, or with add adds, the shares into the columns
+// of a.centShares. costs are those of the expenses, in the same order.
+bool SplitCentsGroup (const int64_t * weights, const uint32_t * ids,
+                      const int64_t * costs, const std::size_t count,
+                      const bool add, Allocation & a) {
+  const std::size_t n = a.centIncomes.size();
+  const std::size_t m = a.centCosts.size();
+  if (count == 0) {
+    return true;
+  }
+  if (!AllocateCents(weights, n, costs, count, a.centBlock.data(),
+                     a.centSums.data(), a.centScratch.data())) {
+    return false;
+  }
+  for (std::size_t j = 0; j < n; ++j) {
+    for (std::size_t k = 0; k < count; ++k) {
+      int64_t & share = a.centShares[j*m + ids[k]];
+      share = (add ? share : 0) + a.centBlock[j*count + k];
+    }
+  }
+  return true;
+}
+
+// AllocateCents for ledgers with policies: the income and the equal
+// expenses are split as one group each, the weighted and fixed ones one
+// by one, as each has weights of its own. The fixed amounts are rounded
+// to cents and the rest is split by income.
+bool AllocatePolicyCents (const std::vector<Expense> & e, Allocation & a) {
+  const std::size_t n = a.centIncomes.size();
+  const std::size_t m = e.size();
+
+  GroupByPolicy(e, a);
+  a.centWeights.resize(n);
+  a.centBlock.resize(n*m);
+  a.centSums.resize(n);
+
+  std::vector<int64_t> & costs = a.centGroupCosts;
+  costs.resize(m);
+  for (std::size_t k = 0; k < m; ++k) {
+    costs[k] = a.centCosts[a.byPolicy[k]];
+  }
+
+  const uint32_t * ids = a.byPolicy.data();
+  std::size_t      b   = a.policyBegin[PolicyIncome];
+  std::size_t      end = a.policyBegin[PolicyIncome + 1];
+  if (!SplitCentsGroup(a.centIncomes.data(), ids + b, costs.data() + b,
+                       end - b, false, a)) {
+    return false;
+  }
+
+  b   = a.policyBegin[PolicyEqual];
+  end = a.policyBegin[PolicyEqual + 1];
+  for (std::size_t j = 0; j < n; ++j) {
+    a.centWeights[j] = 1;
+  }
+  if (!SplitCentsGroup(a.centWeights.data(), ids + b, costs.data() + b,
+                       end - b, false, a)) {
+    return false;
+  }
+
+  for (std::size_t k = a.policyBegin[PolicyWeighted];
+       k < a.policyBegin[PolicyWeighted + 1]; ++k) {
+    const Expense & x = e[ids[k]];
+    for (std::size_t j = 0; j < n; ++j) {
+      a.centWeights[j] = ToCents(x.weights[j]);
+    }
+    if (!SplitCentsGroup(a.centWeights.data(), ids + k, costs.data() + k, 1,
+                         false, a)) {
+      return false;
+    }
+  }  // -----  end for  -----
+
+  for (std::size_t k = a.policyBegin[PolicyFixed];
+       k < a.policyBegin[PolicyFixed + 1]; ++k) {
+    const Expense & x = e[ids[k]];
+    for (std::size_t j = 0; j < n; ++j) {
+      a.centWeights[j] = ToCents(x.weights[j]);
+      a.centShares[j*m + ids[k]] = a.centWeights[j];
+      costs[k] -= a.centWeights[j];
+    }
+    if (!SplitCentsGroup(a.centIncomes.data(), ids + k, costs.data() + k, 1,
+                         true, a)) {
+      return false;
+    }
+  }  // -----  end for  -----
+
+  for (std::size_t j = 0; j < n; ++j) {
+    int64_t total = 0;
+    for (std::size_t i = 0; i < m; ++i) {
+      total += a.centShares[j*m + i];
+    }
+    a.centTotals[j] = total;
+  }  // -----  end for  -----
+  return true;
+}
+
+// Households of up to kMaxFixedGroup persons, i.e. nearly all of them,
+// are split by kernels unrolled for their exact size: the weights of the
+// persons live in registers, every cost is read once and written into
+// the N rows of its column, and no loop runs over the persons. The
+// arithmetic is the same as that of the loops over any number of
+// persons, so the shares are bit for bit the same.
+const std::size_t kMaxFixedGroup = 8;
+
+typedef double (*SharesKernel) (const double * incomes, std::size_t nPersons,
+                                const double * costs, std::size_t nExpenses,
+                                double * shares, double * totals);
+typedef double (*SumKernel)    (const double * x, std::size_t n);
+typedef void   (*RowsKernel)   (const double * incomes, std::size_t nPersons,
+                                const double * slopes, const double * offsets,
+                                std::size_t nExpenses, double * shares,
+                                double * totals);
+
+template <std::size_t N>
+double AllocateSharesFixed (const double * incomes, std::size_t,
+                            const double * costs, const std::size_t nExpenses,
+                            double * shares, double * totals) {
+  const double          sumIncomes = SumFixed<N>(incomes, N);
+  const double          sumCosts   = SumPairwise(costs, nExpenses);
+  const double          ratio      = 1./sumIncomes;
+  std::array<double, N> weights;
+#pragma GCC unroll 8
+  for (std::size_t j = 0; j < N; ++j) {
+    weights[j] = incomes[j]*ratio;
+    totals[j]  = weights[j]*sumCosts;
+  }
+
+  for (std::size_t i = 0; i < nExpenses; ++i) {
+    const double cost = costs[i];
+#pragma GCC unroll 8
+    for (std::size_t j = 0; j < N; ++j) {
+      shares[j*nExpenses + i] = weights[j]*cost;
+    }
+  }
+  return ratio;
+}
+
+// the rows of AllocatePolicies, income*slope + offset for every expense
+void WriteRows (const double * incomes, const std::size_t nPersons,
+                const double *__restrict slopes,
+                const double *__restrict offsets, const std::size_t nExpenses,
+                double * shares, double * totals) {
+  const double sumSlopes  = SumPairwise(slopes, nExpenses);
+  const double sumOffsets = SumPairwise(offsets, nExpenses);
+
+  for (std::size_t j = 0; j < nPersons; ++j) {
+    const double       income = incomes[j];
+    double *__restrict row    = shares + j*nExpenses;
+    for (std::size_t i = 0; i < nExpenses; ++i) {
+      row[i] = income*slopes[i] + offsets[i];
+    }
+    totals[j] = income*sumSlopes + sumOffsets;
+  }
+}
+
+template <std::size_t N>
+void WriteRowsFixed (const double * incomes, std::size_t,
+                     const double *__restrict slopes,
+                     const double *__restrict offsets,
+                     const std::size_t nExpenses, double * shares,
+                     double * totals) {
+  const double sumSlopes  = SumPairwise(slopes, nExpenses);
+  const double sumOffsets = SumPairwise(offsets, nExpenses);
+
+  std::array<double, N> own;
+#pragma GCC unroll 8
+  for (std::size_t j = 0; j < N; ++j) {
+    own[j]    = incomes[j];
+    totals[j] = own[j]*sumSlopes + sumOffsets;
+  }
+
+  for (std::size_t i = 0; i < nExpenses; ++i) {
+    const double slope  = slopes[i];
+    const double offset = offsets[i];
+#pragma GCC unroll 8
+    for (std::size_t j = 0; j < N; ++j) {
+      shares[j*nExpenses + i] = own[j]*slope + offset;
+    }
+  }
+}
+
+// by number of persons, the loops over any number where none is unrolled
+const SharesKernel kSharesKernels[kMaxFixedGroup + 1] = {
+  AllocateSharesGeneric,     AllocateSharesGeneric,
+  AllocateSharesFixed<2>,    AllocateSharesFixed<3>,
+  AllocateSharesFixed<4>,    AllocateSharesFixed<5>,
+  AllocateSharesFixed<6>,    AllocateSharesFixed<7>,
+  AllocateSharesFixed<8>,
+};
+
+const SumKernel kIncomeSums[kMaxFixedGroup + 1] = {
+  SumPairwise,               SumPairwise,
+  SumFixed<2>,               SumFixed<3>,
+  SumFixed<4>,               SumFixed<5>,
+  SumFixed<6>,               SumFixed<7>,
+  SumFixed<8>,
+};
+
+const RowsKernel kRowsKernels[kMaxFixedGroup + 1] = {
+  WriteRows,                 WriteRows,
+  WriteRowsFixed<2>,         WriteRowsFixed<3>,
+  WriteRowsFixed<4>,         WriteRowsFixed<5>,
+  WriteRowsFixed<6>,         WriteRowsFixed<7>,
+  WriteRowsFixed<8>,
+};
+
+inline std::size_t KernelIndex (const std::size_t nPersons) {
+  return nPersons <= kMaxFixedGroup ? nPersons : 0;
+}
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  AllocateShares
+//  Description:  Writes the share of each person of each expense into
+//                shares (nPersons x nExpenses, row-major) and the sum of
+//                each row into totals, with the kernel unrolled for
+//                nPersons if there is one, see AllocateSharesFixed, and
+//                with AllocateSharesGeneric otherwise.
+//                Returns the normalisation 1/sum(incomes).
+// =========================================================================
+double AllocateShares (const double * incomes, const std::size_t nPersons,
+                       const double * costs,   const std::size_t nExpenses,
+                       double * shares, double * totals) {
+  return kSharesKernels[KernelIndex(nPersons)](incomes, nPersons, costs,
+                                               nExpenses, shares, totals);
+}  // -----  end of function AllocateShares  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  AllocateSharesGeneric
+//  Description:  AllocateShares for any number of persons. The
+//                normalisation 1/sum(incomes) is computed once; the inner
+//                loop is a plain scaled copy of the costs which the
+//                compiler vectorizes.
+// =========================================================================
+double AllocateSharesGeneric (const double * incomes,
+                              const std::size_t nPersons,
+                              const double * costs,
+                              const std::size_t nExpenses,
+                              double * shares, double * totals) {
+
+  const double sumIncomes = SumPairwise(incomes, nPersons);
+  const double sumCosts   = SumPairwise(costs, nExpenses);
+  const double ratio      = 1./sumIncomes;
+
+  for (std::size_t j = 0; j < nPersons; ++j) {
+    const double     weight = incomes[j]*ratio;
+    double *__restrict row  = shares + j*nExpenses;
+
+    for (std::size_t i = 0; i < nExpenses; ++i) {
+      row[i] = weight*costs[i];
+    }  // -----  end for expenses  -----
+
+    totals[j] = weight*sumCosts;
+  }  // -----  end for persons  -----
+
+  return ratio;
+}  // -----  end of function AllocateSharesGeneric  -----
+
+void Allocate (const std::vector<Person>  & persons,
+               const std::vector<Expense> & expenses,
+               Allocation & a) {
+
+  if (HasPolicies(expenses)) {
+    AllocatePolicies(persons, expenses, a);
+    return;
+  }
+
+  a.incomes.resize(persons.size());
+  a.costs.resize(expenses.size());
+  a.shares.resize(persons.size()*expenses.size());
+  a.totals.resize(persons.size());
+
+  for (std::size_t j = 0; j < persons.size(); ++j) {
+    a.incomes[j] = persons[j].income;
+  }  // -----  end for  -----
+
+  for (std::size_t i = 0; i < expenses.size(); ++i) {
+    a.costs[i] = expenses[i].cost;
+  }  // -----  end for  -----
+  a.sumCosts = SumPairwise(a.costs.data(), a.costs.size());
+
+  a.ratio = AllocateShares(a.incomes.data(), a.incomes.size(),
+                           a.costs.data(),   a.costs.size(),
+                           a.shares.data(),  a.totals.data());
+}  // -----  end of function Allocate  -----
+
+// true if any expense is not split by income
+bool HasPolicies (const std::vector<Expense> & expenses) {
+  for (std::size_t i = 0; i < expenses.size(); ++i) {
+    if (expenses[i].policy != PolicyIncome) {
+      return true;
+    }
+  }
+  return false;
+}  // -----  end of function HasPolicies  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  AllocatePolicies
+//  Description:  Like Allocate, but splits every expense by its policy,
+//                see PolicyKernel. The expenses are grouped by policy
+//                first, so that each kernel runs over its own group
+//                without a branch per cell. The weights have to be valid,
+//                see CheckPolicies.
+// =========================================================================
+void AllocatePolicies (const std::vector<Person>  & persons,
+                       const std::vector<Expense> & expenses,
+                       Allocation & a) {
+
+  const std::size_t n = persons.size();
+  const std::size_t m = expenses.size();
+
+  a.incomes.resize(n);
+  a.costs.resize(m);
+  a.shares.resize(n*m);
+  a.totals.resize(n);
+  a.slopes.resize(m);
+  a.offsets.resize(m);
+  a.scales.resize(m);
+
+  for (std::size_t j = 0; j < n; ++j) {
+    a.incomes[j] = persons[j].income;
+  }  // -----  end for  -----
+  for (std::size_t i = 0; i < m; ++i) {
+    a.costs[i] = expenses[i].cost;
+  }  // -----  end for  -----
+
+  a.sumCosts = SumPairwise(a.costs.data(), m);
+  a.ratio    = 1./kIncomeSums[KernelIndex(n)](a.incomes.data(), n);
+  GroupByPolicy(expenses, a);
+  PrepareGroup<PolicyIncome>  (expenses, a.ratio, n, a);
+  PrepareGroup<PolicyEqual>   (expenses, a.ratio, n, a);
+  PrepareGroup<PolicyWeighted>(expenses, a.ratio, n, a);
+  PrepareGroup<PolicyFixed>   (expenses, a.ratio, n, a);
+
+  kRowsKernels[KernelIndex(n)](a.incomes.data(), n, a.slopes.data(),
+                               a.offsets.data(), m, a.shares.data(),
+                               a.totals.data());
+
+  AddOwnGroup<PolicyIncome>  (expenses, n, a);
+  AddOwnGroup<PolicyEqual>   (expenses, n, a);
+  AddOwnGroup<PolicyWeighted>(expenses, n, a);
+  AddOwnGroup<PolicyFixed>   (expenses, n, a);
+}  // -----  end of function AllocatePolicies  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  CheckPolicies
+//  Description:  Checks that the weights of every weighted and fixed
+//                expense fit the persons and that the weights of a
+//                weighted expense do not add up to zero; with cents,
+//                that they are not negative and add up to a cent at
+//                least. Returns NULL or the reason, as AllocateHousehold.
+// =========================================================================
+const char * CheckPolicies (const std::vector<Person>  & persons,
+                            const std::vector<Expense> & expenses,
+                            const bool cents) {
+
+  for (std::size_t i = 0; i < expenses.size(); ++i) {
+    const Expense & e = expenses[i];
+    if (e.policy != PolicyWeighted && e.policy != PolicyFixed) {
+      continue;
+    }
+    if (e.weights.size() != persons.size()) {
+      return "The weights of an expense do not match the persons.";
+    }
+    if (e.policy == PolicyFixed) {
+      continue;
+    }
+
+    int64_t centSum = 0;
+    for (std::size_t j = 0; j < e.weights.size(); ++j) {
+      if (cents && e.weights[j] < 0.) {
+        return "Splitting in cents needs non negative weights.";
+      }
+      centSum += ToCents(e.weights[j]);
+    }
+    // the sum that PolicyKernel<PolicyWeighted> divides by
+    const double sum = SumPairwise(e.weights.data(), e.weights.size());
+    if (sum <= 0. && sum >= 0.) {
+      return "The weights of an expense add up to zero.";
+    }
+    if (cents && centSum <= 0) {
+      return "Splitting in cents needs weights of at least one cent.";
+    }
+  }  // -----  end for  -----
+  return NULL;
+}  // -----  end of function CheckPolicies  -----
+
+int64_t ToCents (const double amount) {
+  return static_cast<int64_t>(std::llround(100.*amount));
+}  // -----  end of function ToCents  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  AllocateInCents
+//  Description:  Like Allocate, but rounds all amounts to cents and splits
+//                with AllocateCents, by policy as AllocatePolicyCents if
+//                an expense has one. shares, totals and sumCosts hold the
+//                exact cent amounts divided by 100, so that the displayed
+//                shares of every expense add up to its cost.
+// =========================================================================
+bool AllocateInCents (const std::vector<Person>  & persons,
+                      const std::vector<Expense> & expenses,
+                      Allocation & a) {
+
+  const std::size_t n = persons.size();
+  const std::size_t m = expenses.size();
+
+  a.incomes.resize(n);
+  a.costs.resize(m);
+  a.shares.resize(n*m);
+  a.totals.resize(n);
+  a.centIncomes.resize(n);
+  a.centCosts.resize(m);
+  a.centShares.resize(n*m);
+  a.centTotals.resize(n);
+  a.centScratch.resize(AllocateCentsScratch(n));
+
+  for (std::size_t j = 0; j < n; ++j) {
+    a.centIncomes[j] = ToCents(persons[j].income);
+    a.incomes[j]     = static_cast<double>(a.centIncomes[j])/100.;
+  }  // -----  end for  -----
+
+  int64_t sumCosts = 0;
+  for (std::size_t i = 0; i < m; ++i) {
+    a.centCosts[i] = ToCents(expenses[i].cost);
+    a.costs[i]     = static_cast<double>(a.centCosts[i])/100.;
+    sumCosts      += a.centCosts[i];
+  }  // -----  end for  -----
+
+  if (HasPolicies(expenses)) {
+    if (!AllocatePolicyCents(expenses, a)) {
+      return false;
+    }
+  } else if (!AllocateCents(a.centIncomes.data(), n, a.centCosts.data(), m,
+                            a.centShares.data(), a.centTotals.data(),
+                            a.centScratch.data())) {
+    return false;
+  }
+
+  for (std::size_t k = 0; k < n*m; ++k) {
+    a.shares[k] = static_cast<double>(a.centShares[k])/100.;
+  }  // -----  end for  -----
+  for (std::size_t j = 0; j < n; ++j) {
+    a.totals[j] = static_cast<double>(a.centTotals[j])/100.;
+  }  // -----  end for  -----
+
+  a.sumCosts = static_cast<double>(sumCosts)/100.;
+  a.ratio    = 1./SumPairwise(a.incomes.data(), n);
+  return true;
+}  // -----  end of function AllocateInCents  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  AllocateHousehold
+//  Description:  Checks that there are persons, that no income is zero
+//                and that the incomes do not add up to zero, as both
+//                kernels divide by their sum, and the weights of the
+//                policies, see CheckPolicies, and splits the expenses
+//                with Allocate or, with cents, with AllocateInCents.
+//                Returns NULL on success, otherwise the reason why
+//                nothing could be allocated. For callers that must not
+//                exit, e.g. the server and the batch workers.
+// =========================================================================
+const char * AllocateHousehold (const std::vector<Person>  & persons,
+                                const std::vector<Expense> & expenses,
+                                const bool cents, Allocation & a) {
+
+  if (persons.empty()) {
+    return "There is nobody to split the expenses between.";
+  }
+
+  CompensatedSum sum;
+  InitCompensatedSum(sum);
+  for (std::size_t j = 0; j < persons.size(); ++j) {
+    if (persons[j].income <= 0. && persons[j].income >= 0.) {
+      return "Incomes have to be non zero.";
+    }
+    AddCompensated(sum, persons[j].income);
+  }  // -----  end for  -----
+  const double sumIncomes = CompensatedTotal(sum);
+  if (sumIncomes <= 0. && sumIncomes >= 0.) {
+    return "The incomes add up to zero.";
+  }
+
+  const char * error = CheckPolicies(persons, expenses, cents);
+  if (error != NULL) {
+    return error;
+  }
+
+  if (!cents) {
+    Allocate(persons, expenses, a);
+  } else if (!AllocateInCents(persons, expenses, a)) {
+    return "Splitting in cents needs non negative incomes.";
+  }
+  return NULL;
+}  // -----  end of function AllocateHousehold  -----
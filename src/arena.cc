@@ -0,0 +1,122 @@
+//
+// =========================================================================
+//
+//       Filename:  arena.cc
+//
+//    Description:  Defines the resettable arena.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 10:48:21 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arena.h"
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+const std::size_t kArenaBlockBytes = std::size_t(1) << 20;
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+char * AlignUp (char * p, const std::size_t alignment) {
+  const uintptr_t address = reinterpret_cast<uintptr_t>(p);
+  const uintptr_t aligned = (address + alignment - 1) & ~(alignment - 1);
+  return p + (aligned - address);
+}
+
+void UseBlock (Arena & a, const std::size_t block) {
+  a.block = block;
+  a.cur   = a.blocks[block].data.get();
+  a.end   = a.cur + a.blocks[block].size;
+}
+
+// Moves on to the next block that has room for size bytes at alignment,
+// allocating one if there is none. Oversized requests get a block of
+// their own in front of the blocks not yet used.
+void NextBlock (Arena & a, const std::size_t size, const std::size_t alignment) {
+  const std::size_t needed = size + alignment - 1;
+
+  std::size_t next = a.blocks.empty() ? 0 : a.block + 1;
+  while (next < a.blocks.size() && a.blocks[next].size < needed
+         && a.blocks[next].size == a.blockSize) {
+    ++next; // a normal block too small for an oversized request
+  }
+  if (next < a.blocks.size() && a.blocks[next].size >= needed) {
+    UseBlock(a, next);
+    return;
+  }
+
+  ArenaBlock b;
+  b.size = needed > a.blockSize ? needed : a.blockSize;
+  b.data.reset(new char[b.size]);
+  a.blocks.insert(a.blocks.begin() + static_cast<std::ptrdiff_t>(next),
+                  std::move(b));
+  UseBlock(a, next);
+}
+}  // -----  end of namespace  -----
+
+void InitArena (Arena & a, const std::size_t blockSize) {
+  a.blocks.clear();
+  a.blockSize = blockSize;
+  a.block     = 0;
+  a.cur       = NULL;
+  a.end       = NULL;
+  a.used      = 0;
+}   // -----  end of function InitArena  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ArenaAllocate
+//  Description:  Returns size bytes at a multiple of alignment, a power
+//                of two. They stay valid until the arena is reset.
+// =========================================================================
+void * ArenaAllocate (Arena & a, const std::size_t size,
+                      const std::size_t alignment) {
+  char * p = a.cur == NULL ? NULL : AlignUp(a.cur, alignment);
+  if (p == NULL || static_cast<std::size_t>(a.end - p) < size) {
+    NextBlock(a, size, alignment);
+    p = AlignUp(a.cur, alignment);
+  }
+  a.cur   = p + size;
+  a.used += size;
+  return p;
+}   // -----  end of function ArenaAllocate  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ResetArena
+//  Description:  Gives back everything allocated in O(1); the blocks are
+//                kept for the next allocations.
+// =========================================================================
+void ResetArena (Arena & a) {
+  a.used = 0;
+  if (a.blocks.empty()) {
+    return;
+  }
+  UseBlock(a, 0);
+}   // -----  end of function ResetArena  -----
+
+void ReleaseArena (Arena & a) {
+  InitArena(a, a.blockSize);
+  std::vector<ArenaBlock>().swap(a.blocks);
+}   // -----  end of function ReleaseArena  -----
+
+std::size_t ArenaCapacity (const Arena & a) {
+  std::size_t capacity = 0;
+  for (std::size_t k = 0; k < a.blocks.size(); ++k) {
+    capacity += a.blocks[k].size;
+  }
+  return capacity;
+}   // -----  end of function ArenaCapacity  -----
@@ -0,0 +1,640 @@
+//
+// =========================================================================
+//
+//       Filename:  batch-executor.cc
+//
+//    Description:  Runs a batch file on several threads. The file is
+//                  processed in windows of a few hundred kilobytes per
+//                  thread:
+//
+//                  1. SplitHouseholds finds where the households start,
+//                     looking only at section headers.
+//                  2. The households of the window are grouped into
+//                     chunks of about kChunkBytes. The workers parse,
+//                     allocate and format whole chunks into per chunk
+//                     buffers. Every worker starts on its own contiguous
+//                     range of chunks and, when it runs dry, steals the
+//                     back half of the range of another worker, so a few
+//                     households with hundreds of members do not leave
+//                     the other cores idle.
+//                  3. The calling thread writes the chunk buffers in
+//                     input order while the workers run on the next
+//                     window.
+//
+//                  The output, including where the output stops and
+//                  which error is reported, is the same as reading the
+//                  households one by one with ParseHousehold. With a
+//                  reject log, a bad household is skipped instead: its
+//                  errors are collected by the worker and the calling
+//                  thread copies it to the log in input order.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 08:45:09 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <algorithm>           // count
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>             // memchr
+#include <memory>              // unique_ptr
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "ini-parser.h"
+#include "time-series.h"
+#include "output-writer.h"
+#include "batch-executor.h"
+#include "validation.h"
+#include "stats.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+const std::size_t kChunkBytes      = 1 << 14;  // of text per chunk
+const std::size_t kChunksPerThread = 16;       // per window
+// A series household writes a row per period for every amount of its
+// lists, so a byte of it makes about that many times more output than a
+// byte of settings.ini. Its chunks are smaller by this factor to keep
+// the chunk buffers of a window at the same size.
+const std::size_t kSeriesExpansion = 16;
+
+enum ChunkStatus : unsigned short {
+  ChunkDone,
+  ChunkEnded,            // an empty household ends the batch
+  ChunkParseError,
+  ChunkAllocationError,
+};        // ----------  end of enum ChunkStatus  ----------
+
+struct batch_chunk {
+  std::size_t  firstSpan;        // in the spans of the window
+  std::size_t  endSpan;
+  ChunkStatus  status;
+  std::size_t  lastSpan;         // the span that ended or failed
+  IniError     parseError;       // line counted from the span
+  const char * allocationError;
+  std::string  output;
+  // with job.rejects, the errors of the skipped households, lines
+  // counted from their span
+  std::vector<RecordError> rejects;
+};  // -----  end of struct batch_chunk  -----
+
+typedef struct batch_chunk BatchChunk;
+
+struct batch_window {
+  uint64_t                   households;  // before the first span
+  std::vector<HouseholdSpan> spans;
+  std::vector<BatchChunk>    chunks;      // reused, only nChunks in use
+  std::size_t                nChunks;
+  // per worker the chunks [begin, end) it has left, as begin << 32 | end
+  std::unique_ptr<std::atomic<uint64_t>[]> ranges;
+  unsigned                   finished;    // workers done, under the mutex
+};  // -----  end of struct batch_window  -----
+
+typedef struct batch_window BatchWindow;
+
+struct worker_context {
+  IniScanner   scanner;
+  Household    household;
+  Allocation   allocation;
+  TimeSeries   series;
+  SeriesState  state;
+  OutputWriter writer;
+};  // -----  end of struct worker_context  -----
+
+typedef struct worker_context WorkerContext;
+
+struct worker_pool {
+  const BatchJob *           job;
+  unsigned                   threads;
+  std::vector<WorkerContext> contexts;
+  std::vector<std::thread>   workers;
+  std::mutex                 mutex;
+  std::condition_variable    started;
+  std::condition_variable    done;
+  BatchWindow *              window;      // under the mutex
+  uint64_t                   generation;  // under the mutex
+  bool                       stop;        // under the mutex
+};  // -----  end of struct worker_pool  -----
+
+typedef struct worker_pool WorkerPool;
+
+// the number of lines before offset of the text, counted forward from the
+// last offset asked for
+struct line_cursor {
+  std::size_t offset;
+  std::size_t lines;
+};  // -----  end of struct line_cursor  -----
+
+typedef struct line_cursor LineCursor;
+
+bool IsBlank (const char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+uint64_t PackRange (const uint64_t begin, const uint64_t end) {
+  return begin << 32 | end;
+}
+
+// takes the first chunk of the own range
+bool PopChunk (std::atomic<uint64_t> & range, std::size_t & chunk) {
+  uint64_t r = range.load(std::memory_order_acquire);
+  for (;;) {
+    const uint64_t begin = r >> 32;
+    const uint64_t end   = r & 0xffffffffu;
+    if (begin >= end) {
+      return false;
+    }
+    if (range.compare_exchange_weak(r, PackRange(begin + 1, end),
+                                    std::memory_order_acq_rel)) {
+      chunk = static_cast<std::size_t>(begin);
+      return true;
+    }
+  }  // -----  end for  -----
+}
+
+// moves the back half of the range of victim to the own, empty range
+bool StealChunks (std::atomic<uint64_t> & victim, std::atomic<uint64_t> & own) {
+  uint64_t r = victim.load(std::memory_order_acquire);
+  for (;;) {
+    const uint64_t begin = r >> 32;
+    const uint64_t end   = r & 0xffffffffu;
+    if (begin >= end) {
+      return false;
+    }
+    const uint64_t middle = end - (end - begin + 1)/2;
+    if (victim.compare_exchange_weak(r, PackRange(begin, middle),
+                                     std::memory_order_acq_rel)) {
+      own.store(PackRange(middle, end), std::memory_order_release);
+      return true;
+    }
+  }  // -----  end for  -----
+}
+
+// the error of the parser as the error of a record, the key only if it
+// is on the line of the error
+void AddParseReject (const IniScanner & s, const uint64_t record,
+                     BatchChunk & chunk) {
+  RecordError e;
+  e.record  = record;
+  e.line    = s.error.line;
+  e.column  = s.error.column;
+  e.section = std::string(s.section);
+  e.key     = s.key.data() >= s.lineBegin ? std::string(s.key) : std::string();
+  e.reason  = s.error.message;
+  chunk.rejects.push_back(e);
+}
+
+// parses, allocates and writes the household c.scanner is set to
+ChunkStatus ProcessHousehold (const BatchJob & job, WorkerContext & c,
+                              const uint64_t record, BatchChunk & chunk) {
+  PhaseTimer timer(PhaseHousehold);
+
+  // every span but the first starts with the [person] section that
+  // ends the previous household
+  bool pendingPerson = false;
+  if (ParseHousehold(c.scanner, c.household, false, pendingPerson)
+      == IniSyntaxError) {
+    if (job.rejects != NULL) {
+      AddParseReject(c.scanner, record, chunk);
+      ++c.writer.households;
+      return ChunkDone;
+    }
+    chunk.parseError = c.scanner.error;
+    return ChunkParseError;
+  }
+  CountStat(CounterRecords,
+            c.household.persons.size() + c.household.expenses.size());
+  if (c.household.persons.empty() && c.household.expenses.empty()) {
+    return ChunkEnded;
+  }
+
+  const char * error = AllocateHousehold(c.household.persons,
+                                         c.household.expenses, job.cents,
+                                         c.allocation);
+  if (error != NULL) {
+    if (job.rejects != NULL) {
+      DescribeAllocationError(c.household.persons, record, error,
+                              chunk.rejects);
+      ++c.writer.households;
+      return ChunkDone;
+    }
+    chunk.allocationError = error;
+    return ChunkAllocationError;
+  }
+  WriteHousehold(c.writer, c.household.persons, c.household.expenses,
+                 c.allocation);
+  return ChunkDone;
+}
+
+// the same for a series household, written period by period
+ChunkStatus ProcessSeries (const BatchJob & job, WorkerContext & c,
+                           const uint64_t record, BatchChunk & chunk) {
+  PhaseTimer timer(PhaseHousehold);
+
+  bool pendingPerson = false;
+  if (ParseSeriesHousehold(c.scanner, c.series, false, pendingPerson)
+      == IniSyntaxError) {
+    if (job.rejects != NULL) {
+      AddParseReject(c.scanner, record, chunk);
+      ++c.writer.households;
+      return ChunkDone;
+    }
+    chunk.parseError = c.scanner.error;
+    return ChunkParseError;
+  }
+  CountStat(CounterRecords,
+            c.series.personNames.size() + c.series.expenseNames.size());
+  if (c.series.personNames.empty() && c.series.expenseNames.empty()) {
+    return ChunkEnded;
+  }
+
+  const char * error = StartSeries(c.series, job.cents, c.state);
+  if (error != NULL) {
+    if (job.rejects != NULL) {
+      RecordError e;
+      e.record = record;
+      e.line   = 0;
+      e.column = 0;
+      e.reason = error;
+      chunk.rejects.push_back(e);
+      ++c.writer.households;
+      return ChunkDone;
+    }
+    chunk.allocationError = error;
+    return ChunkAllocationError;
+  }
+  StartSeriesHousehold(c.writer, c.series);
+  while (c.state.period < c.series.periods) {
+    NextPeriod(c.series, c.state);
+    WriteSeriesPeriod(c.writer, c.series, c.state);
+  }
+  FinishSeriesHousehold(c.writer, c.series, c.state);
+  return ChunkDone;
+}
+
+void ProcessChunk (const BatchJob & job, WorkerContext & c,
+                   const BatchWindow & window, BatchChunk & chunk) {
+  StartOutputChunk(c.writer, job.format, true,
+                   window.households + chunk.firstSpan);
+  chunk.status = ChunkDone;
+  chunk.rejects.clear();
+
+  for (std::size_t k = chunk.firstSpan; k < chunk.endSpan; ++k) {
+    const HouseholdSpan & span   = window.spans[k];
+    const uint64_t        record = window.households + k + 1;
+    InitIniScanner(c.scanner, job.text.substr(span.begin, span.end - span.begin));
+
+    chunk.status = job.series ? ProcessSeries(job, c, record, chunk)
+                              : ProcessHousehold(job, c, record, chunk);
+    if (chunk.status != ChunkDone) {
+      chunk.lastSpan = k;
+      break;
+    }
+  }  // -----  end for  -----
+
+  chunk.output.swap(c.writer.buffer);
+}
+
+void Work (WorkerPool & pool, BatchWindow & window, const unsigned t) {
+  WorkerContext & context = pool.contexts[t];
+  std::size_t     chunk   = 0;
+
+  for (;;) {
+    if (PopChunk(window.ranges[t], chunk)) {
+      ProcessChunk(*pool.job, context, window, window.chunks[chunk]);
+      continue;
+    }
+    bool stolen = false;
+    for (unsigned k = 1; k < pool.threads && !stolen; ++k) {
+      stolen = StealChunks(window.ranges[(t + k) % pool.threads],
+                           window.ranges[t]);
+    }
+    if (!stolen) {
+      return; // every chunk is taken
+    }
+  }  // -----  end for  -----
+}
+
+void RunWorker (WorkerPool & pool, const unsigned t) {
+  uint64_t seen = 0;
+  for (;;) {
+    BatchWindow * window = NULL;
+    {
+      std::unique_lock<std::mutex> lock(pool.mutex);
+      pool.started.wait(lock, [&]() {
+        return pool.stop || pool.generation != seen;
+      });
+      if (pool.stop) {
+        MergeThreadStats();
+        return;
+      }
+      seen   = pool.generation;
+      window = pool.window;
+    }
+
+    Work(pool, *window, t);
+
+    {
+      std::lock_guard<std::mutex> lock(pool.mutex);
+      ++window->finished;
+    }
+    pool.done.notify_one();
+  }  // -----  end for  -----
+}
+
+// Splits the next window off the text and groups it into chunks.
+void PrepareWindow (const BatchJob & job, const unsigned threads,
+                    std::size_t & position, const uint64_t households,
+                    BatchWindow & w) {
+  const std::size_t chunkBytes = job.series ? kChunkBytes/kSeriesExpansion
+                                            : kChunkBytes;
+  w.households = households;
+  w.spans.clear();
+  SplitHouseholds(job.text, position, threads*kChunksPerThread*chunkBytes,
+                  w.spans);
+
+  w.nChunks = 0;
+  for (std::size_t k = 0; k < w.spans.size(); ) {
+    if (w.chunks.size() == w.nChunks) {
+      w.chunks.push_back(BatchChunk());
+    }
+    BatchChunk & chunk = w.chunks[w.nChunks++];
+    chunk.firstSpan = k;
+    const std::size_t begin = w.spans[k].begin;
+    while (k < w.spans.size() && w.spans[k].begin - begin < chunkBytes) {
+      ++k;
+    }
+    chunk.endSpan = k;
+  }  // -----  end for  -----
+
+  for (unsigned t = 0; t < threads; ++t) {
+    w.ranges[t].store(PackRange(t*w.nChunks/threads, (t + 1)*w.nChunks/threads),
+                      std::memory_order_relaxed);
+  }
+  w.finished = 0;
+}
+
+void Launch (WorkerPool & pool, BatchWindow & window) {
+  {
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    pool.window = &window;
+    ++pool.generation;
+  }
+  pool.started.notify_all();
+}
+
+// helps with the window and waits for all other workers to leave it
+void Finish (WorkerPool & pool, BatchWindow & window) {
+  Work(pool, window, 0);
+  std::unique_lock<std::mutex> lock(pool.mutex);
+  pool.done.wait(lock, [&]() { return window.finished + 1 == pool.threads; });
+}
+
+// Writes the chunks of w in order. Returns false once the batch ended,
+// then error is empty or says why it failed.
+// Copies the households chunk skipped to the reject log, each with its
+// errors, their lines counted from the start of the text.
+void WriteRejects (const BatchJob & job, const BatchWindow & w,
+                   BatchChunk & chunk, LineCursor & cursor) {
+  const char * text = job.text.data();
+  for (std::size_t k = 0; k < chunk.rejects.size(); ) {
+    const uint64_t        record = chunk.rejects[k].record;
+    const HouseholdSpan & span   = w.spans[record - 1 - w.households];
+    cursor.lines += static_cast<std::size_t>(std::count(
+      text + cursor.offset, text + span.begin, '\n'));
+    cursor.offset = span.begin;
+
+    std::size_t end = k;
+    for (; end < chunk.rejects.size() && chunk.rejects[end].record == record;
+         ++end) {
+      if (chunk.rejects[end].line > 0) {
+        chunk.rejects[end].line += cursor.lines;
+      }
+    }
+    RejectRecord(*job.rejects, &chunk.rejects[k], end - k,
+                 job.text.substr(span.begin, span.end - span.begin));
+    k = end;
+  }  // -----  end for  -----
+}
+
+bool Merge (const BatchJob & job, BatchWindow & w, OutputWriter & writer,
+            LineCursor & cursor, uint64_t & households, std::string & error) {
+  for (std::size_t c = 0; c < w.nChunks; ++c) {
+    BatchChunk & chunk = w.chunks[c];
+    WriteOutputChunk(writer, chunk.output);
+    if (!chunk.rejects.empty()) {
+      WriteRejects(job, w, chunk, cursor);
+    }
+
+    if (chunk.status == ChunkDone) {
+      households = w.households + chunk.endSpan;
+      continue;
+    }
+    households = w.households + chunk.lastSpan;
+
+    if (chunk.status == ChunkParseError) {
+      const char * text = job.text.data();
+      const std::size_t linesBefore = static_cast<std::size_t>(std::count(
+        text, text + w.spans[chunk.lastSpan].begin, '\n'));
+      std::ostringstream message;
+      message << job.fileName << ":" << linesBefore + chunk.parseError.line
+        << ":" << chunk.parseError.column << ": " << chunk.parseError.message;
+      error = message.str();
+    } else if (chunk.status == ChunkAllocationError) {
+      error = chunk.allocationError;
+    }
+    return false;
+  }  // -----  end for  -----
+  return true;
+}
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  SplitHouseholds
+//  Description:  Appends the households of text from position on to
+//                spans, until they cover at least maxBytes or the text
+//                ends, and moves position behind the last one. Returns
+//                the number of spans appended.
+//
+//                As in ParseHousehold, a household ends with the first
+//                [person...] section after its [expenses] section. Only
+//                lines starting with '[' are looked at, found with
+//                memchr; the rest of the text is left to the parser,
+//                which also reports malformed headers.
+// =========================================================================
+std::size_t SplitHouseholds (const std::string_view text,
+                             std::size_t & position,
+                             const std::size_t maxBytes,
+                             std::vector<HouseholdSpan> & spans) {
+
+  const char * const first = text.data();
+  const char * const last  = first + text.size();
+  const std::size_t  count = spans.size();
+
+  const char * begin        = first + position;
+  const char * p            = begin;
+  bool         seenExpenses = false;
+
+  while (p < last && (p = static_cast<const char *>(
+           std::memchr(p, '[', static_cast<std::size_t>(last - p)))) != NULL) {
+
+    // a section header has only blanks in front of it
+    const char * lineBegin = p;
+    while (lineBegin > first && IsBlank(lineBegin[-1])) {
+      --lineBegin;
+    }
+    const char * lineEnd = static_cast<const char *>(
+      std::memchr(p, '\n', static_cast<std::size_t>(last - p)));
+    if (lineEnd == NULL) {
+      lineEnd = last;
+    }
+    if (lineBegin > first && lineBegin[-1] != '\n') {
+      p = lineEnd;
+      continue;
+    }
+
+    const char * close = static_cast<const char *>(
+      std::memchr(p, ']', static_cast<std::size_t>(lineEnd - p)));
+    if (close != NULL) {
+      const char * nameBegin = p + 1;
+      const char * nameEnd   = close;
+      while (nameBegin < nameEnd && IsBlank(*nameBegin)) {
+        ++nameBegin;
+      }
+      while (nameEnd > nameBegin && IsBlank(nameEnd[-1])) {
+        --nameEnd;
+      }
+      const std::string_view name(nameBegin,
+                                  static_cast<std::size_t>(nameEnd - nameBegin));
+
+      if (IsPersonSection(name) && seenExpenses) {
+        HouseholdSpan span = { static_cast<std::size_t>(begin - first),
+                               static_cast<std::size_t>(lineBegin - first) };
+        spans.push_back(span);
+        begin        = lineBegin;
+        seenExpenses = false;
+        if (static_cast<std::size_t>(begin - (first + position)) >= maxBytes) {
+          position = static_cast<std::size_t>(begin - first);
+          return spans.size() - count;
+        }
+      } else if (name == "expenses") {
+        seenExpenses = true;
+      }
+    }  // -----  end if  -----
+    p = lineEnd;
+  }  // -----  end while  -----
+
+  if (begin < last) {
+    HouseholdSpan span = { static_cast<std::size_t>(begin - first),
+                           text.size() };
+    spans.push_back(span);
+  }
+  position = text.size();
+  return spans.size() - count;
+}   // -----  end of function SplitHouseholds  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  RunBatchJob
+//  Description:  Writes the results of all households of job.text to os
+//                using job.threads threads. Returns false if a household
+//                could not be parsed or allocated; the results of the
+//                households before it are written, error holds the
+//                message. With job.rejects such households are skipped
+//                and copied to the reject log instead, which the caller
+//                finishes. households is set to the number of households
+//                read, including the skipped ones.
+// =========================================================================
+bool RunBatchJob (const BatchJob & job, std::ostream & os,
+                  uint64_t & households, std::string & error) {
+
+  const unsigned threads = job.threads > 0 ? job.threads : 1;
+
+  WorkerPool pool;
+  pool.job        = &job;
+  pool.threads    = threads;
+  pool.window     = NULL;
+  pool.generation = 0;
+  pool.stop       = false;
+  pool.contexts.resize(threads);
+
+  BatchWindow windows[2];
+  for (std::size_t k = 0; k < 2; ++k) {
+    windows[k].ranges.reset(new std::atomic<uint64_t>[threads]);
+  }
+  for (unsigned t = 1; t < threads; ++t) {
+    pool.workers.push_back(std::thread(RunWorker, std::ref(pool), t));
+  }
+
+  OutputWriter writer;
+  if (job.series) {
+    InitSeriesWriter(writer, os, job.format);
+  } else {
+    InitOutputWriter(writer, os, job.format, true);
+  }
+
+  std::size_t position = 0;
+  LineCursor  cursor   = { 0, 0 };
+  households = 0;
+  error.clear();
+
+  PrepareWindow(job, threads, position, 0, windows[0]);
+  Launch(pool, windows[0]);
+
+  bool ok = true;
+  for (std::size_t cur = 0; ; cur = 1 - cur) {
+    BatchWindow & current = windows[cur];
+    BatchWindow & next    = windows[1 - cur];
+
+    // split the next window while the workers are busy
+    const bool more = position < job.text.size();
+    if (more) {
+      PrepareWindow(job, threads, position,
+                    current.households + current.spans.size(), next);
+    }
+
+    Finish(pool, current);
+    if (more) {
+      Launch(pool, next);
+    }
+
+    {
+      PhaseTimer timer(PhaseOutput);
+      ok = Merge(job, current, writer, cursor, households, error);
+    }
+    if (!ok || !more) {
+      if (more) {
+        Finish(pool, next);
+      }
+      break;
+    }
+  }  // -----  end for  -----
+
+  {
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    pool.stop = true;
+  }
+  pool.started.notify_all();
+  for (std::size_t k = 0; k < pool.workers.size(); ++k) {
+    pool.workers[k].join();
+  }
+
+  FinishOutputWriter(writer);
+  return error.empty();
+}   // -----  end of function RunBatchJob  -----
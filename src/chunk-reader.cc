@@ -0,0 +1,183 @@
+//
+// =========================================================================
+//
+//       Filename:  chunk-reader.cc
+//
+//    Description:  Defines the chunked reader of large text files, see
+//                  chunk-reader.h, and the scans of lines and comment
+//                  lines on its chunks.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 10:14:03 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>      // memchr, memmove
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>      // open, posix_fadvise
+#include <unistd.h>     // read, close
+
+#include "stats.h"
+#include "chunk-reader.h"
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+// large enough that a read costs little next to scanning it, small
+// enough to stay in the L2 cache
+const std::size_t kChunkReaderBytes = 1 << 20;
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+// the bytes counted into one byte wide counters before they are added up
+const std::size_t kCountBlock = 255;
+
+// the blanks skipped by operator>>
+inline bool IsSpace (const char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v'
+         || c == '\f';
+}
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  OpenChunkReader
+//  Description:  Opens fileName to be read in chunks of capacity bytes.
+//                If endWithNewline is set, a newline is added after a
+//                last line without one, so that scanners only ever see
+//                complete lines. Returns false and leaves errno set if
+//                the file can not be opened.
+// =========================================================================
+bool OpenChunkReader (const std::string & fileName, const std::size_t capacity,
+                      const bool endWithNewline, ChunkReader & r) {
+  r.fd = open(fileName.c_str(), O_RDONLY);
+  if (r.fd < 0) {
+    return false;
+  }
+  posix_fadvise(r.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+  r.buffer.resize(capacity + 1);
+  r.capacity       = capacity;
+  r.begin          = 0;
+  r.end            = 0;
+  r.bytesRead      = 0;
+  r.atEnd          = false;
+  r.endWithNewline = endWithNewline;
+  return true;
+}   // -----  end of function OpenChunkReader  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  FillChunk
+//  Description:  Moves the bytes not consumed to the front of the buffer
+//                and reads until it is full or the file ends, which sets
+//                atEnd. Returns false and leaves errno set if the file
+//                can not be read.
+// =========================================================================
+bool FillChunk (ChunkReader & r) {
+  char * buffer = r.buffer.data();
+  if (r.begin > 0) {
+    std::memmove(buffer, buffer + r.begin, r.end - r.begin);
+    r.end  -= r.begin;
+    r.begin = 0;
+  }
+
+  while (!r.atEnd && r.end < r.capacity) {
+    const ssize_t n = read(r.fd, buffer + r.end, r.capacity - r.end);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    CountStat(CounterBytesRead, static_cast<uint64_t>(n));
+    r.end       += static_cast<std::size_t>(n);
+    r.bytesRead += static_cast<uint64_t>(n);
+    if (n == 0) {
+      r.atEnd = true;
+      if (r.endWithNewline && r.end > 0 && buffer[r.end - 1] != '\n') {
+        buffer[r.end++] = '\n';
+      }
+    }
+  }  // -----  end while  -----
+  return true;
+}   // -----  end of function FillChunk  -----
+
+void CloseChunkReader (ChunkReader & r) {
+  if (r.fd >= 0) {
+    close(r.fd);
+  }
+  r.fd = -1;
+}   // -----  end of function CloseChunkReader  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  CountNewlines
+//  Description:  Returns the number of newlines in text. The bytes are
+//                compared in blocks of 255 into one byte counters, so
+//                that the loop vectorizes to a compare and a subtract
+//                per 16 bytes.
+// =========================================================================
+std::size_t CountNewlines (const std::string_view text) {
+  const unsigned char * p     = reinterpret_cast<const unsigned char *>(
+                                  text.data());
+  std::size_t           n     = text.size();
+  std::size_t           count = 0;
+  while (n > 0) {
+    const std::size_t block = n < kCountBlock ? n : kCountBlock;
+    unsigned char     found = 0;
+    for (std::size_t k = 0; k < block; ++k) {
+      found = static_cast<unsigned char>(found + (p[k] == '\n'));
+    }
+    count += found;
+    p     += block;
+    n     -= block;
+  }  // -----  end while  -----
+  return count;
+}   // -----  end of function CountNewlines  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  CountCommentLines
+//  Description:  Adds the comment lines at the start of text to count, as
+//                CountCommentLinesOfStream: blanks and empty lines are
+//                skipped, and a line whose first word starts with '#' or
+//                '/' is a comment. Returns true once a line that is no
+//                comment is found; otherwise consumed is set to the bytes
+//                of the lines counted, and the rest needs more text.
+// =========================================================================
+bool CountCommentLines (const std::string_view text, int & count,
+                        std::size_t & consumed) {
+  const char * begin = text.data();
+  const char * end   = begin + text.size();
+  const char * p     = begin;
+  for (;;) {
+    while (p < end && IsSpace(*p)) {
+      ++p;
+    }
+    consumed = static_cast<std::size_t>(p - begin);
+    if (p == end) {
+      return false;
+    }
+    if (*p != '#' && *p != '/') {
+      return true;
+    }
+    const char * eol = static_cast<const char *>(
+      std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+    if (eol == NULL) {
+      return false;
+    }
+    ++count;
+    p = eol + 1;
+  }  // -----  end for  -----
+}   // -----  end of function CountCommentLines  -----
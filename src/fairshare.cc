@@ -32,7 +32,6 @@
 //
 //           TODO:  
 //                  - create settings file from user input
-//                  - extent to use with arbitrary number of individuals
 // =========================================================================
 
 //--------------------------------------------------------------------------
@@ -40,19 +39,37 @@
 //--------------------------------------------------------------------------
 // {{{
 // standard libraries
+#include <charconv>   // from_chars
 #include <iomanip>    // i/o stream manipulatonen, e.g. setprecision
 #include <iostream>   // input/output streams, e.g. std::cout and cin
 #include <fstream>    // filestreams to read and write data to files
 #include <string>     // string handling
 #include <stdexcept>  // for exception handling, e.g. std::out_of_range
+#include <cerrno>     // errno
+#include <cstring>    // strerror
 #include <sys/stat.h> // shell instructions 
+#include <thread>     // hardware_concurrency
 
 // external libraries
 #include <boost/program_options.hpp>     // allows to set program options
-#include <boost/property_tree/ptree.hpp> // parse ini files
-#include <boost/property_tree/ini_parser.hpp>
 
 // files
+#include "ledger.h"
+#include "allocation.h"
+#include "ini-parser.h"
+#include "household-reader.h"
+#include "ledger-cache.h"
+#include "table-renderer.h"
+#include "output-writer.h"
+#include "server.h"
+#include "batch-executor.h"
+#include "group-tree.h"
+#include "settlement.h"
+#include "summation.h"
+#include "sweep.h"
+#include "transactions.h"
+#include "stats.h"
+#include "validation.h"
 #include "fairshare.h"
 #include "helper-functions.h"
 #include "global-constants.h"
@@ -63,44 +80,97 @@
 //--------------------------------------------------------------------------
 std::vector<Person> persons;
 std::vector<Expense> expenses;
-
-// =========================================================================
-//   Main
-// =========================================================================
-int main(int argc, char *argv[]) {
-
-//  if (IniFileExists(kIniFileName)) {
-//    ParseIniFile(kIniFileName);
-//  } else {
-//    CreateIniFile(kIniFileName);
-//  }  // -----  end if-else  ----- 
-
-  ParseIniFile(kIniFileName);
-  GetArgsToMain(argc, argv);
-
-  CheckIncomeIsNonZeroOrExit(persons);
-  
-  DisplayResults(persons,expenses);
-
-  return EXIT_SUCCESS;
-}
+Options options;
 
 //--------------------------------------------------------------------------
 //  function definitions
 //--------------------------------------------------------------------------
 void GetArgsToMain(int ac, char *av[]) {
   namespace po = boost::program_options; // just for convenience
+  PhaseTimer timer(PhaseArguments);
   try {
+    std::vector<std::string> incomes;
+    std::string              format;
+
     // define and parse program options
     po::options_description opts("\033[1mOPTIONS\033[0m");
     opts.add_options()
       ("help,h", "produce help message")
       ("income1,1",
-       po::value<double>(&persons[0].income ),
+       po::value<double>(),
        "sets first income") 
       ("income2,2",
-       po::value<double>(&persons[1].income ),
+       po::value<double>(),
        "sets second income") 
+      ("income,i",
+       po::value<std::vector<std::string> >(&incomes)->composing(),
+       "sets income of the n-th person, given as n:income") 
+      ("cents,c",
+       po::bool_switch(&options.cents),
+       "splits every expense in whole cents, such that the shares "
+       "add up to the cost exactly") 
+      ("batch,b",
+       po::value<std::string>(&options.batchFileName),
+       "reads many households from the given file, each in the "
+       "format of settings.ini, and displays the results of all") 
+      ("series,t",
+       po::value<std::string>(&options.seriesFileName),
+       "reads households whose incomes and costs have one amount per "
+       "period and displays the shares of every period and their "
+       "running totals, see the README for the format") 
+      ("tree",
+       po::value<std::string>(&options.treeFileName),
+       "reads a tree of groups, e.g. buildings and households, each "
+       "with its own expenses, and displays what every group and person "
+       "pays, see the README for the format") 
+      ("settle",
+       po::value<std::string>(&options.settleFileName),
+       "reads the payments the persons of settings.ini actually made "
+       "from the given file and displays who has to pay whom to even "
+       "out the balances, see the README for the format") 
+      ("exact",
+       po::bool_switch(&options.exact),
+       "with --settle, finds the fewest transfers for groups of up to "
+       "20 persons with a balance") 
+      ("rejects",
+       po::value<std::string>(&options.rejectFileName),
+       "with --batch or --series, skips households that can not be "
+       "parsed or split and copies them to the given file, each after "
+       "a comment with its errors") 
+      ("sweep",
+       po::value<std::vector<std::string> >(&options.sweeps)->composing(),
+       "runs the income of person n or the cost of an expense over a "
+       "range, given as n=start:stop:step or name=start:stop:step; "
+       "several sweeps span a grid of scenarios") 
+      ("transactions",
+       po::value<std::string>(&options.transactionFileName),
+       "sets the expenses from a CSV export of bank transactions, "
+       "added up per expense by the rules of --rules") 
+      ("rules",
+       po::value<std::string>(&options.rulesFileName),
+       "reads the columns of the export of --transactions and the "
+       "rules that map its descriptions to expenses, see the README "
+       "for the format") 
+      ("output-format,o",
+       po::value<std::string>(&format)->default_value("table"),
+       "writes the results as table, csv, ndjson or binary") 
+      ("no-cache",
+       po::bool_switch(&options.noCache),
+       "parses settings.ini every time; otherwise it is cached in "
+       "settings.ini.cache next to it, rewritten whenever settings.ini "
+       "changed, and this option neither reads nor writes that file") 
+      ("jobs,j",
+       po::value<unsigned>(&options.jobs)->default_value(0),
+       "number of threads for --batch, 0 for one per core") 
+      ("serve,s",
+       po::value<std::string>(&options.socketPath),
+       "keeps settings.ini loaded and answers queries on the given "
+       "Unix domain socket, see the README for the protocol") 
+      ("stats",
+       po::value<std::string>(&options.statsFileName)->implicit_value("-"),
+       "writes the time of every phase and the records and bytes "
+       "read and written as JSON to the given file at exit, or to "
+       "stderr; needs a debug or stats build") 
 //      ("rent,r",
 //       po::value<double>(&rent ),
 //       "sets rent") 
@@ -116,6 +186,122 @@ void GetArgsToMain(int ac, char *av[]) {
     }       //----  end if -----
 
     po::notify(vm);
+
+    if (vm.count("income1")) {
+      IncomeOverride o = { 1, vm["income1"].as<double>() };
+      options.incomes.push_back(o);
+    }       //----  end if -----
+    if (vm.count("income2")) {
+      IncomeOverride o = { 2, vm["income2"].as<double>() };
+      options.incomes.push_back(o);
+    }       //----  end if -----
+
+    for (auto s = incomes.begin(); s != incomes.end(); ++s) {
+      // n is digits only, so that neither signs nor junk are taken
+      const size_t colon  = (*s).find(':');
+      size_t       person = 0;
+      const std::from_chars_result r =
+        std::from_chars((*s).data(), (*s).data() + (colon == std::string::npos
+                                                    ? 0 : colon), person);
+      if (colon == std::string::npos || r.ptr != (*s).data() + colon
+          || r.ec != std::errc()) {
+        DisplayError("Income '" + *s + "' is not of the form n:income.");
+        exit(EXIT_FAILURE);
+      }       //----  end if -----
+      IncomeOverride o = { person, StringToDouble((*s).substr(colon+1)) };
+      options.incomes.push_back(o);
+    }       //----  end for -----
+
+    if (!ParseOutputFormat(format, options.format)) {
+      DisplayError("Unknown output format '" + format + "'.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+
+    if (!options.batchFileName.empty() && !options.incomes.empty()) {
+      DisplayError("Incomes can not be set in batch mode.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+
+    if (!options.seriesFileName.empty()
+        && (!options.batchFileName.empty() || !options.incomes.empty())) {
+      DisplayError("Incomes and batch files can not be given in series mode.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+
+    if (!options.treeFileName.empty()
+        && (!options.batchFileName.empty() || !options.incomes.empty()
+            || !options.seriesFileName.empty() || options.cents)) {
+      DisplayError("Incomes, batch files, series and cents can not be given "
+                   "with a tree.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+
+    if ((!options.seriesFileName.empty() || !options.treeFileName.empty())
+        && options.format == OutputBinary) {
+      DisplayError("The binary format has no layout for series or trees.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+
+    if (!options.settleFileName.empty()
+        && (!options.batchFileName.empty() || !options.seriesFileName.empty()
+            || !options.treeFileName.empty())) {
+      DisplayError("Batch files, series and trees can not be settled.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+
+    if (!options.statsFileName.empty() && !kStatsCompiledIn) {
+      DisplayError("--stats needs a build with FAIRSHARE_STATS, e.g. "
+                   "make BUILD=stats.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+
+    if (!options.rejectFileName.empty() && options.batchFileName.empty()
+        && options.seriesFileName.empty()) {
+      DisplayError("--rejects needs --batch or --series.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+
+    if (options.exact && options.settleFileName.empty()) {
+      DisplayError("--exact needs --settle.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+
+    if (!options.settleFileName.empty() && options.format == OutputBinary) {
+      DisplayError("The binary format has no layout for settlements.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+
+    if (!options.sweeps.empty()
+        && (!options.batchFileName.empty() || !options.seriesFileName.empty()
+            || !options.treeFileName.empty()
+            || !options.settleFileName.empty() || options.cents)) {
+      DisplayError("Batch files, series, trees, settlements and cents can "
+                   "not be swept.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+
+    if (options.transactionFileName.empty() != options.rulesFileName.empty()) {
+      DisplayError("--transactions and --rules need each other.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+
+    if (!options.transactionFileName.empty()
+        && (!options.batchFileName.empty() || !options.seriesFileName.empty()
+            || !options.treeFileName.empty())) {
+      DisplayError("Transactions can not be given with batch files, series "
+                   "or trees.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+
+    if (!options.socketPath.empty()
+        && (!options.sweeps.empty() || !options.transactionFileName.empty()
+            || !options.batchFileName.empty() || !options.incomes.empty()
+            || !options.seriesFileName.empty()
+            || !options.treeFileName.empty()
+            || !options.settleFileName.empty())) {
+      DisplayError("Incomes and batch files are given per query in server mode.");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
   }       //----  end try -----
 
   catch(std::exception& exc) {
@@ -130,6 +316,320 @@ void GetArgsToMain(int ac, char *av[]) {
 
 }   // -----  end of function getArgsToMain  -----
 
+void ApplyIncomeOverridesOrExit (std::vector<Person> & persons,
+                                 const std::vector<IncomeOverride> & incomes) {
+  for (auto o = incomes.begin(); o != incomes.end(); ++o) {
+    if ((*o).person < 1 || (*o).person > persons.size()) {
+      DisplayError("There is no person " + NumberToString((*o).person)
+                   + " in " + kIniFileName + ".");
+      exit(EXIT_FAILURE);
+    }       //----  end if -----
+    persons[(*o).person-1].income = (*o).income;
+  }       //----  end for -----
+}   // -----  end of function ApplyIncomeOverridesOrExit  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  RunBatch
+//  Description:  Writes the results of all households of a batch file in
+//                the format of --output-format, computed by --jobs
+//                threads. The output is the same for any number of
+//                threads; on an error the results of all households
+//                before it are written first. With series, the file is
+//                read as series households, see time-series.h.
+// =========================================================================
+void RunBatch (const std::string & fileName, const bool series,
+               std::ostream & os) {
+  std::ios::sync_with_stdio(false);
+
+  CheckFileExistsOrExit(fileName);
+
+  MappedFile file;
+  if (!MapFile(fileName, file)) {
+    DisplayError("Could not map file " + fileName + ": "
+                 + std::strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+
+  BatchJob job;
+  job.text     = std::string_view(file.data, file.size);
+  job.fileName = fileName;
+  job.cents    = options.cents;
+  job.series   = series;
+  job.format   = options.format;
+  job.threads  = options.jobs > 0 ? options.jobs
+                                  : std::thread::hardware_concurrency();
+  job.rejects  = NULL;
+
+  std::ofstream rejectFile;
+  RejectLog     rejects;
+  if (!options.rejectFileName.empty()) {
+    rejectFile.open(options.rejectFileName.c_str());
+    if (!rejectFile) {
+      DisplayError("Could not open reject file " + options.rejectFileName
+                   + ": " + std::strerror(errno));
+      exit(EXIT_FAILURE);
+    }
+    InitRejectLog(rejects, &rejectFile, fileName);
+    job.rejects = &rejects;
+  }
+
+  uint64_t    households = 0;
+  std::string error;
+  const bool  ok = RunBatchJob(job, os, households, error);
+  if (job.rejects != NULL) {
+    FinishRejectLog(rejects);
+    if (!rejectFile) {
+      DisplayError("Could not write reject file " + options.rejectFileName
+                   + ".");
+      exit(EXIT_FAILURE);
+    }
+    if (rejects.records > 0) {
+      std::cerr << "Rejected " << rejects.records << " of " << households
+                << " households, see " << options.rejectFileName << "."
+                << std::endl;
+    }
+  }
+  if (!ok) {
+    DisplayError(error);
+    exit(EXIT_FAILURE);
+  }
+
+  UnmapFile(file);
+}   // -----  end of function RunBatch  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  RunGroupTree
+//  Description:  Reads the group tree of fileName, splits the costs of
+//                every group down the tree and writes what every person
+//                pays in the format of --output-format, see
+//                WriteGroupTree.
+// =========================================================================
+void RunGroupTree (const std::string & fileName, std::ostream & os) {
+  std::ios::sync_with_stdio(false);
+
+  CheckFileExistsOrExit(fileName);
+
+  MappedFile file;
+  if (!MapFile(fileName, file)) {
+    DisplayError("Could not map file " + fileName + ": "
+                 + std::strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+
+  GroupTree   tree;
+  std::string error;
+  InitGroupTree(tree);
+  bool ok = false;
+  {
+    PhaseTimer timer(PhaseParse);
+    ok = ParseGroupTree(std::string_view(file.data, file.size), fileName,
+                        tree, error);
+    CountStat(CounterRecords, Groups(tree) + tree.personNames.size());
+  }
+  if (ok) {
+    PhaseTimer timer(PhaseAllocate);
+    ok = EvaluateGroupTree(tree, error);
+  }
+  if (!ok) {
+    DisplayError(error);
+    exit(EXIT_FAILURE);
+  }
+
+  {
+    PhaseTimer   timer(PhaseOutput);
+    OutputWriter writer;
+    InitGroupTreeWriter(writer, os, options.format);
+    WriteGroupTree(writer, tree);
+    FinishOutputWriter(writer);
+  }
+
+  UnmapFile(file);
+}   // -----  end of function RunGroupTree  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  RunSettlement
+//  Description:  Reads the payments file fileName, splits the expenses
+//                of p and e in whole cents and writes the balances of
+//                the persons and the transfers that even them out in the
+//                format of --output-format, see WriteSettlement.
+// =========================================================================
+void RunSettlement (const std::string & fileName,
+                    const std::vector<Person> & p,
+                    const std::vector<Expense> & e, std::ostream & os) {
+  CheckFileExistsOrExit(fileName);
+
+  MappedFile file;
+  if (!MapFile(fileName, file)) {
+    DisplayError("Could not map file " + fileName + ": "
+                 + std::strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+
+  Allocation  a;
+  Settlement  s;
+  std::string error;
+  InitSettlement(s);
+  const char * reason = NULL;
+  {
+    PhaseTimer timer(PhaseAllocate);
+    reason = AllocateHousehold(p, e, true, a);
+  }
+  if (reason != NULL) {
+    DisplayError(reason);
+    exit(EXIT_FAILURE);
+  }
+  bool ok = false;
+  {
+    PhaseTimer timer(PhaseParse);
+    ok = ParsePayments(std::string_view(file.data, file.size), fileName, p,
+                       e, s, error);
+  }
+  if (ok) {
+    PhaseTimer timer(PhaseAllocate);
+    ok = SettleBalances(e, a, s, error);
+    if (ok) {
+      PlanTransfers(s, options.exact);
+    }
+  }
+  if (!ok) {
+    DisplayError(error);
+    exit(EXIT_FAILURE);
+  }
+
+  {
+    PhaseTimer   timer(PhaseOutput);
+    OutputWriter writer;
+    InitSettlementWriter(writer, os, options.format);
+    WriteSettlement(writer, p, s);
+    FinishOutputWriter(writer);
+  }
+
+  UnmapFile(file);
+}   // -----  end of function RunSettlement  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  IngestTransactionsOrExit
+//  Description:  Reads the rules of rulesFileName and the transactions of
+//                the export fileName and sets the expenses of e from
+//                them, see ApplyTransactions. What was read and what
+//                matched no rule goes to stderr.
+// =========================================================================
+void IngestTransactionsOrExit (const std::string & fileName,
+                               const std::string & rulesFileName,
+                               std::vector<Expense> & e) {
+  CheckFileExistsOrExit(rulesFileName);
+  CheckFileExistsOrExit(fileName);
+
+  MappedFile rules;
+  if (!MapFile(rulesFileName, rules)) {
+    DisplayError("Could not map file " + rulesFileName + ": "
+                 + std::strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+
+  TransactionLedger  t;
+  TransactionSummary summary;
+  std::string        error;
+  InitTransactionLedger(t);
+  bool ok = false;
+  {
+    PhaseTimer timer(PhaseParse);
+    ok = ParseTransactionRules(std::string_view(rules.data, rules.size),
+                               rulesFileName, t, error)
+         && IngestTransactions(fileName, t, error);
+  }
+  UnmapFile(rules);
+  if (!ok) {
+    DisplayError(error);
+    exit(EXIT_FAILURE);
+  }
+  CountStat(CounterRecords, t.transactions);
+  ApplyTransactions(t, e, summary);
+
+  std::cerr << "Read " << t.transactions << " transactions with "
+            << t.cents.size() << " descriptions from " << fileName
+            << " into " << summary.expenses << " expenses";
+  if (summary.added > 0) {
+    std::cerr << ", " << summary.added << " of them new";
+  }
+  std::cerr << "." << std::endl;
+  if (summary.unmatchedKeys > 0) {
+    std::cerr << summary.unmatchedTransactions << " transactions with "
+              << summary.unmatchedKeys << " descriptions and a sum of "
+              << static_cast<double>(summary.unmatchedCents)/100.
+              << " matched no rule." << std::endl;
+  }
+}   // -----  end of function IngestTransactionsOrExit  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  RunSweep
+//  Description:  Evaluates the grid of scenarios of --sweep on p and e
+//                and writes every scenario in the format of
+//                --output-format, block by block, see WriteSweepBlock.
+// =========================================================================
+void RunSweep (const std::vector<Person> & p, const std::vector<Expense> & e,
+               std::ostream & os) {
+  std::ios::sync_with_stdio(false);
+
+  Sweep       s;
+  std::string error;
+  bool        ok = true;
+  for (std::size_t k = 0; ok && k < options.sweeps.size(); ++k) {
+    SweepAxis axis;
+    ok = ParseSweepAxis(options.sweeps[k], p, e, axis, error);
+    s.axes.push_back(axis);
+  }
+  if (ok) {
+    ok = PrepareSweep(p, e, s, error);
+  }
+  if (!ok) {
+    DisplayError(error);
+    exit(EXIT_FAILURE);
+  }
+
+  OutputWriter writer;
+  InitSweepWriter(writer, os, options.format, p, e, s);
+  for (;;) {
+    {
+      PhaseTimer timer(PhaseAllocate);
+      if (!NextSweepBlock(s)) {
+        break;
+      }
+    }
+    PhaseTimer timer(PhaseOutput);
+    WriteSweepBlock(writer, s);
+  }  // -----  end for  -----
+  FinishOutputWriter(writer);
+}   // -----  end of function RunSweep  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  WriteStatsAtExit
+//  Description:  Writes the stats of the run as one line of JSON to the
+//                file of --stats, or to stderr for "-", see
+//                WriteStatsJson. Registered with atexit, so that runs
+//                ending with exit are written as well; the threads of
+//                --batch have ended and merged their stats by then.
+// =========================================================================
+void WriteStatsAtExit () {
+  RunStats    stats;
+  std::string json;
+  if (!CollectStats(stats)) {
+    return;
+  }
+  WriteStatsJson(stats, json);
+
+  if (options.statsFileName == "-") {
+    std::cerr << json << std::flush;
+    return;
+  }
+  std::ofstream file(options.statsFileName.c_str());
+  file << json;
+  if (!file) {
+    DisplayError("Could not write the stats to " + options.statsFileName
+                 + ".");
+  }
+}   // -----  end of function WriteStatsAtExit  -----
+
 void DisplayHelp (const char *execName, 
     const boost::program_options::options_description opts) {
   std::cout << bold << "NAME:"        << normal           << std::endl;
@@ -163,91 +663,171 @@ void DisplayHelp (const char *execName,
        << std::endl
        << std::endl
        << std::endl;
-  std::cout << "  " << execName << " -r 1500 -2000 " << std::endl; 
+  std::cout << "  " << execName << " -1 1500 -2 2000 " << std::endl; 
+  std::cout << std::endl
+       << "    Ignores the income of the first and second person from"
+       << std::endl
+       << "    settings.ini and uses the ones provided by the command line"
+       << std::endl
+       << "    arguments instead."
+       << std::endl
+       << std::endl
+       << std::endl;
+  std::cout << "  " << execName << " -i 3:1800 " << std::endl; 
+  std::cout << std::endl
+       << "    Same for the income of the third person."
+       << std::endl
+       << std::endl
+       << std::endl;
+  std::cout << "  " << execName << " --batch households.ini " << std::endl; 
+  std::cout << std::endl
+       << "    Displays the results of every household in households.ini."
+       << std::endl
+       << "    A household is a group of [person] sections followed by an"
+       << std::endl
+       << "    [expenses] section, just like settings.ini."
+       << std::endl
+       << std::endl
+       << std::endl;
+  std::cout << "  " << execName << " -b households.ini -o csv " << std::endl; 
   std::cout << std::endl
-       << "    Ignores the income 2 and the rent from settings.ini and uses"
+       << "    Writes one line household,person_id,person,expense_id,expense,amount"
        << std::endl
-       << "    the ones provided by argument the command line arguments "
+       << "    per person and expense instead of the tables, e.g. to load"
        << std::endl
-       << "    instead."
+       << "    the results into a database."
+       << std::endl
+       << std::endl
+       << std::endl;
+  std::cout << "  " << execName << " --series months.ini -o csv " << std::endl; 
+  std::cout << std::endl
+       << "    Reads incomes and costs given per month, e.g."
+       << std::endl
+       << "    \"utilities = 80 95 110\", and writes the share of every"
+       << std::endl
+       << "    person and expense in every month and its running total."
+       << std::endl
+       << std::endl
+       << std::endl;
+  std::cout << "  " << execName << " --tree buildings.ini " << std::endl; 
+  std::cout << std::endl
+       << "    Splits the costs of every building among its households"
+       << std::endl
+       << "    by income, and the part of each household together with"
+       << std::endl
+       << "    its own costs among its members."
+       << std::endl
+       << std::endl
+       << std::endl;
+  std::cout << "  " << execName << " --sweep 2=1000:2000:100 --sweep rent=800:1200:50 "
+       << std::endl; 
+  std::cout << std::endl
+       << "    Displays the fair share for every income of the second"
+       << std::endl
+       << "    person from 1000 to 2000 and every rent from 800 to 1200."
+       << std::endl
+       << std::endl
+       << std::endl;
+  std::cout << "  " << execName << " --transactions export.csv --rules rules.ini "
+       << std::endl; 
+  std::cout << std::endl
+       << "    Sets the costs of the expenses from the bank statement"
+       << std::endl
+       << "    export.csv, added up by the rules of rules.ini."
+       << std::endl
+       << std::endl
+       << std::endl;
+  std::cout << "  " << execName << " --serve /tmp/fairshare.sock " << std::endl; 
+  std::cout << std::endl
+       << "    Keeps settings.ini loaded and answers queries like"
+       << std::endl
+       << "    \"1:1500 2:2000 format=csv\" on the socket, one per line."
        << std::endl
        << std::endl
        << std::endl;
 
 }   // -----  end of function DisplayHelp  -----
 
+// ===  FUNCTION  ==========================================================
+//         Name:  ParseIniFile
+//  Description:  Reads the household of the settings file into persons
+//                and expenses, through its binary cache unless
+//                --no-cache is given, see OpenLedgerCache.
+// =========================================================================
 void ParseIniFile (const std::string & fileName) {
-
-  CheckFileExistsOrExit (fileName);
-
-  using boost::property_tree::ptree;
-  
-  ptree pt;
-  read_ini(fileName, pt);
-
-  Person p1;
-  Person p2;
-
-  try {
-    p1.income = pt.get<double> ("person1.income");
-    p2.income = pt.get<double> ("person2.income");
-
-    p1.name   = pt.get<std::string> ("person1.name");
-    p2.name   = pt.get<std::string> ("person2.name");
-  }
-  catch (std::exception const& exc) {
-    DisplayError(exc.what());
-    exit(EXIT_FAILURE);
-  }
-  persons.push_back(p1);
-  persons.push_back(p2);
-
-  // https://stackoverflow.com/questions/6656380/boost-1-46-1-property-tree-how-to-iterate-through-ptree-receiving-sub-ptrees
-  // https://stackoverflow.com/questions/16135285/iterate-over-ini-file-on-c-probably-using-boostproperty-treeptree
-  ptree expenses_tree = pt.get_child("expenses");
-
-  try {
-    for (auto &v : expenses_tree) {
-      Expense e;
-      e.name = v.first;
-      e.cost = StringToDouble(v.second.data());
-      expenses.push_back(e);
+  PhaseTimer timer(PhaseParse);
+
+  Household   h;
+  std::string error;
+  bool        ok = false;
+
+  if (options.noCache) {
+    CheckFileExistsOrExit(fileName);
+    ok = LoadHouseholdFile(fileName, h, error);
+  } else {
+    LedgerCache       cache;
+    LedgerCacheResult result;
+    ok = OpenLedgerCache(fileName, cache, result, error);
+    if (ok) {
+      ExpandCachedHousehold(cache, h);
+      CloseLedgerCache(cache);
+    } else {
+      CheckFileExistsOrExit(fileName);
     }
-  }
-  catch (std::exception const& exc) {
-    DisplayError(exc.what());
+  }  // -----  end if-else  ----- 
+
+  if (!ok) {
+    DisplayError(error);
     exit(EXIT_FAILURE);
   }
 
-}   // -----  end of function ParseIniFileWavefunction  -----
+  CountStat(CounterRecords, h.persons.size() + h.expenses.size());
+  persons.swap(h.persons);
+  expenses.swap(h.expenses);
+}   // -----  end of function ParseIniFile  -----
 
 double CalculateRatio (const std::vector<Person> & persons ) {
-  const double alpha = persons[0].income/persons[1].income;
-  return 1./(persons[1].income*(1.+alpha));
+  // summed as by the allocation, so that the ratio is the same
+  std::vector<double> incomes(persons.size());
+  for (std::size_t j = 0; j < persons.size(); ++j) {
+    incomes[j] = persons[j].income;
+  }  // -----  end for  ----- 
+  return 1./SumPairwise(incomes.data(), incomes.size());
 }  // -----  end of function CalculateIncomeRatio  -----
 
+// ===  FUNCTION  ==========================================================
+//         Name:  AllocateOrExit
+//  Description:  Splits the expenses in floating point or, with --cents,
+//                in whole cents, see AllocateHousehold.
+// =========================================================================
+void AllocateOrExit (const std::vector<Person> & persons,
+                     const std::vector<Expense> & expenses, Allocation & a) {
+  PhaseTimer timer(PhaseAllocate);
+  const char * error = AllocateHousehold(persons, expenses, options.cents, a);
+  if (error != NULL) {
+    DisplayError(error);
+    exit(EXIT_FAILURE);
+  }  // -----  end if  ----- 
+}  // -----  end of function AllocateOrExit  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  CheckIncomeIsNonZeroOrExit
+//  Description:  Reports every person with a zero income, see
+//                CheckIncomes, not only the first, then exits.
+// =========================================================================
 void CheckIncomeIsNonZeroOrExit (const std::vector<Person> & persons) {
+  PhaseTimer timer(PhaseCheckIncome);
 
-  for (auto p = persons.begin(); p != persons.end(); ++p) {
-    if ((*p).income <= 0. && (*p).income >= 0. ) {
-      DisplayError("Incomes have to be non zero.");
-      exit(EXIT_FAILURE);
-    }  // -----  end if  ----- 
+  std::vector<RecordError> errors;
+  if (CheckIncomes(persons, 0, errors) == 0) {
+    return;
+  }
+  for (auto e = errors.begin(); e != errors.end(); ++e) {
+    DisplayError(FormatRecordError(kIniFileName, *e));
   }  // -----  end for  ----- 
-
+  exit(EXIT_FAILURE);
 }  // -----  end of function CheckIncomeIsNonZeroOrExit  -----
 
-void DisplayInputs (const std::vector<Person> & persons, const std::vector<Expense> & expenses) {
-  
-  for (auto p = persons.begin(); p != persons.end(); ++p) {
-    std::cout << (*p).name << " " << (*p).income << std::endl;
-  }  // -----  end for  ----- 
-  for (auto e = expenses.begin(); e != expenses.end(); ++e) {
-    std::cout <<(*e).name << " " << (*e).cost << std::endl;
-  }  // -----  end for  ----- 
-
-}  // -----  end of function DisplayInputs  -----
-
 
 // ===  FUNCTION  ==========================================================
 //         Name:  LongestString
@@ -264,18 +844,17 @@ int LongestString (const std::vector<Expense> & expenses) {
     }  // -----  end if  ----- 
   }  // -----  end for  ----- 
 
-  // go through the costs of the expenses
-  double sumCosts =0.;
-  for (auto e = expenses.begin(); e != expenses.end(); ++e) {
-      sumCosts += (*e).cost;
+  // go through the costs of the expenses, summed as the total that
+  // DisplayResults prints
+  std::vector<double> costs(expenses.size());
+  for (std::size_t i = 0; i < expenses.size(); ++i) {
+    costs[i] = expenses[i].cost;
   }  // -----  end for  ----- 
-    std::ostringstream sstream;
-    sstream << std::setprecision(2) << std::fixed << sumCosts;
-    std::string costAsString = sstream.str(); 
 
-    if (costAsString.size() > size) {
-      size = costAsString.size();
-    }  // -----  end if  ----- 
+  char costAsString[320];
+  size = std::max(size, FormatFixed2(SumPairwise(costs.data(), costs.size()),
+                                     costAsString,
+                                     costAsString + sizeof(costAsString)));
 
   return static_cast<int>(size);
 }  // -----  end of function LongestString  -----
@@ -284,20 +863,14 @@ int LongestString (const std::vector<Person> & persons) {
 
   size_t size = 0;
 
-  // go through the names of the persons
   for (auto p = persons.begin(); p != persons.end(); ++p) {
-    if ((*p).name.size() > size) {
-      size = (*p).name.size();
-    }  // -----  end if  ----- 
+    // go through the names of the persons
+    size = std::max(size, (*p).name.size());
 
     // go through the income of the persons
-    std::ostringstream sstream;
-    sstream << std::setprecision(2) << std::fixed << (*p).income;
-    std::string incomeAsString = sstream.str(); 
-
-    if (incomeAsString.size() > size) {
-      size = incomeAsString.size();
-    }  // -----  end if  ----- 
+    char incomeAsString[320];
+    size = std::max(size, FormatFixed2((*p).income, incomeAsString,
+                                       incomeAsString + sizeof(incomeAsString)));
   }  // -----  end for  ----- 
 
   return static_cast<int>(size);
@@ -324,137 +897,18 @@ int LongestString (const std::vector<Person> & persons) {
 //                width as we start with a space and end each column with
 //                three spaces
 //
+//                The table is rendered by RenderTable into a buffer that
+//                is reused for every call and written with one write.
+//
 // =========================================================================
-void DisplayResults (const std::vector<Person> & p, const std::vector<Expense> &e) {
-
-  double ratio = CalculateRatio(p);
-
-  using namespace std;
-
-  int width_expense = LongestString(e);
-  int width_person  = LongestString(p);
-  int width_income  = 10; // widths of the string "Name/Costs"
-
-  int width = width_income;
-  if (width_expense > width) {
-    width = width_expense;
-  }  // -----  end if  ----- 
-  if (width_person > width) {
-    width = width_person;
-  }  // -----  end if  ----- 
-  width += 4; // to add a space before the word and three spaces behind
-
-  ostringstream topLine;
-  ostringstream separatorLine;
-
-  // We have to add +1 to the width, for the top line, bottom line,
-  // separator line, since the output of separator symbol "+" is added to
-  // the total width of the line, but for us "width" means the width of the
-  // "inner" column
-  topLine
-    << " "
-    << setfill('=')
-    << setw(width+1)  << "="  // cost   column
-    << setw(width+1)  << "="; // income column
-  for (auto i = e.begin(); i != e.end(); ++i) {
-    topLine
-      << setw(width+1) << "=";
-  }  // -----  end for  ----- 
-  topLine
-    << setw(width+1)  << "=" // total column
-    << setfill(' ')
-    << endl;
-
-  separatorLine 
-    << " "
-    << setfill('-')
-    << setw(width+1)  << "+"
-    << setw(width+1)  << "+";
-  for (auto i = e.begin(); i != e.end(); ++i) {
-  separatorLine
-    << setw(width+1) << "+";
-  }  // -----  end for  ----- 
-  separatorLine
-    << setw(width+1)  << "|"
-    << setfill(' ')
-    << endl;
-
+void DisplayResults (const std::vector<Person> & p, const std::vector<Expense> &e,
+                     const Allocation & a, std::ostream & os) {
 
+  // the buffers are reused for every table
+  static TableBuffer table;
+  PhaseTimer timer(PhaseOutput);
 
-  // here we have to substract -1 from the width, as we have as a separator
-  // not simply a one char "|", but two chars " |"
-  cout 
-    << std::endl
-    << std::endl
-    << " "
-    << left
-    << setw(width-1)
-    << " " << " |" 
-    << setw(width-1) << setprecision(2) << fixed << left
-    << " Income" << " |";
-  for (auto i = e.begin(); i != e.end(); ++i) {
-    cout
-    << " "  
-    << setw(width-2) << setprecision(2) << fixed << left
-    << (*i).name << " |";
-  }  // -----  end for  ----- 
-  cout 
-    << setw(width-1) << fixed << left
-    << " Total" << " |" 
-    << std::endl
-    << topLine.str();
-
-  cout 
-    << " "
-    << right
-    << setw(width-1)
-    << "Name/Costs" << " |" 
-    << setw(width-1) << setprecision(2) << fixed << right
-    << " " <<  " |";
-  double sumCosts =0.;
-  for (auto i = e.begin(); i != e.end(); ++i) {
-    cout
-      << setw(width-1) << setprecision(2) << fixed << right
-      << (*i).cost << " |";
-      sumCosts += (*i).cost;
-  }  // -----  end for  ----- 
-  cout 
-    << setw(width-1) << setprecision(2) << fixed << right
-    << sumCosts << " |" 
-    << std::endl
-    << separatorLine.str();
-
-  for (auto j = p.begin(); j != p.end(); ++j) {
-    auto final_j = p.end();
-    --final_j;
-    cout 
-      << " "
-      << right
-      << setw(width-1)
-      << (*j).name << " |" 
-      << setw(width-1) << setprecision(2) << fixed << right
-      << (*j).income << " |";
-
-    for (auto i = e.begin(); i != e.end(); ++i) {
-      cout 
-        << setw(width-1) << setprecision(2) << fixed << right
-        << (*j).income * ratio * (*i).cost << " |";
-    }  // -----  end for expenses  ----- 
-    cout 
-      << setw(width-1) << setprecision(2) << fixed << right
-      << (*j).income * ratio * sumCosts << " |" 
-      << std::endl;
-      if (j != final_j) {
-        cout << separatorLine.str();
-      }
-  }  // -----  end for persons  ----- 
-
-  double percentTotal = sumCosts*ratio;
-  std::cout
-    << std::endl
-    << std::endl
-    <<"Every person pays a fair share of "
-    << bold << 100*percentTotal <<"%" << normal
-    <<" of her/his income."
-    << std::endl;
+  RenderTable(p, e, a, table);
+  os.write(table.text.data(), static_cast<std::streamsize>(table.text.size()));
+  CountStat(CounterBytesWritten, table.text.size());
 }  // -----  end of function DisplayResults  -----
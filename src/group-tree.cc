@@ -0,0 +1,337 @@
+//
+// =========================================================================
+//
+//       Filename:  group-tree.cc
+//
+//    Description:  Defines the parser of tree files and the evaluation of
+//                  a group tree: one sweep from the last group to the
+//                  first adds the incomes of every group to its parent,
+//                  one sweep from the first to the last hands the costs
+//                  down as rates. Both only touch the flat arrays of the
+//                  tree, never a pointer of a node.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 12:41:18 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>     // input/output streams, e.g. cout and cin
+#include <sstream>      // string streams to join different strings
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "arena.h"
+#include "name-table.h"
+#include "ini-parser.h"
+#include "summation.h"
+#include "group-tree.h"
+#include "helper-functions.h"
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+const uint32_t kNoParentGroup = 0xffffffffu;
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+bool IsBlank (const char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+IniToken SetError (IniScanner & s, const char * position,
+                   const std::string & message) {
+  s.error.line    = s.line;
+  s.error.column  = IniColumn(s, position);
+  s.error.message = message;
+  return IniSyntaxError;
+}
+
+// the name of a [group name] section, or an empty view for any other
+std::string_view GroupSectionName (const std::string_view section) {
+  if (section.size() < 7 || section.compare(0, 5, "group") != 0
+      || !IsBlank(section[5])) {
+    return std::string_view();
+  }
+  std::size_t k = 6;
+  while (k < section.size() && IsBlank(section[k])) {
+    ++k;
+  }
+  return section.substr(k);
+}
+
+// reads the groups of s into t, see GroupTree
+IniToken ParseGroups (IniScanner & s, GroupTree & t) {
+
+  enum Section : unsigned short {
+    NoSection,
+    GroupSection,
+    PersonSection,
+    ExpensesSection,
+    OtherSection,
+  };
+
+  Section     section    = NoSection;
+  bool        hasName    = false;
+  bool        hasIncome  = false;
+  std::size_t personLine = 0;
+
+  for (;;) {
+    const IniToken token = NextIniToken(s);
+
+    if (token == IniSyntaxError) {
+      return IniSyntaxError;
+    }
+
+    // a person section is complete
+    if (section == PersonSection && token != IniKeyValue
+        && !(hasName && hasIncome)) {
+      s.error.line    = personLine;
+      s.error.column  = 1;
+      s.error.message = hasName ? "Person has no income."
+                                : "Person has no name.";
+      return IniSyntaxError;
+    }
+
+    if (token == IniEnd) {
+      t.firstPerson.push_back(t.personNames.size());
+      return IniEnd;
+    }
+
+    if (token == IniSection) {
+      const std::string_view group = GroupSectionName(s.section);
+      if (!group.empty()) {
+        const uint32_t g = InternName(t.names, t.arena, group);
+        if (g < Groups(t)) {
+          return SetError(s, group.data(), "Group '" + std::string(group)
+                          + "' is defined twice.");
+        }
+        t.parents.push_back(kNoParentGroup);
+        t.depths.push_back(0);
+        t.firstPerson.push_back(t.personNames.size());
+        t.sums.emplace_back();
+        InitCompensatedSum(t.sums.back());
+        section = GroupSection;
+      } else if (Groups(t) == 0 && (IsPersonSection(s.section)
+                                    || s.section == "expenses")) {
+        return SetError(s, s.section.data(),
+                        "Section outside of any [group name] section.");
+      } else if (IsPersonSection(s.section)) {
+        t.personNames.push_back(std::string_view());
+        t.personIncomes.push_back(0.);
+        section    = PersonSection;
+        hasName    = false;
+        hasIncome  = false;
+        personLine = s.line;
+      } else if (s.section == "expenses") {
+        section = ExpensesSection;
+      } else {
+        section = OtherSection;
+      }
+      continue;
+    }  // -----  end if section  -----
+
+    switch (section) {
+      case GroupSection:
+        if (s.key == "parent") {
+          uint32_t parent = kNoParentGroup;
+          if (!FindName(t.names, s.value, parent)
+              || parent + 1 >= Groups(t)) {
+            return SetError(s, s.value.data(), "Parent '"
+                            + std::string(s.value)
+                            + "' is not a group before this one.");
+          }
+          t.parents.back() = parent;
+          t.depths.back()  = t.depths[parent] + 1;
+        }
+        break;
+
+      case PersonSection:
+        if (s.key == "name") {
+          t.personNames.back() = s.value;
+          hasName = true;
+        } else if (s.key == "income") {
+          const Conversion c = ParseDouble(s.value);
+          if (c.error != ConversionOk) {
+            return SetError(s, s.value.data(),
+                            ConversionErrorMessage(c.error));
+          }
+          t.personIncomes.back() = c.value;
+          hasIncome = true;
+        }
+        break;
+
+      case ExpensesSection: {
+        const Conversion c = ParseDouble(s.value);
+        if (c.error != ConversionOk) {
+          return SetError(s, s.value.data(), ConversionErrorMessage(c.error));
+        }
+        AddCompensated(t.sums.back(), c.value);
+        break;
+      }
+
+      case NoSection:
+        return SetError(s, s.key.data(), "Key outside of any section.");
+
+      case OtherSection:
+        break;
+
+      default:
+        break;
+    }  // -----  end switch  -----
+  }  // -----  end for  -----
+}
+}  // -----  end of namespace  -----
+
+void InitGroupTree (GroupTree & t) {
+  InitArena(t.arena, kArenaBlockBytes);
+  InitNameTable(t.names);
+}   // -----  end of function InitGroupTree  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ParseGroupTree
+//  Description:  Reads the groups of the text of a tree file into t,
+//                replacing what t held before. The person names are
+//                views into text, which has to outlive t. On failure
+//                error is set, as by ParseHouseholdText, and false is
+//                returned.
+// =========================================================================
+bool ParseGroupTree (const std::string_view text,
+                     const std::string & fileName, GroupTree & t,
+                     std::string & error) {
+  ResetArena(t.arena);
+  ResetNameTable(t.names);
+  t.parents.clear();
+  t.depths.clear();
+  t.firstPerson.clear();
+  t.costs.clear();
+  t.sums.clear();
+  t.incomes.clear();
+  t.rates.clear();
+  t.order.clear();
+  t.personNames.clear();
+  t.personIncomes.clear();
+
+  IniScanner scanner;
+  InitIniScanner(scanner, text);
+  if (ParseGroups(scanner, t) == IniSyntaxError) {
+    std::ostringstream message;
+    message << fileName << ":" << scanner.error.line << ":"
+      << scanner.error.column << ": " << scanner.error.message;
+    error = message.str();
+    return false;
+  }
+
+  if (Groups(t) == 0) {
+    error = "No [group name] section found in " + fileName;
+    return false;
+  }
+  t.costs.resize(Groups(t));
+  for (std::size_t g = 0; g < Groups(t); ++g) {
+    t.costs[g] = CompensatedTotal(t.sums[g]);
+  }
+  return true;
+}   // -----  end of function ParseGroupTree  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  EvaluateGroupTree
+//  Description:  Sums the incomes of every group and everything below it
+//                and sets the rates, see GroupTree, and the order in
+//                which the groups are displayed. Returns false with
+//                error set if an income is zero, or if a group has costs
+//                but no income below it to split them by.
+// =========================================================================
+bool EvaluateGroupTree (GroupTree & t, std::string & error) {
+  const std::size_t groups = Groups(t);
+
+  // the persons of a group are side by side, their incomes are summed
+  // pairwise, those of the groups below it are added compensated
+  t.sums.resize(groups);
+  for (std::size_t g = 0; g < groups; ++g) {
+    const std::size_t first = t.firstPerson[g];
+    const std::size_t last  = t.firstPerson[g + 1];
+    for (std::size_t p = first; p < last; ++p) {
+      const double income = t.personIncomes[p];
+      if (income <= 0. && income >= 0.) {
+        error = "Incomes have to be non zero.";
+        return false;
+      }
+    }
+    InitCompensatedSum(t.sums[g]);
+    AddCompensated(t.sums[g], SumPairwise(t.personIncomes.data() + first,
+                                          last - first));
+  }  // -----  end for  -----
+
+  // bottom-up, children come after their parents
+  t.incomes.resize(groups);
+  for (std::size_t g = groups; g-- > 0; ) {
+    t.incomes[g] = CompensatedTotal(t.sums[g]);
+    if (t.parents[g] != kNoParentGroup) {
+      AddCompensated(t.sums[t.parents[g]], t.incomes[g]);
+    }
+  }  // -----  end for  -----
+
+  // top-down
+  t.rates.resize(groups);
+  for (std::size_t g = 0; g < groups; ++g) {
+    const double inherited = InheritedRate(t, g);
+    if (t.costs[g] <= 0. && t.costs[g] >= 0.) {
+      t.rates[g] = inherited;
+      continue;
+    }
+    if (t.incomes[g] <= 0. && t.incomes[g] >= 0.) {
+      error = "Group '" + std::string(GroupName(t, g))
+              + "' has costs but no income below it.";
+      return false;
+    }
+    t.rates[g] = inherited + t.costs[g]/t.incomes[g];
+  }  // -----  end for  -----
+
+  // depth first order: the children of every group, counted into place,
+  // then walked with a stack, in the order of the file
+  std::vector<std::size_t> & firstChild = t.firstChild;
+  firstChild.assign(groups + 2, 0);
+  for (std::size_t g = 0; g < groups; ++g) {
+    if (t.parents[g] != kNoParentGroup) {
+      ++firstChild[t.parents[g] + 2];
+    }
+  }
+  for (std::size_t g = 2; g < groups + 2; ++g) {
+    firstChild[g] += firstChild[g - 1];
+  }
+  std::vector<uint32_t> & children = t.children;
+  children.resize(groups);
+  for (std::size_t g = 0; g < groups; ++g) {
+    if (t.parents[g] != kNoParentGroup) {
+      children[firstChild[t.parents[g] + 1]++] = static_cast<uint32_t>(g);
+    }
+  }
+  // firstChild[g] is now where the children of g begin
+  std::vector<uint32_t> & stack = t.stack;
+  stack.clear();
+  t.order.clear();
+  for (std::size_t root = groups; root-- > 0; ) {
+    if (t.parents[root] == kNoParentGroup) {
+      stack.push_back(static_cast<uint32_t>(root));
+    }
+  }
+  while (!stack.empty()) {
+    const uint32_t g = stack.back();
+    stack.pop_back();
+    t.order.push_back(g);
+    for (std::size_t c = firstChild[g + 1]; c-- > firstChild[g]; ) {
+      stack.push_back(children[c]);
+    }
+  }  // -----  end while  -----
+  return true;
+}   // -----  end of function EvaluateGroupTree  -----
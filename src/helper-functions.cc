@@ -23,41 +23,160 @@
 #include <string>    // string handling
 #include <sstream>   // string streams to join different strings
 #include <cfloat>    // convert strings to doubles
+#include <charconv>  // locale independent from_chars
+#include <cstdint>   // fixed width integers
+#include <cerrno>    // errno
+#include <cstring>   // strerror
+#include <unistd.h>  // access, getcwd
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/ini_parser.hpp>
 
 #include "global-constants.h"
+#include "chunk-reader.h"
 #include "helper-functions.h"
 
 using namespace std;
 
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+// the comments at the start of a file are short, no need to read a MB
+const std::size_t kCommentChunkBytes = 1 << 16;
+}  // -----  end of namespace  -----
+
 // conversion
+// ===  FUNCTION  ==========================================================
+//         Name:  StringToDouble
+//  Description:  Converts the whole string or exits. Zero and negative
+//                numbers, e.g. refunds, are valid.
+// =========================================================================
 double StringToDouble(const string & doubleString) {
-  char const *s = doubleString.c_str();
-  char *end;
-  errno = 0;
+  const Conversion c = ParseDouble(doubleString);
 
-  double d = strtod(s, &end);
-
-  if ((errno == ERANGE && d <= DBL_MAX && d >= DBL_MAX) || d > DBL_MAX) {
-    DisplayError("Overflow in string to double conversion.");
+  if (c.error != ConversionOk) {
+    DisplayError(string(ConversionErrorMessage(c.error))
+                 + " in string to double conversion of '"
+                 + doubleString + "'.");
     exit(EXIT_FAILURE);
   }
 
-  if ((errno == ERANGE && d <= DBL_MIN && d >= DBL_MIN) || d < DBL_MIN) {
-    DisplayError("Underflow in string to double conversion of " + doubleString);
-    
-    exit(EXIT_FAILURE);
+  return c.value;
+}       // ----------  end of function StringT0Double  ----------
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ParseDouble
+//  Description:  Locale independent conversion of the whole of s, without
+//                leading or trailing blanks.
+//
+//                Plain decimals like "-1234.56" with at most 15 digits,
+//                i.e. all monetary amounts, take a fast path: the digits
+//                are collected into an integer, which converts to double
+//                exactly, and divided by an exact power of ten. As both
+//                operands are exact the division is correctly rounded,
+//                so the result equals that of strtod. Everything else,
+//                e.g. exponents or long mantissas, goes to from_chars.
+// =========================================================================
+Conversion ParseDouble(const std::string_view s) {
+  static const double kPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+    1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+  };
+
+  Conversion c = { 0., ConversionOk };
+
+  const char * p   = s.data();
+  const char * end = s.data() + s.size();
+
+  if (p == end) {
+    c.error = ConversionEmpty;
+    return c;
   }
 
-  if (*s == '\0' || *end != '\0') {
-    DisplayError("Inconvertible in string to double conversion.");
-    exit(EXIT_FAILURE);
+  bool negative = false;
+  if (*p == '-' || *p == '+') {
+    negative = (*p == '-');
+    ++p;
+  }
+  const char * digitsBegin = p;
+
+  uint64_t mantissa       = 0;
+  int      digits         = 0;
+  int      fractionDigits = 0;
+  while (p < end && static_cast<unsigned>(*p - '0') < 10u) {
+    mantissa = 10*mantissa + static_cast<uint64_t>(*p - '0');
+    ++digits;
+    ++p;
+  }
+  if (p < end && *p == '.') {
+    ++p;
+    while (p < end && static_cast<unsigned>(*p - '0') < 10u) {
+      mantissa = 10*mantissa + static_cast<uint64_t>(*p - '0');
+      ++digits;
+      ++fractionDigits;
+      ++p;
+    }
   }
 
-  return d;
-}       // ----------  end of function StringT0Double  ----------
+  if (p == end && digits > 0 && digits <= 15) {
+    c.value = static_cast<double>(mantissa)/kPowersOfTen[fractionDigits];
+    if (negative) {
+      c.value = -c.value;
+    }
+    return c;
+  }
+
+  // slow path, from_chars does not accept a leading '+' and would take
+  // the sign of "+-5", so a digit or '.' has to follow the sign
+  if (digitsBegin == end || (*digitsBegin != '.'
+      && static_cast<unsigned>(*digitsBegin - '0') >= 10u)) {
+    c.error = ConversionInvalid;
+    return c;
+  }
+  const char * first = (negative ? digitsBegin - 1 : digitsBegin);
+  const std::from_chars_result r = std::from_chars(first, end, c.value);
+
+  if (r.ec == std::errc::result_out_of_range) {
+    c.error = ConversionOutOfRange;
+  } else if (r.ec != std::errc() || r.ptr != end) {
+    c.error = ConversionInvalid;
+  } else if (!IsFiniteNumber(c.value)) {
+    c.error = ConversionInvalid; // inf and nan are no amounts
+  }
+  return c;
+}       // ----------  end of function ParseDouble  ----------
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ParseDoubles
+//  Description:  Converts a column of n fields into the contiguous array
+//                values and stores the outcome of each field in errors.
+//                Returns the number of fields that could not be
+//                converted; their values are set to 0.
+// =========================================================================
+std::size_t ParseDoubles(const std::string_view * fields, const std::size_t n,
+                         double * values, ConversionError * errors) {
+  std::size_t failures = 0;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const Conversion c = ParseDouble(fields[i]);
+    values[i] = c.value;
+    errors[i] = c.error;
+    failures += (c.error != ConversionOk);
+  }
+
+  return failures;
+}       // ----------  end of function ParseDoubles  ----------
+
+const char * ConversionErrorMessage(const ConversionError error) {
+  switch (error) {
+    case ConversionOk:         return "No error";
+    case ConversionEmpty:      return "Empty value";
+    case ConversionInvalid:    return "Invalid number";
+    case ConversionOutOfRange: return "Number out of range";
+    default:                   return "Unknown error";
+  }
+}       // ----------  end of function ConversionErrorMessage  ----------
 
 // number treatment
 bool IsNumber(const double x) {
@@ -113,72 +232,140 @@ void OpenFileToReadOrExit(const string & fileName, ifstream & ifs) {
   ifs.open(fileName,ios::in);
 }   // -----  end of function OpenFileToReadOrExit -----
 
+// readable, checked with one system call instead of opening a stream;
+// stat would take as long and not tell whether the file can be read
 bool FileExists(const string & fileName) {
-  bool fileIsOpenToRead  = false;
-  ifstream ifs(fileName.c_str());
-  fileIsOpenToRead  = ifs.is_open();
-  ifs.close();
-  return fileIsOpenToRead;
+  return access(fileName.c_str(), R_OK) == 0;
 }   // -----  end of function FileExists  -----
 
+// ===  FUNCTION  ==========================================================
+//         Name:  CheckFileExists
+//  Description:  Returns false with error set, naming the current
+//                directory for relative names, if fileName can not be
+//                read. Never exits and never forks.
+// =========================================================================
+bool CheckFileExists(const string & fileName, string & error) {
+  if (FileExists(fileName)) {
+    return true;
+  }
+  error = "Could not open file " + fileName + ": " + std::strerror(errno);
+  char directory[4096];
+  if (!fileName.empty() && fileName[0] != '/'
+      && getcwd(directory, sizeof(directory)) != NULL) {
+    error += string(" (current path is ") + directory + ")";
+  }
+  return false;
+}   // -----  end of function CheckFileExists  -----
+
 void CheckFileExistsOrExit(const string & fileName) {
-  if(!FileExists(fileName)){
-    DisplayError("Could not open file " + fileName );
-    std::cout <<  "Current path is: ";
-    int returnValue = system("pwd");
-    if (returnValue != 0) {
-      DisplayError("System command 'pwd' returned with status " + returnValue);
-      exit(returnValue);
-    }
+  string error;
+  if (!CheckFileExists(fileName, error)) {
+    DisplayError(error);
     exit(EXIT_FAILURE);
   }
 }   // -----  end of function CheckFileExistsOrExit  -----
 
+// ===  FUNCTION  ==========================================================
+//         Name:  CountCommentLinesOfFile
+//  Description:  Counts the comment lines at the beginning of the file,
+//                see CountCommentLines, reading only as many chunks of
+//                kCommentChunkBytes as they take. A comment longer than
+//                a chunk is skipped a chunk at a time.
+// =========================================================================
 int CountCommentLinesOfFile(const string & fileName){
+  CheckFileExistsOrExit(fileName);
 
-  ifstream(ifs);
-  OpenFileToReadOrExit(fileName,ifs);
+  ChunkReader r;
+  if (!OpenChunkReader(fileName, kCommentChunkBytes, true, r)) {
+    DisplayError("Could not open file " + fileName + ": "
+                 + std::strerror(errno));
+    exit(EXIT_FAILURE);
+  }
 
-  int counterCommentLines = CountCommentLinesOfStream(ifs);
+  int  counterCommentLines = 0;
+  bool inComment           = false;  // a long one, cut by the chunk
+  bool done                = false;
+  while (!done) {
+    if (!FillChunk(r)) {
+      DisplayError("Could not read file " + fileName + ": "
+                   + std::strerror(errno));
+      exit(EXIT_FAILURE);
+    }
+    const std::string_view text     = ChunkText(r);
+    std::size_t            consumed = 0;
+    if (inComment) {
+      const std::size_t eol = text.find('\n');
+      inComment = eol == std::string_view::npos;
+      consumed  = inComment ? text.size() : eol + 1;
+    } else {
+      done = CountCommentLines(text, counterCommentLines, consumed);
+    }
+    ConsumeChunk(r, consumed);
+    if (ChunkLineTooLong(r)) {
+      ++counterCommentLines;
+      inComment = true;
+      ConsumeChunk(r, text.size());
+    }
+    done = done || r.atEnd;
+  }       //----  end while  -----
 
-  ifs.close();
+  CloseChunkReader(r);
   return counterCommentLines;
 }   // -----  end of function CountCommentLinesOfFile  -----
 
+// ===  FUNCTION  ==========================================================
+//         Name:  CountCommentLinesOfStream
+//  Description:  Counts the comment lines at the beginning of ifs, see
+//                CountCommentLines, and rewinds it. Only the lines up to
+//                the first that is no comment are read, a line at a time.
+// =========================================================================
 int CountCommentLinesOfStream(ifstream & ifs) {
-  string firstStringOfLine ="";
-  int counterCommentLines = 0;
-
-  ifs >> firstStringOfLine;
-  char firstCharOfString = firstStringOfLine.c_str()[0];
-
-  while (firstCharOfString == '#' || firstCharOfString == '/'){
-    ifs.ignore(300,'\n');
-    ifs >> firstStringOfLine;
-    firstCharOfString = firstStringOfLine.c_str()[0];
-    counterCommentLines++;
+  int    counterCommentLines = 0;
+  string line;
+
+  while (std::getline(ifs, line)) {
+    line += '\n';
+    std::size_t consumed = 0;
+    if (CountCommentLines(line, counterCommentLines, consumed)) {
+      break;
+    }
   }       //----  end while  -----
 
+  ifs.clear();
   ifs.seekg(0); // rewind 
 
   return counterCommentLines;
 }   // -----  end of function CountCommentLinesOfStream  -----
 
+// ===  FUNCTION  ==========================================================
+//         Name:  CountLines
+//  Description:  Counts the newlines of the file, read in chunks of
+//                kChunkReaderBytes, see CountNewlines.
+// =========================================================================
 int CountLines(const string & fileName) {
-  ifstream(ifs);
-  OpenFileToReadOrExit(fileName,ifs);
-  // new lines will be skipped unless we stop it from happening:    
-  ifs.unsetf(std::ios_base::skipws);
-
-  // count the newlines with an algorithm specialized for counting:
-  int lineCount = static_cast<int>(
-                    std::count(
-                      std::istream_iterator<char>(ifs),
-                      std::istream_iterator<char>(), 
-                      '\n'
-                      )
-                  );
-  return lineCount;
+  CheckFileExistsOrExit(fileName);
+
+  ChunkReader r;
+  if (!OpenChunkReader(fileName, kChunkReaderBytes, false, r)) {
+    DisplayError("Could not open file " + fileName + ": "
+                 + std::strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+
+  std::size_t lineCount = 0;
+  do {
+    if (!FillChunk(r)) {
+      DisplayError("Could not read file " + fileName + ": "
+                   + std::strerror(errno));
+      exit(EXIT_FAILURE);
+    }
+    const std::string_view text = ChunkText(r);
+    lineCount += CountNewlines(text);
+    ConsumeChunk(r, text.size());
+  } while (!r.atEnd);
+
+  CloseChunkReader(r);
+  return static_cast<int>(lineCount);
 }   // -----  end of function CountLines  -----
 
 void IgnoreCommentLinesAtBeginningOfFile(ifstream & ifs) {
@@ -0,0 +1,79 @@
+//
+// =========================================================================
+//
+//       Filename:  household-reader.cc
+//
+//    Description:  Reads the household of a settings file, from its
+//                  text or from the memory mapped file, without exiting
+//                  on errors.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 11:05:52 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cerrno>    // errno
+#include <cstring>   // strerror
+#include <sstream>   // string streams to join different strings
+#include <string>    // string handling
+#include <vector>    // vector handling
+
+#include "ledger.h"
+#include "ini-parser.h"
+#include "household-reader.h"
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ParseHouseholdText
+//  Description:  Reads the single household of the text of a settings
+//                file into h. Every section [person1], [person2], ...
+//                [personN] is one person, in the order they appear in the
+//                file. On failure h is left unspecified, error is set and
+//                false is returned. fileName is only used for the message.
+// =========================================================================
+bool ParseHouseholdText (const std::string_view text,
+                         const std::string & fileName, Household & h,
+                         std::string & error) {
+
+  IniScanner scanner;
+  InitIniScanner(scanner, text);
+
+  bool pendingPerson = false;
+  if (ParseHousehold(scanner, h, false, pendingPerson) == IniSyntaxError) {
+    std::ostringstream message;
+    message << fileName << ":" << scanner.error.line << ":"
+      << scanner.error.column << ": " << scanner.error.message;
+    error = message.str();
+    return false;
+  }
+
+  if (h.persons.empty()) {
+    error = "No [person] section found in " + fileName;
+    return false;
+  }
+  return true;
+}   // -----  end of function ParseHouseholdText  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  LoadHouseholdFile
+//  Description:  Maps a settings file and reads it with ParseHouseholdText.
+// =========================================================================
+bool LoadHouseholdFile (const std::string & fileName, Household & h,
+                        std::string & error) {
+
+  MappedFile file;
+  if (!MapFile(fileName, file)) {
+    error = "Could not map file " + fileName + ": " + std::strerror(errno);
+    return false;
+  }
+
+  const bool ok = ParseHouseholdText(std::string_view(file.data, file.size),
+                                     fileName, h, error);
+  UnmapFile(file);
+  return ok;
+}   // -----  end of function LoadHouseholdFile  -----
@@ -0,0 +1,159 @@
+//
+// =========================================================================
+//
+//       Filename:  household-store.cc
+//
+//    Description:  Defines the household store.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 10:48:21 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ledger.h"
+#include "arena.h"
+#include "name-table.h"
+#include "ini-parser.h"
+#include "household-store.h"
+
+void InitHouseholdStore (HouseholdStore & s) {
+  InitArena(s.arena, kArenaBlockBytes);
+  InitNameTable(s.names);
+  s.households.clear();
+}   // -----  end of function InitHouseholdStore  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ResetHouseholdStore
+//  Description:  Drops all households and names in O(1). The memory is
+//                kept and reused by the next batch.
+// =========================================================================
+void ResetHouseholdStore (HouseholdStore & s) {
+  ResetArena(s.arena);
+  ResetNameTable(s.names);
+  s.households.clear();
+}   // -----  end of function ResetHouseholdStore  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  StoreHousehold
+//  Description:  Appends a copy of h to s: the record and its arrays
+//                take one allocation in the arena, the names only their
+//                ids unless they are new.
+// =========================================================================
+const StoredHousehold * StoreHousehold (HouseholdStore & s,
+                                        const Household & h) {
+  const std::size_t n = h.persons.size();
+  const std::size_t e = h.expenses.size();
+
+  std::size_t w = 0;
+  for (std::size_t i = 0; i < e; ++i) {
+    w += h.expenses[i].weights.size();
+  }
+
+  // the doubles first, so that nothing needs padding
+  const std::size_t bytes = sizeof(StoredHousehold)
+                            + (n + e + w)*sizeof(double)
+                            + (n + e)*sizeof(uint32_t)
+                            + e*sizeof(ExpensePolicy);
+  char * p = static_cast<char *>(ArenaAllocate(s.arena, bytes,
+                                               alignof(StoredHousehold)));
+
+  StoredHousehold * r = reinterpret_cast<StoredHousehold *>(p);
+  double *   incomes      = reinterpret_cast<double *>(p + sizeof(StoredHousehold));
+  double *   costs        = incomes + n;
+  double *   weights      = costs + e;
+  uint32_t * personNames  = reinterpret_cast<uint32_t *>(weights + w);
+  uint32_t * expenseNames = personNames + n;
+  ExpensePolicy * policies = reinterpret_cast<ExpensePolicy *>(expenseNames + e);
+
+  for (std::size_t j = 0; j < n; ++j) {
+    incomes[j]     = h.persons[j].income;
+    personNames[j] = InternName(s.names, s.arena, h.persons[j].name);
+  }
+  double * weight = weights;
+  for (std::size_t i = 0; i < e; ++i) {
+    costs[i]        = h.expenses[i].cost;
+    expenseNames[i] = InternName(s.names, s.arena, h.expenses[i].name);
+    policies[i]     = h.expenses[i].policy;
+    for (std::size_t j = 0; j < h.expenses[i].weights.size(); ++j) {
+      *weight++ = h.expenses[i].weights[j];
+    }
+  }
+
+  r->persons      = static_cast<uint32_t>(n);
+  r->expenses     = static_cast<uint32_t>(e);
+  r->incomes      = incomes;
+  r->costs        = costs;
+  r->weights      = weights;
+  r->personNames  = personNames;
+  r->expenseNames = expenseNames;
+  r->policies     = policies;
+  s.households.push_back(r);
+  return r;
+}   // -----  end of function StoreHousehold  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ExpandHousehold
+//  Description:  Writes r back into h, e.g. for Allocate and the output
+//                writers. The strings of h are reused.
+// =========================================================================
+void ExpandHousehold (const HouseholdStore & s, const StoredHousehold & r,
+                      Household & h) {
+  h.persons.resize(r.persons);
+  h.expenses.resize(r.expenses);
+  for (std::size_t j = 0; j < r.persons; ++j) {
+    h.persons[j].name.assign(NameOf(s.names, r.personNames[j]));
+    h.persons[j].income = r.incomes[j];
+  }
+  const double * weights = r.weights;
+  for (std::size_t i = 0; i < r.expenses; ++i) {
+    h.expenses[i].name.assign(NameOf(s.names, r.expenseNames[i]));
+    h.expenses[i].cost   = r.costs[i];
+    h.expenses[i].policy = r.policies[i];
+    h.expenses[i].weights.clear();
+    if (r.policies[i] == PolicyWeighted || r.policies[i] == PolicyFixed) {
+      h.expenses[i].weights.assign(weights, weights + r.persons);
+      weights += r.persons;
+    }
+  }
+}   // -----  end of function ExpandHousehold  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  LoadHouseholdBatch
+//  Description:  Appends all households of a batch file to s. Returns
+//                false on a syntax error, with its line and column in
+//                error; the households before it are kept.
+// =========================================================================
+bool LoadHouseholdBatch (const std::string_view text, HouseholdStore & s,
+                         std::string & error) {
+  IniScanner scanner;
+  InitIniScanner(scanner, text);
+
+  Household h;
+  bool      pendingPerson = false;
+  for (;;) {
+    if (ParseHousehold(scanner, h, true, pendingPerson) == IniSyntaxError) {
+      std::ostringstream message;
+      message << scanner.error.line << ":" << scanner.error.column << ": "
+        << scanner.error.message;
+      error = message.str();
+      return false;
+    }
+    if (h.persons.empty() && h.expenses.empty()) {
+      return true;
+    }
+    StoreHousehold(s, h);
+  }  // -----  end for  -----
+}   // -----  end of function LoadHouseholdBatch  -----
@@ -0,0 +1,462 @@
+//
+// =========================================================================
+//
+//       Filename:  ini-parser.cc
+//
+//    Description:  Defines the zero-copy ini parser. The scanner walks
+//                  the mapped file line by line with memchr and never
+//                  copies a byte; only the names of persons and expenses
+//                  are copied into the Household records. Numbers are
+//                  converted by ParseDouble, so a malformed amount is a
+//                  syntax error with line and column like any other.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 01:14:09 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstring>      // memchr
+#include <iostream>     // input/output streams, e.g. cout and cin
+#include <sstream>      // string streams to join different strings
+#include <string>       // string handling
+#include <string_view>  // views into the mapped file
+#include <vector>       // vector handling
+
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close
+
+#include "ledger.h"
+#include "ini-parser.h"
+#include "stats.h"
+#include "helper-functions.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+bool IsBlank (const char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+std::string_view Trim (const char * first, const char * last) {
+  while (first < last && IsBlank(*first)) {
+    ++first;
+  }
+  while (last > first && IsBlank(*(last-1))) {
+    --last;
+  }
+  return std::string_view(first, static_cast<std::size_t>(last - first));
+}
+
+IniToken SetError (IniScanner & s, const char * position,
+                   const std::string & message) {
+  s.error.line    = s.line;
+  s.error.column  = IniColumn(s, position);
+  s.error.message = message;
+  return IniSyntaxError;
+}
+
+// A key of a person other than name and income, e.g. usage = 340. It is
+// only converted if an expense names it as its column.
+struct column_value {
+  std::size_t      person;
+  std::string_view key;
+  std::string_view value;
+  std::size_t      line;
+  std::size_t      column;
+};  // -----  end of struct column_value  -----
+
+// an expense split by a column of the persons, e.g. power = 80 weighted usage
+struct column_use {
+  std::size_t      expense;
+  std::string_view key;
+  std::size_t      line;
+  std::size_t      column;
+};  // -----  end of struct column_use  -----
+
+typedef struct column_value ColumnValue;
+typedef struct column_use   ColumnUse;
+
+IniToken SetErrorAt (IniScanner & s, const std::size_t line,
+                     const std::size_t column, const std::string & message) {
+  s.error.line    = line;
+  s.error.column  = column;
+  s.error.message = message;
+  return IniSyntaxError;
+}
+
+// the next blank separated word of [p, last), p is moved behind it
+std::string_view NextWord (const char *& p, const char * last) {
+  while (p < last && IsBlank(*p)) {
+    ++p;
+  }
+  const char * first = p;
+  while (p < last && !IsBlank(*p)) {
+    ++p;
+  }
+  return std::string_view(first, static_cast<std::size_t>(p - first));
+}
+
+// Reads the value of an expense, 'amount [policy [column]]', into a new
+// expense of h; a key that is already an expense is an error. The
+// columns are looked up by ResolveColumns once all persons are known.
+IniToken ParseExpense (IniScanner & s, Household & h,
+                       std::vector<ColumnUse> & uses) {
+  const char *           p      = s.value.data();
+  const char *const      last   = p + s.value.size();
+  const std::string_view amount = NextWord(p, last);
+  const Conversion       c      = ParseDouble(amount);
+  if (c.error != ConversionOk) {
+    return SetError(s, s.value.data(), ConversionErrorMessage(c.error));
+  }
+  // the ids of the keys count the expenses, so a known key has one below
+  if (InternView(s.expenseKeys, s.key) < h.expenses.size()) {
+    return SetError(s, s.key.data(), "Expense '" + std::string(s.key)
+                    + "' is defined twice.");
+  }
+  h.expenses.push_back(Expense());
+  h.expenses.back().name.assign(s.key.data(), s.key.size());
+  h.expenses.back().cost = c.value;
+  if (p == last) {
+    return IniKeyValue;
+  }
+
+  const std::string_view policy = NextWord(p, last);
+  const std::string_view column = NextWord(p, last);
+  const std::string_view extra  = NextWord(p, last);
+  ExpensePolicy &        e      = h.expenses.back().policy;
+  if (policy == "income") {
+    e = PolicyIncome;
+  } else if (policy == "equal") {
+    e = PolicyEqual;
+  } else if (policy == "weighted") {
+    e = PolicyWeighted;
+  } else if (policy == "fixed") {
+    e = PolicyFixed;
+  } else {
+    return SetError(s, policy.data(), "Unknown policy '" + std::string(policy)
+                    + "', expected income, equal, weighted or fixed.");
+  }
+
+  const bool needsColumn = e == PolicyWeighted || e == PolicyFixed;
+  if (needsColumn && column.empty()) {
+    return SetError(s, policy.data(), "Policy '" + std::string(policy)
+                    + "' needs a column of the persons, e.g. '"
+                    + std::string(policy) + " usage'.");
+  }
+  if (!needsColumn && !column.empty()) {
+    return SetError(s, column.data(), "Unexpected '" + std::string(column)
+                    + "' after policy '" + std::string(policy) + "'.");
+  }
+  if (!extra.empty()) {
+    return SetError(s, extra.data(), "Unexpected '" + std::string(extra)
+                    + "' after the column.");
+  }
+  if (needsColumn) {
+    const ColumnUse use = { h.expenses.size() - 1, column, s.line,
+                            IniColumn(s, column.data()) };
+    uses.push_back(use);
+  }
+  return IniKeyValue;
+}
+
+// Sets the weights of every expense in uses from the values of its
+// column. A person without the column has the weight 0, but at least
+// one person has to have it.
+IniToken ResolveColumns (IniScanner & s, Household & h,
+                         const std::vector<ColumnValue> & values,
+                         const std::vector<ColumnUse> & uses) {
+  for (std::size_t u = 0; u < uses.size(); ++u) {
+    std::vector<double> & weights = h.expenses[uses[u].expense].weights;
+    weights.assign(h.persons.size(), 0.);
+    bool found = false;
+    for (std::size_t k = 0; k < values.size(); ++k) {
+      if (values[k].key != uses[u].key) {
+        continue;
+      }
+      const Conversion c = ParseDouble(values[k].value);
+      if (c.error != ConversionOk) {
+        return SetErrorAt(s, values[k].line, values[k].column,
+                          ConversionErrorMessage(c.error));
+      }
+      weights[values[k].person] = c.value;
+      found = true;
+    }  // -----  end for  -----
+    if (!found) {
+      return SetErrorAt(s, uses[u].line, uses[u].column, "No person has a '"
+                        + std::string(uses[u].key) + "'.");
+    }
+  }  // -----  end for  -----
+  return IniKeyValue;
+}
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  MapFile
+//  Description:  Maps fileName read-only into memory. Returns false and
+//                leaves errno set if the file can not be opened or
+//                mapped. An empty file is mapped to an empty range.
+// =========================================================================
+bool MapFile (const std::string & fileName, MappedFile & f) {
+  f.data = NULL;
+  f.size = 0;
+
+  const int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return false;
+  }
+
+  if (st.st_size > 0) {
+    void * p = mmap(NULL, static_cast<std::size_t>(st.st_size), PROT_READ,
+                    MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      close(fd);
+      return false;
+    }
+    madvise(p, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+    f.data = static_cast<const char *>(p);
+    f.size = static_cast<std::size_t>(st.st_size);
+    CountStat(CounterBytesRead, f.size);
+  }
+
+  close(fd); // the mapping stays valid
+  return true;
+}   // -----  end of function MapFile  -----
+
+void UnmapFile (MappedFile & f) {
+  if (f.data != NULL) {
+    munmap(const_cast<char *>(f.data), f.size);
+  }
+  f.data = NULL;
+  f.size = 0;
+}   // -----  end of function UnmapFile  -----
+
+void InitIniScanner (IniScanner & s, const std::string_view text) {
+  s.begin     = text.data();
+  s.cur       = text.data();
+  s.end       = text.data() + text.size();
+  s.line      = 0;
+  s.lineBegin = text.data();
+}   // -----  end of function InitIniScanner  -----
+
+std::size_t IniColumn (const IniScanner & s, const char * position) {
+  return static_cast<std::size_t>(position - s.lineBegin) + 1;
+}   // -----  end of function IniColumn  -----
+
+// [person1], [person2], ... and a plain [person], but not e.g. [personnel]
+bool IsPersonSection (const std::string_view section) {
+  if (section.compare(0, 6, "person") != 0) {
+    return false;
+  }
+  for (std::size_t k = 6; k < section.size(); ++k) {
+    if (section[k] < '0' || section[k] > '9') {
+      return false;
+    }
+  }
+  return true;
+}   // -----  end of function IsPersonSection  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  NextIniToken
+//  Description:  Scans the next section header or key-value pair,
+//                skipping blank lines and comment lines.
+// =========================================================================
+IniToken NextIniToken (IniScanner & s) {
+
+  while (s.cur < s.end) {
+    const char * first = s.cur;
+    const char * last  = static_cast<const char *>(
+        std::memchr(first, '\n', static_cast<std::size_t>(s.end - first)));
+    if (last == NULL) {
+      last = s.end;
+    }
+    s.cur       = (last < s.end) ? last + 1 : last;
+    s.lineBegin = first;
+    ++s.line;
+
+    while (first < last && IsBlank(*first)) {
+      ++first;
+    }
+    if (first == last || *first == ';' || *first == '#') {
+      continue;
+    }
+
+    if (*first == '[') {
+      const char * close = static_cast<const char *>(
+          std::memchr(first, ']', static_cast<std::size_t>(last - first)));
+      if (close == NULL) {
+        return SetError(s, first, "Missing ']' in section header.");
+      }
+      s.section = Trim(first + 1, close);
+      return IniSection;
+    }  // -----  end if section  -----
+
+    const char * equal = static_cast<const char *>(
+        std::memchr(first, '=', static_cast<std::size_t>(last - first)));
+    if (equal == NULL) {
+      return SetError(s, first, "Expected 'key = value'.");
+    }
+    s.key   = Trim(first, equal);
+    s.value = Trim(equal + 1, last);
+    if (s.key.empty()) {
+      return SetError(s, first, "Missing key before '='.");
+    }
+    return IniKeyValue;
+  }  // -----  end while  -----
+
+  return IniEnd;
+}   // -----  end of function NextIniToken  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ParseHousehold
+//  Description:  Reads [personN] and [expenses] sections into h. Every
+//                person section, see IsPersonSection, needs a name and an
+//                income; all other sections are ignored, and every key of
+//                [expenses] may appear only once. An expense may name its
+//                policy after the amount, see ParseExpense; the other
+//                keys of the persons are the columns it can refer to.
+//
+//                With stopAtNextHousehold the first [person] section
+//                after [expenses] ends the household: IniSection is
+//                returned and pendingPerson is set, so that the next call
+//                starts with that person. Otherwise IniEnd is returned at
+//                the end of the input, or IniSyntaxError on a syntax error.
+// =========================================================================
+IniToken ParseHousehold (IniScanner & s, Household & h,
+                         const bool stopAtNextHousehold,
+                         bool & pendingPerson) {
+
+  enum Section : unsigned short {
+    NoSection,
+    PersonSection,
+    ExpensesSection,
+    OtherSection,
+  };
+
+  h.persons.clear();
+  h.expenses.clear();
+  if (s.expenseKeys.slots.empty()) {
+    InitNameTable(s.expenseKeys);
+  } else {
+    ResetNameTable(s.expenseKeys);
+  }
+
+  Section     section      = NoSection;
+  bool        seenExpenses = false;
+  bool        hasName      = false;
+  bool        hasIncome    = false;
+  std::size_t personLine   = 0;
+
+  // only filled by ledgers with policies
+  std::vector<ColumnValue> values;
+  std::vector<ColumnUse>   uses;
+
+  if (pendingPerson) {
+    h.persons.push_back(Person());
+    h.persons.back().income = 0.;
+    section       = PersonSection;
+    personLine    = s.line;
+    pendingPerson = false;
+  }
+
+  for (;;) {
+    const IniToken token = NextIniToken(s);
+
+    if (token == IniSyntaxError) {
+      return IniSyntaxError;
+    }
+
+    // a person section is complete
+    if (section == PersonSection && token != IniKeyValue
+        && !(hasName && hasIncome)) {
+      s.error.line    = personLine;
+      s.error.column  = 1;
+      s.error.message = hasName ? "Person has no income."
+                                : "Person has no name.";
+      return IniSyntaxError;
+    }
+
+    if (token == IniEnd) {
+      if (!uses.empty()
+          && ResolveColumns(s, h, values, uses) == IniSyntaxError) {
+        return IniSyntaxError;
+      }
+      return IniEnd;
+    }
+
+    if (token == IniSection) {
+      if (IsPersonSection(s.section)) {
+        if (stopAtNextHousehold && seenExpenses) {
+          pendingPerson = true;
+          if (!uses.empty()
+              && ResolveColumns(s, h, values, uses) == IniSyntaxError) {
+            return IniSyntaxError;
+          }
+          return IniSection;
+        }
+        h.persons.push_back(Person());
+        h.persons.back().income = 0.;
+        section    = PersonSection;
+        hasName    = false;
+        hasIncome  = false;
+        personLine = s.line;
+      } else if (s.section == "expenses") {
+        section      = ExpensesSection;
+        seenExpenses = true;
+      } else {
+        section = OtherSection;
+      }
+      continue;
+    }  // -----  end if section  -----
+
+    switch (section) {
+      case PersonSection:
+        if (s.key == "name") {
+          h.persons.back().name.assign(s.value.data(), s.value.size());
+          hasName = true;
+        } else if (s.key == "income") {
+          const Conversion c = ParseDouble(s.value);
+          if (c.error != ConversionOk) {
+            return SetError(s, s.value.data(),
+                            ConversionErrorMessage(c.error));
+          }
+          h.persons.back().income = c.value;
+          hasIncome = true;
+        } else {
+          const ColumnValue v = { h.persons.size() - 1, s.key, s.value,
+                                  s.line, IniColumn(s, s.value.data()) };
+          values.push_back(v);
+        }
+        break;
+
+      case ExpensesSection:
+        if (ParseExpense(s, h, uses) == IniSyntaxError) {
+          return IniSyntaxError;
+        }
+        break;
+
+      case NoSection:
+        return SetError(s, s.key.data(), "Key outside of any section.");
+
+      case OtherSection:
+        break;
+
+      default:
+        break;
+    }  // -----  end switch  -----
+  }  // -----  end for  -----
+}   // -----  end of function ParseHousehold  -----
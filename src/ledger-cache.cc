@@ -0,0 +1,349 @@
+//
+// =========================================================================
+//
+//       Filename:  ledger-cache.cc
+//
+//    Description:  Defines the binary ledger cache. The cache of a
+//                  settings file is used if it records the size and mtime
+//                  of the file and was written after that mtime, or the
+//                  size and hash of the file after the mtime changed,
+//                  e.g. by a copy, or was too close to tell; otherwise
+//                  the file is parsed and the cache written again.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 11:27:03 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cerrno>
+#include <cstddef>   // offsetof
+#include <cstdint>
+#include <cstdio>    // rename
+#include <cstdlib>   // mkstemp
+#include <cstring>   // memcpy, strerror
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>     // open
+#include <sys/stat.h>  // stat
+#include <unistd.h>    // write, pwrite, close
+
+#include "ledger.h"
+#include "arena.h"
+#include "name-table.h"
+#include "ini-parser.h"
+#include "household-reader.h"
+#include "ledger-cache.h"
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+const char     kLedgerCacheMagic[4] = { 'F', 'S', 'L', 'C' };
+const uint32_t kLedgerCacheVersion  = 2;
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+const uint32_t kByteOrder = 0x01020304;
+
+// FNV-1a
+uint64_t HashBytes (const char * p, const std::size_t size) {
+  uint64_t h = 14695981039346656037ull;
+  for (std::size_t k = 0; k < size; ++k) {
+    h ^= static_cast<unsigned char>(p[k]);
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+int64_t MtimeNs (const struct stat & st) {
+  return static_cast<int64_t>(st.st_mtim.tv_sec)*1000000000
+         + static_cast<int64_t>(st.st_mtim.tv_nsec);
+}
+
+uint64_t ImageSize (const uint64_t persons, const uint64_t expenses,
+                    const uint64_t names, const uint64_t nameBytes,
+                    const uint64_t weights) {
+  return sizeof(LedgerCacheHeader)
+         + (persons + expenses + weights)*sizeof(double)
+         + (persons + 2*expenses + names + 1)*sizeof(uint32_t) + nameBytes;
+}
+
+bool HasWeights (const uint32_t policy) {
+  return policy == PolicyWeighted || policy == PolicyFixed;
+}
+
+const LedgerCacheHeader & Header (const char * data) {
+  return *reinterpret_cast<const LedgerCacheHeader *>(data);
+}
+
+// Points the view of c at the cache in data, after checking that it is
+// one and that every id and offset stays inside it.
+bool SetView (LedgerCache & c, const char * data, const std::size_t size) {
+  if (size < sizeof(LedgerCacheHeader)) {
+    return false;
+  }
+  const LedgerCacheHeader & h = Header(data);
+  if (std::memcmp(h.magic, kLedgerCacheMagic, 4) != 0
+      || h.version != kLedgerCacheVersion || h.byteOrder != kByteOrder
+      || h.fileSize != size
+      || ImageSize(h.persons, h.expenses, h.names, h.nameBytes, h.weights)
+         != size) {
+    return false;
+  }
+
+  const char * p = data + sizeof(LedgerCacheHeader);
+  c.persons      = h.persons;
+  c.expenses     = h.expenses;
+  c.names        = h.names;
+  c.incomes      = reinterpret_cast<const double *>(p);
+  c.costs        = c.incomes + c.persons;
+  c.weights      = c.costs + c.expenses;
+  c.personNames  = reinterpret_cast<const uint32_t *>(c.weights + h.weights);
+  c.expenseNames = c.personNames + c.persons;
+  c.policies     = c.expenseNames + c.expenses;
+  c.nameOffsets  = c.policies + c.expenses;
+  c.nameBytes    = reinterpret_cast<const char *>(c.nameOffsets + c.names + 1);
+
+  bool valid = c.nameOffsets[0] == 0 && c.nameOffsets[c.names] == h.nameBytes;
+  for (uint32_t k = 0; k < c.names; ++k) {
+    valid &= c.nameOffsets[k] <= c.nameOffsets[k + 1];
+  }
+  for (uint32_t k = 0; k < c.persons + c.expenses; ++k) {
+    valid &= c.personNames[k] < c.names;  // runs on into expenseNames
+  }
+  uint64_t weights = 0;
+  for (uint32_t i = 0; i < c.expenses; ++i) {
+    valid   &= c.policies[i] <= PolicyFixed;
+    weights += HasWeights(c.policies[i]) ? c.persons : 0;
+  }
+  return valid && weights == h.weights;
+}
+
+// Writes the cache of h, with the names interned, into image.
+void BuildImage (const Household & h, const struct stat & source,
+                 const uint64_t hash, std::vector<uint64_t> & image) {
+  Arena     arena;
+  NameTable table;
+  InitArena(arena, kArenaBlockBytes);
+  InitNameTable(table);
+
+  const std::size_t     n = h.persons.size();
+  const std::size_t     e = h.expenses.size();
+  std::vector<uint32_t> ids(n + 2*e);
+  uint64_t              weights = 0;
+  for (std::size_t j = 0; j < n; ++j) {
+    ids[j] = InternName(table, arena, h.persons[j].name);
+  }
+  for (std::size_t i = 0; i < e; ++i) {
+    ids[n + i]     = InternName(table, arena, h.expenses[i].name);
+    ids[n + e + i] = h.expenses[i].policy;
+    weights       += HasWeights(h.expenses[i].policy) ? n : 0;
+  }
+
+  std::vector<uint32_t> offsets(table.names.size() + 1, 0);
+  for (std::size_t k = 0; k < table.names.size(); ++k) {
+    offsets[k + 1] = offsets[k] + static_cast<uint32_t>(table.names[k].size());
+  }
+
+  LedgerCacheHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kLedgerCacheMagic, 4);
+  header.version     = kLedgerCacheVersion;
+  header.byteOrder   = kByteOrder;
+  header.persons     = static_cast<uint32_t>(n);
+  header.expenses    = static_cast<uint32_t>(e);
+  header.names       = static_cast<uint32_t>(table.names.size());
+  header.sourceSize  = static_cast<uint64_t>(source.st_size);
+  header.sourceMtime = MtimeNs(source);
+  header.sourceHash  = hash;
+  header.nameBytes   = offsets.back();
+  header.weights     = weights;
+  header.fileSize    = ImageSize(n, e, header.names, header.nameBytes,
+                                 weights);
+
+  image.assign((header.fileSize + 7)/8, 0);
+  char * p = reinterpret_cast<char *>(image.data());
+  std::memcpy(p, &header, sizeof(header));
+  p += sizeof(header);
+  for (std::size_t j = 0; j < n; ++j, p += sizeof(double)) {
+    std::memcpy(p, &h.persons[j].income, sizeof(double));
+  }
+  for (std::size_t i = 0; i < e; ++i, p += sizeof(double)) {
+    std::memcpy(p, &h.expenses[i].cost, sizeof(double));
+  }
+  for (std::size_t i = 0; i < e; ++i) {
+    if (HasWeights(h.expenses[i].policy)) {
+      std::memcpy(p, h.expenses[i].weights.data(), n*sizeof(double));
+      p += n*sizeof(double);
+    }
+  }
+  std::memcpy(p, ids.data(), ids.size()*sizeof(uint32_t));
+  p += ids.size()*sizeof(uint32_t);
+  std::memcpy(p, offsets.data(), offsets.size()*sizeof(uint32_t));
+  p += offsets.size()*sizeof(uint32_t);
+  for (std::size_t k = 0; k < table.names.size(); ++k) {
+    std::memcpy(p, table.names[k].data(), table.names[k].size());
+    p += table.names[k].size();
+  }
+}
+
+// Writes size bytes to a temporary file that replaces fileName at once,
+// so that no run sees half a cache.
+bool WriteFileAtomically (const std::string & fileName, const char * data,
+                          std::size_t size) {
+  std::string temporary = fileName + ".XXXXXX";
+  const int fd = mkstemp(&temporary[0]);
+  if (fd < 0) {
+    return false;
+  }
+  fchmod(fd, 0644); // mkstemp creates it readable only by the owner
+
+  bool ok = true;
+  while (ok && size > 0) {
+    const ssize_t written = write(fd, data, size);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    ok    = written > 0;
+    data += ok ? written : 0;
+    size -= ok ? static_cast<std::size_t>(written) : 0;
+  }
+  ok = (close(fd) == 0) && ok;
+  ok = ok && std::rename(temporary.c_str(), fileName.c_str()) == 0;
+  if (!ok) {
+    unlink(temporary.c_str());
+  }
+  return ok;
+}
+
+// records the new mtime of the settings file in the cache, which also
+// makes the cache newer than it
+void UpdateMtime (const std::string & cacheFileName, const int64_t mtime) {
+  const int fd = open(cacheFileName.c_str(), O_WRONLY);
+  if (fd < 0) {
+    return;
+  }
+  const ssize_t written = pwrite(fd, &mtime, sizeof(mtime),
+                                 offsetof(LedgerCacheHeader, sourceMtime));
+  static_cast<void>(written); // the cache is only hashed again next time
+  close(fd);
+}
+}  // -----  end of namespace  -----
+
+// e.g. settings.ini.cache
+std::string LedgerCacheFileName (const std::string & iniFileName) {
+  return iniFileName + ".cache";
+}   // -----  end of function LedgerCacheFileName  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  OpenLedgerCache
+//  Description:  Makes c a view of the ledger in the settings file
+//                iniFileName. The cache next to it is mapped if it still
+//                belongs to the file; otherwise the file is parsed and
+//                the cache written again. result tells which happened.
+//                Returns false, with the reason in error, if the settings
+//                file can not be read or parsed.
+// =========================================================================
+bool OpenLedgerCache (const std::string & iniFileName, LedgerCache & c,
+                      LedgerCacheResult & result, std::string & error) {
+  c.file.data = NULL;
+  c.file.size = 0;
+  c.image.clear();
+
+  struct stat source;
+  if (stat(iniFileName.c_str(), &source) != 0) {
+    error = "Could not open file " + iniFileName + ": " + std::strerror(errno);
+    return false;
+  }
+
+  const std::string cacheFileName = LedgerCacheFileName(iniFileName);
+  struct stat       cacheStat;
+  if (stat(cacheFileName.c_str(), &cacheStat) == 0
+      && MapFile(cacheFileName, c.file)) {
+    if (SetView(c, c.file.data, c.file.size)) {
+      // An mtime not older than the cache may be shared by a change
+      // made right after the cache was written, within one tick of the
+      // file system clock, so it only counts with the same hash.
+      const LedgerCacheHeader & h = Header(c.file.data);
+      if (h.sourceSize == static_cast<uint64_t>(source.st_size)
+          && h.sourceMtime == MtimeNs(source)
+          && MtimeNs(source) < MtimeNs(cacheStat)) {
+        result = CacheHit;
+        return true;
+      }
+
+      MappedFile text;
+      if (h.sourceSize == static_cast<uint64_t>(source.st_size)
+          && MapFile(iniFileName, text)) {
+        const bool same = HashBytes(text.data, text.size) == h.sourceHash;
+        UnmapFile(text);
+        if (same) {
+          UpdateMtime(cacheFileName, MtimeNs(source));
+          result = CacheHashHit;
+          return true;
+        }
+      }
+    }  // -----  end if  -----
+    UnmapFile(c.file);
+  }  // -----  end if  -----
+
+  MappedFile text;
+  if (!MapFile(iniFileName, text)) {
+    error = "Could not map file " + iniFileName + ": " + std::strerror(errno);
+    return false;
+  }
+  Household h;
+  if (!ParseHouseholdText(std::string_view(text.data, text.size),
+                          iniFileName, h, error)) {
+    UnmapFile(text);
+    return false;
+  }
+  BuildImage(h, source, HashBytes(text.data, text.size), c.image);
+  UnmapFile(text);
+
+  const char *      image = reinterpret_cast<const char *>(c.image.data());
+  const std::size_t size  = Header(image).fileSize;
+  SetView(c, image, size);
+  result = WriteFileAtomically(cacheFileName, image, size) ? CacheRebuilt
+                                                           : CacheInMemory;
+  return true;
+}   // -----  end of function OpenLedgerCache  -----
+
+void CloseLedgerCache (LedgerCache & c) {
+  UnmapFile(c.file);
+  std::vector<uint64_t>().swap(c.image);
+}   // -----  end of function CloseLedgerCache  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ExpandCachedHousehold
+//  Description:  Copies the ledger of c into h, for the functions that
+//                work on Person and Expense records.
+// =========================================================================
+void ExpandCachedHousehold (const LedgerCache & c, Household & h) {
+  h.persons.resize(c.persons);
+  h.expenses.resize(c.expenses);
+  for (uint32_t j = 0; j < c.persons; ++j) {
+    h.persons[j].name.assign(CachedName(c, c.personNames[j]));
+    h.persons[j].income = c.incomes[j];
+  }
+  const double * weights = c.weights;
+  for (uint32_t i = 0; i < c.expenses; ++i) {
+    h.expenses[i].name.assign(CachedName(c, c.expenseNames[i]));
+    h.expenses[i].cost   = c.costs[i];
+    h.expenses[i].policy = static_cast<ExpensePolicy>(c.policies[i]);
+    h.expenses[i].weights.clear();
+    if (HasWeights(c.policies[i])) {
+      h.expenses[i].weights.assign(weights, weights + c.persons);
+      weights += c.persons;
+    }
+  }
+}   // -----  end of function ExpandCachedHousehold  -----
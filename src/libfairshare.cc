@@ -0,0 +1,212 @@
+//
+// =========================================================================
+//
+//       Filename:  libfairshare.cc
+//
+//    Description:  Defines the embeddable API of libfairshare on top of
+//                  the allocation kernels, the number parser and the
+//                  household reader.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 10:12:55 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>  // helper-functions.h needs it
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "household-reader.h"
+#include "helper-functions.h"
+#include "summation.h"
+#include "libfairshare.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+FairshareStatus CheckIncomes (const double * incomes,
+                              const std::size_t persons) {
+  if (persons == 0) {
+    return FairshareNoPersons;
+  }
+
+  for (std::size_t j = 0; j < persons; ++j) {
+    if (incomes[j] <= 0. && incomes[j] >= 0.) {
+      return FairshareZeroIncome;
+    }
+  }
+  const double sum = SumPairwise(incomes, persons);
+  if (sum <= 0. && sum >= 0.) {
+    return FairshareZeroSum;
+  }
+  return FairshareOk;
+}
+
+FairshareStatus CheckBuffers (const std::size_t persons,
+                              const std::size_t expenses,
+                              const std::size_t sharesSize,
+                              const std::size_t totalsSize) {
+  const std::size_t kMax = std::numeric_limits<std::size_t>::max();
+  if ((expenses > 0 && persons > kMax/expenses)
+      || sharesSize < persons*expenses || totalsSize < persons) {
+    return FairshareBufferTooSmall;
+  }
+  return FairshareOk;
+}
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  FairshareSplit
+//  Description:  Writes the share of every person of every expense into
+//                shares and the sum of every row into totals, like
+//                Allocate, but on the arrays of the caller.
+// =========================================================================
+FairshareStatus FairshareSplit (const double * incomes,
+                                const std::size_t persons,
+                                const double * costs,
+                                const std::size_t expenses,
+                                double * shares, const std::size_t sharesSize,
+                                double * totals, const std::size_t totalsSize) {
+  FairshareStatus status = CheckIncomes(incomes, persons);
+  if (status == FairshareOk) {
+    status = CheckBuffers(persons, expenses, sharesSize, totalsSize);
+  }
+  if (status != FairshareOk) {
+    return status;
+  }
+
+  AllocateShares(incomes, persons, costs, expenses, shares, totals);
+  return FairshareOk;
+}   // -----  end of function FairshareSplit  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  FairshareCentsScratch
+//  Description:  Returns the number of integers FairshareSplitCents needs
+//                as scratch: the amounts in cents and the scratch arrays
+//                of AllocateCents.
+// =========================================================================
+std::size_t FairshareCentsScratch (const std::size_t persons,
+                                   const std::size_t expenses) {
+  return persons*expenses + expenses + 2*persons
+         + AllocateCentsScratch(persons);
+}   // -----  end of function FairshareCentsScratch  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  FairshareSplitCents
+//  Description:  Like FairshareSplit, but rounds all amounts to cents and
+//                splits with AllocateCents, so that the shares of every
+//                expense add up to its cost exactly. scratch holds at
+//                least FairshareCentsScratch(persons, expenses) integers.
+// =========================================================================
+FairshareStatus FairshareSplitCents (const double * incomes,
+                                     const std::size_t persons,
+                                     const double * costs,
+                                     const std::size_t expenses,
+                                     double * shares,
+                                     const std::size_t sharesSize,
+                                     double * totals,
+                                     const std::size_t totalsSize,
+                                     int64_t * scratch,
+                                     const std::size_t scratchSize) {
+  FairshareStatus status = CheckIncomes(incomes, persons);
+  if (status == FairshareOk) {
+    status = CheckBuffers(persons, expenses, sharesSize, totalsSize);
+  }
+  if (status == FairshareOk
+      && scratchSize < FairshareCentsScratch(persons, expenses)) {
+    status = FairshareBufferTooSmall;
+  }
+  if (status != FairshareOk) {
+    return status;
+  }
+
+  int64_t *  centIncomes = scratch;
+  int64_t *  centCosts   = centIncomes + persons;
+  int64_t *  centShares  = centCosts + expenses;
+  int64_t *  centTotals  = centShares + persons*expenses;
+  uint64_t * centScratch = reinterpret_cast<uint64_t *>(centTotals + persons);
+
+  for (std::size_t j = 0; j < persons; ++j) {
+    centIncomes[j] = ToCents(incomes[j]);
+    if (centIncomes[j] < 0) {
+      return FairshareNegativeIncome;
+    }
+  }
+  for (std::size_t i = 0; i < expenses; ++i) {
+    centCosts[i] = ToCents(costs[i]);
+  }
+
+  // all incomes are below half a cent
+  if (!AllocateCents(centIncomes, persons, centCosts, expenses, centShares,
+                     centTotals, centScratch)) {
+    return FairshareZeroSum;
+  }
+
+  for (std::size_t k = 0; k < persons*expenses; ++k) {
+    shares[k] = static_cast<double>(centShares[k])/100.;
+  }
+  for (std::size_t j = 0; j < persons; ++j) {
+    totals[j] = static_cast<double>(centTotals[j])/100.;
+  }
+  return FairshareOk;
+}   // -----  end of function FairshareSplitCents  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  FairshareParseAmount
+//  Description:  Converts all size characters of text with ParseDouble.
+//                amount is only set on success.
+// =========================================================================
+FairshareStatus FairshareParseAmount (const char * text,
+                                      const std::size_t size,
+                                      double & amount) {
+  const Conversion c = ParseDouble(std::string_view(text, size));
+  switch (c.error) {
+    case ConversionOk:
+      amount = c.value;
+      return FairshareOk;
+    case ConversionEmpty:      return FairshareEmptyNumber;
+    case ConversionInvalid:    return FairshareInvalidNumber;
+    case ConversionOutOfRange: return FairshareNumberOutOfRange;
+    default:                   return FairshareInvalidNumber;
+  }  // -----  end switch  -----
+}   // -----  end of function FairshareParseAmount  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  FairshareLoadHousehold
+//  Description:  Reads a settings file into h with LoadHouseholdFile; on
+//                failure error tells the file, line and column.
+// =========================================================================
+FairshareStatus FairshareLoadHousehold (const std::string & fileName,
+                                        Household & h, std::string & error) {
+  return LoadHouseholdFile(fileName, h, error) ? FairshareOk
+                                               : FairshareReadError;
+}   // -----  end of function FairshareLoadHousehold  -----
+
+const char * FairshareStatusMessage (const FairshareStatus status) {
+  switch (status) {
+    case FairshareOk:               return "No error.";
+    case FairshareNoPersons:        return "There is nobody to split the expenses between.";
+    case FairshareZeroIncome:       return "Incomes have to be non zero.";
+    case FairshareZeroSum:          return "The incomes add up to zero.";
+    case FairshareNegativeIncome:   return "Splitting in cents needs non negative incomes.";
+    case FairshareBufferTooSmall:   return "A buffer for the results is too small.";
+    case FairshareEmptyNumber:      return ConversionErrorMessage(ConversionEmpty);
+    case FairshareInvalidNumber:    return ConversionErrorMessage(ConversionInvalid);
+    case FairshareNumberOutOfRange: return ConversionErrorMessage(ConversionOutOfRange);
+    case FairshareReadError:        return "The file could not be read.";
+    default:                        return "Unknown error.";
+  }  // -----  end switch  -----
+}   // -----  end of function FairshareStatusMessage  -----
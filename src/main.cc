@@ -0,0 +1,107 @@
+//
+// =========================================================================
+//
+//       Filename:  main.cc
+//
+//    Description:  The main program of fairshare. Everything else lives
+//                  in fairshare.cc and the other sources, so that the
+//                  benchmarks can link all of it without a second main.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 09:31:40 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//          Usage:  ./fairshare [options], see ./fairshare --help
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        License:  GNU General Public License
+//      Copyright:  Copyright (c) 2015, Frank Milde
+// =========================================================================
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "output-writer.h"
+#include "server.h"
+#include "stats.h"
+#include "fairshare.h"
+#include "helper-functions.h"
+#include "global-constants.h"
+
+// =========================================================================
+//   Main
+// =========================================================================
+int main(int argc, char *argv[]) {
+
+//  if (IniFileExists(kIniFileName)) {
+//    ParseIniFile(kIniFileName);
+//  } else {
+//    CreateIniFile(kIniFileName);
+//  }  // -----  end if-else  ----- 
+
+  GetArgsToMain(argc, argv);
+  if (!options.statsFileName.empty()) {
+    std::atexit(WriteStatsAtExit);
+  }  // -----  end if  ----- 
+
+  if (!options.batchFileName.empty()) {
+    RunBatch(options.batchFileName, false, std::cout);
+    return EXIT_SUCCESS;
+  }  // -----  end if  ----- 
+
+  if (!options.treeFileName.empty()) {
+    RunGroupTree(options.treeFileName, std::cout);
+    return EXIT_SUCCESS;
+  }  // -----  end if  ----- 
+
+  if (!options.seriesFileName.empty()) {
+    RunBatch(options.seriesFileName, true, std::cout);
+    return EXIT_SUCCESS;
+  }  // -----  end if  ----- 
+
+  if (!options.socketPath.empty()) {
+    CheckFileExistsOrExit(kIniFileName);
+    return Serve(options.socketPath, kIniFileName, options.cents,
+                 options.format);
+  }  // -----  end if  ----- 
+
+  ParseIniFile(kIniFileName);
+  ApplyIncomeOverridesOrExit(persons, options.incomes);
+
+  if (!options.transactionFileName.empty()) {
+    IngestTransactionsOrExit(options.transactionFileName,
+                             options.rulesFileName, expenses);
+  }  // -----  end if  ----- 
+
+  if (!options.sweeps.empty()) {
+    RunSweep(persons, expenses, std::cout);
+    return EXIT_SUCCESS;
+  }  // -----  end if  ----- 
+
+  CheckIncomeIsNonZeroOrExit(persons);
+
+  if (!options.settleFileName.empty()) {
+    RunSettlement(options.settleFileName, persons, expenses, std::cout);
+    return EXIT_SUCCESS;
+  }  // -----  end if  ----- 
+  
+  Allocation allocation;
+  AllocateOrExit(persons, expenses, allocation);
+
+  {
+    PhaseTimer   timer(PhaseOutput);
+    OutputWriter writer;
+    InitOutputWriter(writer, std::cout, options.format, false);
+    WriteHousehold(writer, persons, expenses, allocation);
+    FinishOutputWriter(writer);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,203 @@
+//
+// =========================================================================
+//
+//       Filename:  name-table.cc
+//
+//    Description:  Defines the name interning table.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 10:48:21 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>   // memcmp, memcpy
+#include <string_view>
+#include <vector>
+
+#include "arena.h"
+#include "name-table.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+const std::size_t kInitialSlots = 64;
+
+// eight bytes at a time, each word mixed in by a multiply and a shift,
+// the tail as one shorter word, loaded at once if the name has eight
+// bytes to read it from; FNV-1a took a multiply per byte, which showed
+// in the scan of bank statements
+uint32_t HashName (const std::string_view name) {
+  const uint64_t kMultiplier = 0x9e3779b97f4a7c15ull;
+  const char *   p           = name.data();
+  std::size_t    n           = name.size();
+  uint64_t       h           = n*kMultiplier;
+  for (; n >= 8; p += 8, n -= 8) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    h  = (h ^ word)*kMultiplier;
+    h ^= h >> 29;
+  }
+  if (n > 0 && name.size() >= 8) {
+    // the last eight bytes of the name, shifted down to the tail
+    uint64_t word;
+    std::memcpy(&word, p + n - 8, sizeof(word));
+    word >>= 8*(8 - n);
+    h  = (h ^ word)*kMultiplier;
+    h ^= h >> 29;
+  } else if (n > 0) {
+    uint64_t word = 0;
+    for (std::size_t k = 0; k < n; ++k) {
+      word |= static_cast<uint64_t>(static_cast<unsigned char>(p[k])) << 8*k;
+    }
+    h  = (h ^ word)*kMultiplier;
+    h ^= h >> 29;
+  }
+  return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+// the bytes of a and b compared a word at a time, the last word
+// overlapping the one before as in HashName; a call of memcmp took as
+// long as the rest of a lookup
+bool SameName (const std::string_view a, const std::string_view b) {
+  const std::size_t n = a.size();
+  if (n != b.size()) {
+    return false;
+  }
+  if (n < 8) {
+    return std::memcmp(a.data(), b.data(), n) == 0;
+  }
+  uint64_t differ = 0;
+  uint64_t x;
+  uint64_t y;
+  for (std::size_t k = 0; k + 8 <= n; k += 8) {
+    std::memcpy(&x, a.data() + k, sizeof(x));
+    std::memcpy(&y, b.data() + k, sizeof(y));
+    differ |= x ^ y;
+  }
+  std::memcpy(&x, a.data() + n - 8, sizeof(x));
+  std::memcpy(&y, b.data() + n - 8, sizeof(y));
+  return (differ | (x ^ y)) == 0;
+}
+
+void Insert (NameTable & t, const uint32_t hash, const uint32_t id) {
+  const std::size_t mask = t.slots.size() - 1;
+  std::size_t       k    = hash & mask;
+  while (t.slots[k].generation == t.generation) {
+    k = (k + 1) & mask;
+  }
+  t.slots[k].hash       = hash;
+  t.slots[k].id         = id;
+  t.slots[k].generation = t.generation;
+}
+
+// doubles the slots and inserts all names again
+void Grow (NameTable & t) {
+  t.slots.assign(2*t.slots.size(), NameSlot());
+  t.generation = 1;
+  for (std::size_t id = 0; id < t.names.size(); ++id) {
+    Insert(t, HashName(t.names[id]), static_cast<uint32_t>(id));
+  }
+}
+
+// sets id to the one of name, hashed to hash, if it is in t
+bool Lookup (const NameTable & t, const uint32_t hash,
+             const std::string_view name, uint32_t & id) {
+  const std::size_t mask = t.slots.size() - 1;
+  for (std::size_t k = hash & mask; t.slots[k].generation == t.generation;
+       k = (k + 1) & mask) {
+    const NameSlot & s = t.slots[k];
+    if (s.hash == hash && SameName(t.names[s.id], name)) {
+      id = s.id;
+      return true;
+    }
+  }  // -----  end for  -----
+  return false;
+}
+
+// name with the next free id, its bytes already where they stay
+uint32_t Add (NameTable & t, const uint32_t hash, const std::string_view name) {
+  const uint32_t id = static_cast<uint32_t>(t.names.size());
+  t.names.push_back(name);
+  if (2*t.names.size() > t.slots.size()) {
+    Grow(t);
+  } else {
+    Insert(t, hash, id);
+  }
+  return id;
+}
+}  // -----  end of namespace  -----
+
+void InitNameTable (NameTable & t) {
+  t.slots.assign(kInitialSlots, NameSlot());
+  t.names.clear();
+  t.generation = 1;  // the slots start at generation 0, i.e. empty
+}   // -----  end of function InitNameTable  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  InternName
+//  Description:  Returns the id of name, adding it with the next free id
+//                and a copy of its bytes in a if it is new. Ids count
+//                from 0 in the order the names were first seen.
+// =========================================================================
+uint32_t InternName (NameTable & t, Arena & a, const std::string_view name) {
+  const uint32_t hash = HashName(name);
+  uint32_t       id;
+  if (Lookup(t, hash, name, id)) {
+    return id;
+  }
+  char * bytes = ArenaArray<char>(a, name.size());
+  if (!name.empty()) {
+    std::memcpy(bytes, name.data(), name.size());
+  }
+  return Add(t, hash, std::string_view(bytes, name.size()));
+}   // -----  end of function InternName  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  InternView
+//  Description:  Like InternName, but keeps name itself instead of a
+//                copy, for names that stay valid until the table is
+//                reset, e.g. views into a mapped file.
+// =========================================================================
+uint32_t InternView (NameTable & t, const std::string_view name) {
+  const uint32_t hash = HashName(name);
+  uint32_t       id;
+  if (Lookup(t, hash, name, id)) {
+    return id;
+  }
+  return Add(t, hash, name);
+}   // -----  end of function InternView  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  FindName
+//  Description:  Sets id to the id of name and returns true if name has
+//                been interned, without adding it otherwise.
+// =========================================================================
+bool FindName (const NameTable & t, const std::string_view name,
+               uint32_t & id) {
+  return Lookup(t, HashName(name), name, id);
+}   // -----  end of function FindName  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ResetNameTable
+//  Description:  Forgets all names in O(1), by moving on to the next
+//                generation of slots. The bytes of the names belong to
+//                the arena and go with its reset, or to the caller of
+//                InternView.
+// =========================================================================
+void ResetNameTable (NameTable & t) {
+  t.names.clear();
+  if (++t.generation == 0) {
+    // all 2^32 generations used, start again on cleared slots
+    t.slots.assign(t.slots.size(), NameSlot());
+    t.generation = 1;
+  }
+}   // -----  end of function ResetNameTable  -----
@@ -0,0 +1,234 @@
+//
+// =========================================================================
+//
+//       Filename:  output-series.cc
+//
+//    Description:  Writes a time series period by period, see
+//                  StartSeriesHousehold.
+//
+//        Version:  1.0
+//        Created:  10/20/2026 02:14:37 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <algorithm> // max
+#include <charconv>  // to_chars
+#include <cmath>     // fabs
+#include <cstddef>
+#include <cstdint>
+#include <cstring>   // strlen
+#include <string>
+
+#include "table-renderer.h"
+#include "time-series.h"
+#include "output-writer.h"
+#include "output-primitives.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+const char kPeriodHeader[] = "Period";
+const char kTotalHeader[]  = "Total";
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  InitSeriesWriter
+//  Description:  Prepares w to write series households to os, see
+//                StartSeriesHousehold. The CSV and NDJSON rows have the
+//                columns of WriteHousehold plus the period, counted from
+//                1, and the running total of the amount up to and
+//                including that period. The binary format has no series
+//                layout.
+// =========================================================================
+void InitSeriesWriter (OutputWriter & w, std::ostream & os,
+                       const OutputFormat format) {
+  InitOutputWriter(w, os, format, true);
+  if (format == OutputCsv) {
+    w.buffer.assign("household,period,person_id,person,expense_id,expense,"
+                    "amount,cumulative\n");
+  }
+}   // -----  end of function InitSeriesWriter  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  StartSeriesHousehold
+//  Description:  Begins the next series household: formats the expense
+//                columns once for all its periods or, for the table,
+//                writes the header with one column per person. The
+//                periods follow with WriteSeriesPeriod and the household
+//                ends with FinishSeriesHousehold, so the rows are written
+//                while the engine walks the periods.
+// =========================================================================
+void StartSeriesHousehold (OutputWriter & w, const TimeSeries & ts) {
+  ++w.households;
+  w.fields.clear();
+  w.fieldEnds.clear();
+
+  switch (w.format) {
+    case OutputCsv:
+      for (std::size_t i = 0; i < SeriesExpenses(ts); ++i) {
+        AppendNumber(w.fields, static_cast<uint64_t>(i + 1));
+        w.fields.push_back(',');
+        AppendCsvField(w.fields, ts.expenseNames[i]);
+        w.fields.push_back(',');
+        w.fieldEnds.push_back(w.fields.size());
+      }
+      break;
+
+    case OutputNdjson:
+      for (std::size_t i = 0; i < SeriesExpenses(ts); ++i) {
+        w.fields.append(",\"expense_id\":");
+        AppendNumber(w.fields, static_cast<uint64_t>(i + 1));
+        w.fields.append(",\"expense\":");
+        AppendJsonString(w.fields, ts.expenseNames[i]);
+        w.fields.append(",\"amount\":");
+        w.fieldEnds.push_back(w.fields.size());
+      }
+      break;
+
+    case OutputTable:
+    case OutputBinary:
+    default: {
+      // wide enough for the running total of all costs, which bounds
+      // every cell as long as no income is negative
+      double sumCosts = 0.;
+      for (std::size_t k = 0; k < ts.costs.size(); ++k) {
+        sumCosts += std::fabs(ts.costs[k]);
+      }
+      char number[320];
+      w.width = std::max(std::strlen(kPeriodHeader),
+                         FormatFixed2(-sumCosts, number,
+                                      number + sizeof(number)));
+      for (std::size_t j = 0; j < SeriesPersons(ts); ++j) {
+        w.width = std::max(w.width, ts.personNames[j].size());
+      }
+
+      w.buffer.append("\nHousehold ");
+      AppendNumber(w.buffer, w.households);
+      w.buffer.append(":\n");
+      AppendCell(w.buffer, kPeriodHeader, std::strlen(kPeriodHeader),
+                 w.width, " ");
+      for (std::size_t j = 0; j < SeriesPersons(ts); ++j) {
+        AppendCell(w.buffer, ts.personNames[j].data(),
+                   ts.personNames[j].size(), w.width, " | ");
+      }
+      w.buffer.push_back('\n');
+      AppendRule(w.buffer, w.width, SeriesPersons(ts));
+      break;
+    }
+  }  // -----  end switch  -----
+}   // -----  end of function StartSeriesHousehold  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  WriteSeriesPeriod
+//  Description:  Writes the period NextPeriod just split into state: one
+//                row per person and expense or, for the table, one line
+//                with the total of every person in that period.
+// =========================================================================
+void WriteSeriesPeriod (OutputWriter & w, const TimeSeries & ts,
+                        const SeriesState & state) {
+  const std::size_t n = SeriesPersons(ts);
+  const std::size_t m = SeriesExpenses(ts);
+
+  switch (w.format) {
+    case OutputCsv:
+      for (std::size_t j = 0; j < n; ++j) {
+        w.row.clear();
+        AppendNumber(w.row, w.households);
+        w.row.push_back(',');
+        AppendNumber(w.row, static_cast<uint64_t>(state.period));
+        w.row.push_back(',');
+        AppendNumber(w.row, static_cast<uint64_t>(j + 1));
+        w.row.push_back(',');
+        AppendCsvField(w.row, ts.personNames[j]);
+        w.row.push_back(',');
+
+        std::size_t begin = 0;
+        for (std::size_t i = 0; i < m; ++i) {
+          w.buffer.append(w.row);
+          w.buffer.append(w.fields, begin, w.fieldEnds[i] - begin);
+          AppendNumber(w.buffer, state.shares[j*m + i]);
+          w.buffer.push_back(',');
+          AppendNumber(w.buffer, state.cumulative[j*m + i]);
+          w.buffer.push_back('\n');
+          FlushIfFull(w);
+          begin = w.fieldEnds[i];
+        }  // -----  end for expenses  -----
+      }  // -----  end for persons  -----
+      break;
+
+    case OutputNdjson:
+      for (std::size_t j = 0; j < n; ++j) {
+        w.row.clear();
+        w.row.append("{\"household\":");
+        AppendNumber(w.row, w.households);
+        w.row.append(",\"period\":");
+        AppendNumber(w.row, static_cast<uint64_t>(state.period));
+        w.row.append(",\"person_id\":");
+        AppendNumber(w.row, static_cast<uint64_t>(j + 1));
+        w.row.append(",\"person\":");
+        AppendJsonString(w.row, ts.personNames[j]);
+
+        std::size_t begin = 0;
+        for (std::size_t i = 0; i < m; ++i) {
+          w.buffer.append(w.row);
+          w.buffer.append(w.fields, begin, w.fieldEnds[i] - begin);
+          AppendJsonNumber(w.buffer, state.shares[j*m + i]);
+          w.buffer.append(",\"cumulative\":");
+          AppendJsonNumber(w.buffer, state.cumulative[j*m + i]);
+          w.buffer.append("}\n");
+          FlushIfFull(w);
+          begin = w.fieldEnds[i];
+        }  // -----  end for expenses  -----
+      }  // -----  end for persons  -----
+      break;
+
+    case OutputTable:
+    case OutputBinary:
+    default: {
+      char number[320];
+      const std::size_t length = static_cast<std::size_t>(
+        std::to_chars(number, number + sizeof(number),
+                      static_cast<uint64_t>(state.period)).ptr - number);
+      AppendCell(w.buffer, number, length, w.width, " ");
+      for (std::size_t j = 0; j < n; ++j) {
+        AppendCell(w.buffer, number,
+                   FormatFixed2(state.totals[j], number,
+                                number + sizeof(number)),
+                   w.width, " | ");
+      }
+      w.buffer.push_back('\n');
+      FlushIfFull(w);
+      break;
+    }
+  }  // -----  end switch  -----
+}   // -----  end of function WriteSeriesPeriod  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  FinishSeriesHousehold
+//  Description:  Ends the household; the table gets a last line with the
+//                running total of every person over all periods.
+// =========================================================================
+void FinishSeriesHousehold (OutputWriter & w, const TimeSeries & ts,
+                            const SeriesState & state) {
+  if (w.format != OutputTable) {
+    return;
+  }
+  AppendRule(w.buffer, w.width, SeriesPersons(ts));
+  AppendCell(w.buffer, kTotalHeader, std::strlen(kTotalHeader), w.width, " ");
+  char number[320];
+  for (std::size_t j = 0; j < SeriesPersons(ts); ++j) {
+    AppendCell(w.buffer, number,
+               FormatFixed2(state.cumulativeTotals[j], number,
+                            number + sizeof(number)),
+               w.width, " | ");
+  }
+  w.buffer.push_back('\n');
+  FlushIfFull(w);
+}   // -----  end of function FinishSeriesHousehold  -----
@@ -0,0 +1,170 @@
+//
+// =========================================================================
+//
+//       Filename:  output-settlement.cc
+//
+//    Description:  Writes the transfers of a settlement, see WriteSettlement.
+//
+//        Version:  1.0
+//        Created:  10/20/2026 02:17:25 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <algorithm> // max
+#include <cstddef>
+#include <cstdint>
+#include <cstring>   // strlen
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "table-renderer.h"
+#include "settlement.h"
+#include "output-writer.h"
+#include "output-primitives.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+// the columns of the balances of a settlement after the name
+const char * const kBalanceHeaders[] = { "Paid", "Fair share", "Balance" };
+const std::size_t  kBalanceColumns   = 3;
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  InitSettlementWriter
+//  Description:  Prepares w to write a settlement to os, see
+//                WriteSettlement.
+// =========================================================================
+void InitSettlementWriter (OutputWriter & w, std::ostream & os,
+                           const OutputFormat format) {
+  InitOutputWriter(w, os, format, false);
+  if (format == OutputCsv) {
+    w.buffer.assign("from_id,from,to_id,to,amount\n");
+  }
+}   // -----  end of function InitSettlementWriter  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  WriteSettlement
+//  Description:  Writes the transfers of s after PlanTransfers. CSV and
+//                NDJSON have one row per transfer: who pays whom, both
+//                counted from 1, and how much. The table first lists
+//                what every person paid, its fair share and its balance,
+//                then the transfers.
+// =========================================================================
+void WriteSettlement (OutputWriter & w, const std::vector<Person> & p,
+                      const Settlement & s) {
+  char number[320];
+
+  switch (w.format) {
+    case OutputCsv:
+    case OutputNdjson:
+      for (std::size_t k = 0; k < s.transfers.size(); ++k) {
+        const Transfer & t = s.transfers[k];
+        if (w.format == OutputCsv) {
+          AppendNumber(w.buffer, static_cast<uint64_t>(t.from) + 1);
+          w.buffer.push_back(',');
+          AppendCsvField(w.buffer, p[t.from].name);
+          w.buffer.push_back(',');
+          AppendNumber(w.buffer, static_cast<uint64_t>(t.to) + 1);
+          w.buffer.push_back(',');
+          AppendCsvField(w.buffer, p[t.to].name);
+          w.buffer.push_back(',');
+          AppendCents(w.buffer, t.cents);
+          w.buffer.push_back('\n');
+        } else {
+          w.buffer.append("{\"from_id\":");
+          AppendNumber(w.buffer, static_cast<uint64_t>(t.from) + 1);
+          w.buffer.append(",\"from\":");
+          AppendJsonString(w.buffer, p[t.from].name);
+          w.buffer.append(",\"to_id\":");
+          AppendNumber(w.buffer, static_cast<uint64_t>(t.to) + 1);
+          w.buffer.append(",\"to\":");
+          AppendJsonString(w.buffer, p[t.to].name);
+          w.buffer.append(",\"amount\":");
+          AppendCents(w.buffer, t.cents);
+          w.buffer.append("}\n");
+        }
+        FlushIfFull(w);
+      }  // -----  end for  -----
+      break;
+
+    case OutputTable:
+    case OutputBinary:
+    default: {
+      // every amount is bounded by the sum of all payments and shares
+      const char  kNameHeader[] = "Person";
+      std::size_t nameWidth     = sizeof(kNameHeader) - 1;
+      int64_t     bound         = 0;
+      for (std::size_t j = 0; j < p.size(); ++j) {
+        nameWidth = std::max(nameWidth, p[j].name.size());
+        bound    += (s.paid[j] < 0 ? -s.paid[j] : s.paid[j])
+                    + (s.owed[j] < 0 ? -s.owed[j] : s.owed[j]);
+      }
+      w.width = FormatFixed2(-static_cast<double>(bound)/100., number,
+                             number + sizeof(number));
+      for (std::size_t c = 0; c < kBalanceColumns; ++c) {
+        w.width = std::max(w.width, std::strlen(kBalanceHeaders[c]));
+      }
+
+      w.buffer.push_back(' ');
+      w.buffer.append(kNameHeader);
+      w.buffer.append(nameWidth - (sizeof(kNameHeader) - 1), ' ');
+      for (std::size_t c = 0; c < kBalanceColumns; ++c) {
+        AppendCell(w.buffer, kBalanceHeaders[c],
+                   std::strlen(kBalanceHeaders[c]), w.width, " | ");
+      }
+      w.buffer.push_back('\n');
+      w.buffer.push_back(' ');
+      w.buffer.append(nameWidth + 1, '=');
+      for (std::size_t c = 0; c < kBalanceColumns; ++c) {
+        w.buffer.push_back('+');
+        w.buffer.append(w.width + 2, '=');
+      }
+      w.buffer.push_back('\n');
+
+      for (std::size_t j = 0; j < p.size(); ++j) {
+        const int64_t amounts[] = { s.paid[j], s.owed[j], s.balances[j] };
+        w.buffer.push_back(' ');
+        w.buffer.append(p[j].name);
+        w.buffer.append(nameWidth - p[j].name.size(), ' ');
+        for (std::size_t c = 0; c < kBalanceColumns; ++c) {
+          AppendCell(w.buffer, number,
+                     FormatFixed2(static_cast<double>(amounts[c])/100.,
+                                  number, number + sizeof(number)),
+                     w.width, " | ");
+        }
+        w.buffer.push_back('\n');
+        FlushIfFull(w);
+      }  // -----  end for  -----
+
+      w.buffer.append("\n ");
+      AppendNumber(w.buffer, static_cast<uint64_t>(s.transfers.size()));
+      w.buffer.append(s.transfers.size() == 1 ? " transfer" : " transfers");
+      w.buffer.append(s.exact ? ", the fewest possible:\n" : ":\n");
+      for (std::size_t k = 0; k < s.transfers.size(); ++k) {
+        const Transfer & t = s.transfers[k];
+        w.buffer.push_back(' ');
+        w.buffer.append(p[t.from].name);
+        w.buffer.append(nameWidth - p[t.from].name.size(), ' ');
+        w.buffer.append(" pays ");
+        w.buffer.append(p[t.to].name);
+        w.buffer.append(nameWidth - p[t.to].name.size(), ' ');
+        AppendCell(w.buffer, number,
+                   FormatFixed2(static_cast<double>(t.cents)/100., number,
+                                number + sizeof(number)),
+                   w.width, " ");
+        w.buffer.push_back('\n');
+        FlushIfFull(w);
+      }  // -----  end for  -----
+      break;
+    }
+  }  // -----  end switch  -----
+}   // -----  end of function WriteSettlement  -----
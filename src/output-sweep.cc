@@ -0,0 +1,265 @@
+//
+// =========================================================================
+//
+//       Filename:  output-sweep.cc
+//
+//    Description:  Writes the scenarios of a sweep block by block, see
+//                  InitSweepWriter and WriteSweepBlock.
+//
+//        Version:  1.0
+//        Created:  10/20/2026 02:18:49 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <algorithm> // max
+#include <cstddef>
+#include <cstdint>
+#include <cstring>   // strlen
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "table-renderer.h"
+#include "sweep.h"
+#include "output-writer.h"
+#include "output-primitives.h"
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+const char     kSweepMagic[4]  = { 'F', 'S', 'S', 'W' };
+const uint32_t kSweepVersion   = 1;
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+// the header of the percent column of a sweep table with one axis
+const char kPercentHeader[] = "Percent";
+
+// the header of the column of a sweep axis, e.g. "income:Eva" or
+// "cost:rent"
+std::string SweepAxisHeader (const std::vector<Person>  & p,
+                             const std::vector<Expense> & e,
+                             const SweepAxis & a) {
+  return a.expense ? "cost:" + e[a.index].name : "income:" + p[a.index].name;
+}
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  InitSweepWriter
+//  Description:  Prepares w to write the scenarios of s to os, see
+//                WriteSweepBlock, and writes the header: the CSV columns,
+//                the binary header, see kSweepMagic, or the head of the
+//                table, which has a row per value of the axes but the
+//                last one and a column per value of the last one. A sweep
+//                of one axis has a row per value instead.
+// =========================================================================
+void InitSweepWriter (OutputWriter & w, std::ostream & os,
+                      const OutputFormat format,
+                      const std::vector<Person>  & p,
+                      const std::vector<Expense> & e, const Sweep & s) {
+  InitOutputWriter(w, os, format, false);
+  const std::size_t axes = s.axes.size();
+  char number[320];
+
+  switch (format) {
+    case OutputCsv:
+      w.buffer.assign("scenario");
+      for (std::size_t k = 0; k < axes; ++k) {
+        w.buffer.push_back(',');
+        AppendCsvField(w.buffer, SweepAxisHeader(p, e, s.axes[k]));
+      }
+      w.buffer.append(",percent");
+      for (std::size_t j = 0; j < p.size(); ++j) {
+        w.buffer.push_back(',');
+        AppendCsvField(w.buffer, p[j].name);
+      }
+      w.buffer.push_back('\n');
+      break;
+
+    case OutputBinary:
+      w.buffer.assign(kSweepMagic, sizeof(kSweepMagic));
+      PutUint32(w.buffer, kSweepVersion);
+      PutUint32(w.buffer, static_cast<uint32_t>(axes));
+      PutUint32(w.buffer, static_cast<uint32_t>(p.size()));
+      PutUint64(w.buffer, s.scenarios);
+      for (std::size_t k = 0; k < axes; ++k) {
+        const SweepAxis & a = s.axes[k];
+        PutUint32(w.buffer, a.expense ? 1 : 0);
+        PutUint32(w.buffer, static_cast<uint32_t>(a.index + 1));
+        PutDouble(w.buffer, a.start);
+        PutDouble(w.buffer, a.step);
+        PutUint64(w.buffer, a.count);
+      }
+      break;
+
+    case OutputNdjson:
+      break;
+
+    case OutputTable:
+    default: {
+      // a column per axis in front, wide enough for its first and last
+      // value, which bound the others
+      const std::size_t labels = axes > 1 ? axes - 1 : 1;
+      w.fieldEnds.assign(labels, 0);
+      for (std::size_t k = 0; k < labels; ++k) {
+        const SweepAxis & a    = s.axes[k];
+        const double      last = a.start + a.step*static_cast<double>(a.count - 1);
+        w.fieldEnds[k] = std::max(SweepAxisHeader(p, e, a).size(),
+          std::max(FormatFixed2(a.start, number, number + sizeof(number)),
+                   FormatFixed2(last, number, number + sizeof(number))));
+      }
+      w.width = sizeof(kPercentHeader) - 1;
+      if (axes > 1) {
+        const SweepAxis & a    = s.axes.back();
+        const double      last = a.start + a.step*static_cast<double>(a.count - 1);
+        w.width = std::max(FormatFixed2(a.start, number, number + sizeof(number)),
+                           FormatFixed2(last, number, number + sizeof(number)));
+        w.width = std::max(w.width, std::strlen("100.00"));
+      }
+
+      w.buffer.append(" Fair share in percent of income");
+      if (axes > 1) {
+        w.buffer.append(", columns by ");
+        w.buffer.append(SweepAxisHeader(p, e, s.axes.back()));
+      }
+      w.buffer.append(":\n\n");
+      for (std::size_t k = 0; k < labels; ++k) {
+        const std::string header = SweepAxisHeader(p, e, s.axes[k]);
+        AppendCell(w.buffer, header.data(), header.size(), w.fieldEnds[k],
+                   k == 0 ? " " : " | ");
+      }
+      if (axes > 1) {
+        const SweepAxis & a = s.axes.back();
+        for (uint64_t c = 0; c < a.count; ++c) {
+          AppendCell(w.buffer, number,
+                     FormatFixed2(a.start + a.step*static_cast<double>(c),
+                                  number, number + sizeof(number)),
+                     w.width, " | ");
+        }
+      } else {
+        AppendCell(w.buffer, kPercentHeader, sizeof(kPercentHeader) - 1,
+                   w.width, " | ");
+      }
+      w.buffer.append("\n ");
+      for (std::size_t k = 0; k < labels; ++k) {
+        w.buffer.append(w.fieldEnds[k] + (k == 0 ? 1 : 2), '=');
+        if (k + 1 < labels) {
+          w.buffer.push_back('+');
+        }
+      }
+      const uint64_t columns = axes > 1 ? s.axes.back().count : 1;
+      for (uint64_t c = 0; c < columns; ++c) {
+        w.buffer.push_back('+');
+        w.buffer.append(w.width + 2, '=');
+      }
+      w.buffer.push_back('\n');
+      break;
+    }
+  }  // -----  end switch  -----
+}   // -----  end of function InitSweepWriter  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  WriteSweepBlock
+//  Description:  Writes the scenarios of the block s holds after
+//                NextSweepBlock. CSV and NDJSON have one row per
+//                scenario, counted from 1: the values of the axes, the
+//                fair share in percent of income and the total every
+//                person pays. The table only shows the fair share.
+// =========================================================================
+void WriteSweepBlock (OutputWriter & w, const Sweep & s) {
+  const std::size_t axes = s.axes.size();
+  char number[320];
+
+  switch (w.format) {
+    case OutputCsv:
+      for (std::size_t t = 0; t < s.size; ++t) {
+        AppendNumber(w.buffer, s.first + t + 1);
+        for (std::size_t k = 0; k < axes; ++k) {
+          w.buffer.push_back(',');
+          AppendNumber(w.buffer, SweepValue(s, k, t));
+        }
+        w.buffer.push_back(',');
+        AppendNumber(w.buffer, 100.*s.shares[t]);
+        for (std::size_t j = 0; j < s.persons; ++j) {
+          w.buffer.push_back(',');
+          AppendNumber(w.buffer, SweepTotal(s, j, t));
+        }
+        w.buffer.push_back('\n');
+        FlushIfFull(w);
+      }  // -----  end for  -----
+      break;
+
+    case OutputNdjson:
+      for (std::size_t t = 0; t < s.size; ++t) {
+        w.buffer.append("{\"scenario\":");
+        AppendNumber(w.buffer, s.first + t + 1);
+        w.buffer.append(",\"axes\":[");
+        for (std::size_t k = 0; k < axes; ++k) {
+          if (k > 0) {
+            w.buffer.push_back(',');
+          }
+          AppendJsonNumber(w.buffer, SweepValue(s, k, t));
+        }
+        w.buffer.append("],\"percent\":");
+        AppendJsonNumber(w.buffer, 100.*s.shares[t]);
+        w.buffer.append(",\"totals\":[");
+        for (std::size_t j = 0; j < s.persons; ++j) {
+          if (j > 0) {
+            w.buffer.push_back(',');
+          }
+          AppendJsonNumber(w.buffer, SweepTotal(s, j, t));
+        }
+        w.buffer.append("]}\n");
+        FlushIfFull(w);
+      }  // -----  end for  -----
+      break;
+
+    case OutputBinary: {
+      const std::size_t begin = w.buffer.size();
+      w.buffer.resize(begin + s.size*(1 + s.persons)*sizeof(double));
+      char * out = &w.buffer[begin];
+      for (std::size_t t = 0; t < s.size; ++t) {
+        out = StoreDouble(out, 100.*s.shares[t]);
+        for (std::size_t j = 0; j < s.persons; ++j) {
+          out = StoreDouble(out, SweepTotal(s, j, t));
+        }
+      }  // -----  end for  -----
+      FlushIfFull(w);
+      break;
+    }
+
+    case OutputTable:
+    default: {
+      const uint64_t    columns = axes > 1 ? s.axes.back().count : 1;
+      const std::size_t labels  = w.fieldEnds.size();
+      for (std::size_t t = 0; t < s.size; ++t) {
+        const uint64_t c = (s.first + t) % columns;
+        if (c == 0) {
+          for (std::size_t k = 0; k < labels; ++k) {
+            AppendCell(w.buffer, number,
+                       FormatFixed2(SweepValue(s, k, t), number,
+                                    number + sizeof(number)),
+                       w.fieldEnds[k], k == 0 ? " " : " | ");
+          }
+        }
+        AppendCell(w.buffer, number,
+                   FormatFixed2(100.*s.shares[t], number,
+                                number + sizeof(number)),
+                   w.width, " | ");
+        if (c + 1 == columns) {
+          w.buffer.push_back('\n');
+          FlushIfFull(w);
+        }
+      }  // -----  end for  -----
+      break;
+    }
+  }  // -----  end switch  -----
+}   // -----  end of function WriteSweepBlock  -----
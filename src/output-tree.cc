@@ -0,0 +1,240 @@
+//
+// =========================================================================
+//
+//       Filename:  output-tree.cc
+//
+//    Description:  Writes an evaluated group tree, see WriteGroupTree.
+//
+//        Version:  1.0
+//        Created:  10/20/2026 02:16:02 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <algorithm> // max
+#include <cmath>     // fabs
+#include <cstddef>
+#include <cstdint>
+#include <cstring>   // strlen
+#include <string>
+#include <string_view>
+
+#include "table-renderer.h"
+#include "group-tree.h"
+#include "output-writer.h"
+#include "output-primitives.h"
+#include "summation.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+// the columns of the group tree table after the name
+const char * const kTreeHeaders[] = {
+  "Income", "Own costs", "Inherited", "Total", "Rate" };
+const std::size_t  kTreeColumns   = 5;
+
+// the row of a group or a person in the group tree table; rate is
+// only shown for groups
+void AppendTreeRow (OutputWriter & w, const std::size_t indent,
+                    const std::string_view name, const double * amounts,
+                    const bool showRate) {
+  char number[320];
+  w.buffer.push_back(' ');
+  w.buffer.append(indent, ' ');
+  w.buffer.append(name);
+  if (indent + name.size() < w.fieldEnds[0]) {
+    w.buffer.append(w.fieldEnds[0] - indent - name.size(), ' ');
+  }
+  for (std::size_t c = 0; c + 1 < kTreeColumns; ++c) {
+    AppendCell(w.buffer, number,
+               FormatFixed2(amounts[c], number, number + sizeof(number)),
+               w.width, " | ");
+  }
+  if (showRate) {
+    std::size_t length = FormatFixed2(100.*amounts[kTreeColumns - 1], number,
+                                      number + sizeof(number) - 1);
+    number[length++] = '%';
+    AppendCell(w.buffer, number, length, w.width, " | ");
+  }
+  w.buffer.push_back('\n');
+  FlushIfFull(w);
+}
+
+// own + inherited, added in summation.cc: with -ffast-math the compiler
+// would be free to turn income*own + income*inherited into
+// income*(own + inherited), which the debug build does not
+double AddParts (const double own, const double inherited) {
+  const double parts[] = { own, inherited };
+  return SumFixed<2>(parts, 2);
+}
+
+// the CSV or NDJSON rows of the persons of group g
+void AppendTreeRecords (OutputWriter & w, const GroupTree & t,
+                        const std::size_t g) {
+  const double   inherited = InheritedRate(t, g);
+  const double   own       = OwnRate(t, g);
+  const uint64_t parent    = t.parents[g] == kNoParentGroup
+                             ? 0 : static_cast<uint64_t>(t.parents[g]) + 1;
+
+  w.row.clear();
+  if (w.format == OutputCsv) {
+    AppendNumber(w.row, static_cast<uint64_t>(g + 1));
+    w.row.push_back(',');
+    AppendCsvField(w.row, GroupName(t, g));
+    w.row.push_back(',');
+    AppendNumber(w.row, parent);
+  } else {
+    w.row.append("{\"group_id\":");
+    AppendNumber(w.row, static_cast<uint64_t>(g + 1));
+    w.row.append(",\"group\":");
+    AppendJsonString(w.row, GroupName(t, g));
+    w.row.append(",\"parent_id\":");
+    AppendNumber(w.row, parent);
+  }
+
+  for (std::size_t p = t.firstPerson[g]; p < t.firstPerson[g + 1]; ++p) {
+    const double income  = t.personIncomes[p];
+    const double amounts[] = { income, income*own, income*inherited,
+                               AddParts(income*own, income*inherited) };
+    const uint64_t person  = static_cast<uint64_t>(p - t.firstPerson[g] + 1);
+
+    w.buffer.append(w.row);
+    if (w.format == OutputCsv) {
+      w.buffer.push_back(',');
+      AppendNumber(w.buffer, person);
+      w.buffer.push_back(',');
+      AppendCsvField(w.buffer, t.personNames[p]);
+      for (std::size_t c = 0; c < 4; ++c) {
+        w.buffer.push_back(',');
+        AppendNumber(w.buffer, amounts[c]);
+      }
+      w.buffer.push_back('\n');
+    } else {
+      static const char * const kKeys[] = {
+        ",\"income\":", ",\"own\":", ",\"inherited\":", ",\"amount\":" };
+      w.buffer.append(",\"person_id\":");
+      AppendNumber(w.buffer, person);
+      w.buffer.append(",\"person\":");
+      AppendJsonString(w.buffer, t.personNames[p]);
+      for (std::size_t c = 0; c < 4; ++c) {
+        w.buffer.append(kKeys[c]);
+        AppendJsonNumber(w.buffer, amounts[c]);
+      }
+      w.buffer.append("}\n");
+    }
+    FlushIfFull(w);
+  }  // -----  end for  -----
+}
+
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  InitGroupTreeWriter
+//  Description:  Prepares w to write an evaluated group tree to os, see
+//                WriteGroupTree.
+// =========================================================================
+void InitGroupTreeWriter (OutputWriter & w, std::ostream & os,
+                          const OutputFormat format) {
+  InitOutputWriter(w, os, format, false);
+  if (format == OutputCsv) {
+    w.buffer.assign("group_id,group,parent_id,person_id,person,income,own,"
+                    "inherited,amount\n");
+  }
+}   // -----  end of function InitGroupTreeWriter  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  WriteGroupTree
+//  Description:  Writes t after EvaluateGroupTree. CSV and NDJSON have one
+//                row per person, in the order of the file: its group,
+//                the parent of the group, counted from 1 with 0 for
+//                none, its income, the part of the costs of its own
+//                group it pays, the part of the costs of the groups
+//                above, and their sum. The table lists every group
+//                followed by its persons and the groups below it,
+//                indented by depth, with the same amounts for the group
+//                as a whole and its rate in percent of income.
+// =========================================================================
+void WriteGroupTree (OutputWriter & w, const GroupTree & t) {
+  const std::size_t groups = Groups(t);
+
+  switch (w.format) {
+    case OutputCsv:
+    case OutputNdjson:
+      for (std::size_t g = 0; g < groups; ++g) {
+        AppendTreeRecords(w, t, g);
+      }
+      break;
+
+    case OutputTable:
+    case OutputBinary:
+    default: {
+      // the name column, kept in fieldEnds[0], and the number columns
+      // are wide enough for every name and the sum of all incomes or
+      // costs, which bounds every amount as long as no income is negative
+      const char kNameHeader[] = "Group / person";
+      std::size_t nameWidth = sizeof(kNameHeader) - 1;
+      double      bound     = 0.;
+      for (std::size_t g = 0; g < groups; ++g) {
+        const std::size_t indent = 2*t.depths[g];
+        nameWidth = std::max(nameWidth, indent + GroupName(t, g).size());
+        for (std::size_t p = t.firstPerson[g]; p < t.firstPerson[g + 1]; ++p) {
+          nameWidth = std::max(nameWidth, indent + 2 + t.personNames[p].size());
+        }
+        bound += std::fabs(t.costs[g]);
+        if (t.parents[g] == kNoParentGroup) {
+          bound = std::max(bound, std::fabs(t.incomes[g]));
+        }
+      }  // -----  end for  -----
+      char number[320];
+      w.width = FormatFixed2(-bound, number, number + sizeof(number));
+      for (std::size_t c = 0; c < kTreeColumns; ++c) {
+        w.width = std::max(w.width, std::strlen(kTreeHeaders[c]));
+      }
+      w.fieldEnds.assign(1, nameWidth);
+
+      w.buffer.push_back(' ');
+      w.buffer.append(kNameHeader);
+      w.buffer.append(nameWidth - (sizeof(kNameHeader) - 1), ' ');
+      for (std::size_t c = 0; c < kTreeColumns; ++c) {
+        AppendCell(w.buffer, kTreeHeaders[c], std::strlen(kTreeHeaders[c]),
+                   w.width, " | ");
+      }
+      w.buffer.push_back('\n');
+      w.buffer.push_back(' ');
+      w.buffer.append(nameWidth + 1, '=');
+      for (std::size_t c = 0; c < kTreeColumns; ++c) {
+        w.buffer.push_back('+');
+        w.buffer.append(w.width + 2, '=');
+      }
+      w.buffer.push_back('\n');
+
+      for (std::size_t k = 0; k < t.order.size(); ++k) {
+        const std::size_t g         = t.order[k];
+        const std::size_t indent    = 2*t.depths[g];
+        const double      inherited = InheritedRate(t, g);
+        const double      own       = OwnRate(t, g);
+        const double      group[]   = { t.incomes[g], t.costs[g],
+                                        t.incomes[g]*inherited,
+                                        AddParts(t.costs[g],
+                                                 t.incomes[g]*inherited),
+                                        t.rates[g] };
+        AppendTreeRow(w, indent, GroupName(t, g), group, true);
+
+        for (std::size_t p = t.firstPerson[g]; p < t.firstPerson[g + 1]; ++p) {
+          const double income   = t.personIncomes[p];
+          const double person[] = { income, income*own, income*inherited,
+                                    AddParts(income*own, income*inherited),
+                                    0. };
+          AppendTreeRow(w, indent + 2, t.personNames[p], person, false);
+        }
+      }  // -----  end for  -----
+      break;
+    }
+  }  // -----  end switch  -----
+}   // -----  end of function WriteGroupTree  -----
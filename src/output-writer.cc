@@ -0,0 +1,409 @@
+//
+// =========================================================================
+//
+//       Filename:  output-writer.cc
+//
+//    Description:  Writes the results household by household in one of
+//                  the formats of --output-format. The machine readable
+//                  formats have one record per person and expense:
+//
+//                    household,person_id,person,expense_id,expense,amount
+//
+//                  The amounts are written with the shortest decimal
+//                  representation that reads back as the same double.
+//                  The writers of series, group trees, settlements and
+//                  sweeps are in output-<mode>.cc and share the buffer and
+//                  the primitives of output-primitives.h defined here.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 05:10:33 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <charconv>  // to_chars
+#include <cstddef>
+#include <cstdint>
+#include <cstring>   // memcpy
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "table-renderer.h"
+#include "output-writer.h"
+#include "output-primitives.h"
+#include "stats.h"
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+const char     kBinaryMagic[4] = { 'F', 'S', 'H', 'R' };
+const uint32_t kBinaryVersion  = 1;
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+const std::size_t kFlushBytes = 1 << 16;
+
+void WriteTable (OutputWriter & w, const std::vector<Person> & p,
+                 const std::vector<Expense> & e, const Allocation & a) {
+  RenderTable(p, e, a, w.table);
+  if (w.numbered) {
+    w.buffer.append("\nHousehold ");
+    AppendNumber(w.buffer, w.households);
+    w.buffer.push_back(':');
+  }
+  if (w.os == NULL) {
+    w.buffer.append(w.table.text);
+    return;
+  }
+  Flush(w);
+  w.os->write(w.table.text.data(),
+              static_cast<std::streamsize>(w.table.text.size()));
+  CountStat(CounterBytesWritten, w.table.text.size());
+}
+
+// The columns of one person and of one expense are the same in every
+// row, so they are formatted once per household and only copied per row.
+void WriteCsv (OutputWriter & w, const std::vector<Person> & p,
+               const std::vector<Expense> & e, const Allocation & a) {
+  w.fields.clear();
+  w.fieldEnds.clear();
+  for (std::size_t i = 0; i < e.size(); ++i) {
+    AppendNumber(w.fields, static_cast<uint64_t>(i + 1));
+    w.fields.push_back(',');
+    AppendCsvField(w.fields, e[i].name);
+    w.fields.push_back(',');
+    w.fieldEnds.push_back(w.fields.size());
+  }
+
+  for (std::size_t j = 0; j < p.size(); ++j) {
+    w.row.clear();
+    AppendNumber(w.row, w.households);
+    w.row.push_back(',');
+    AppendNumber(w.row, static_cast<uint64_t>(j + 1));
+    w.row.push_back(',');
+    AppendCsvField(w.row, p[j].name);
+    w.row.push_back(',');
+
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < e.size(); ++i) {
+      w.buffer.append(w.row);
+      w.buffer.append(w.fields, begin, w.fieldEnds[i] - begin);
+      AppendNumber(w.buffer, Share(a, j, i));
+      w.buffer.push_back('\n');
+      FlushIfFull(w);
+      begin = w.fieldEnds[i];
+    }  // -----  end for expenses  -----
+  }  // -----  end for persons  -----
+}
+
+void WriteNdjson (OutputWriter & w, const std::vector<Person> & p,
+                  const std::vector<Expense> & e, const Allocation & a) {
+  w.fields.clear();
+  w.fieldEnds.clear();
+  for (std::size_t i = 0; i < e.size(); ++i) {
+    w.fields.append(",\"expense_id\":");
+    AppendNumber(w.fields, static_cast<uint64_t>(i + 1));
+    w.fields.append(",\"expense\":");
+    AppendJsonString(w.fields, e[i].name);
+    w.fields.append(",\"amount\":");
+    w.fieldEnds.push_back(w.fields.size());
+  }
+
+  for (std::size_t j = 0; j < p.size(); ++j) {
+    w.row.clear();
+    w.row.append("{\"household\":");
+    AppendNumber(w.row, w.households);
+    w.row.append(",\"person_id\":");
+    AppendNumber(w.row, static_cast<uint64_t>(j + 1));
+    w.row.append(",\"person\":");
+    AppendJsonString(w.row, p[j].name);
+
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < e.size(); ++i) {
+      const double amount = Share(a, j, i);
+
+      w.buffer.append(w.row);
+      w.buffer.append(w.fields, begin, w.fieldEnds[i] - begin);
+      if (IsFinite(amount)) {
+        AppendNumber(w.buffer, amount);
+      } else {
+        w.buffer.append("null"); // JSON has no infinities
+      }
+      w.buffer.append("}\n");
+      FlushIfFull(w);
+      begin = w.fieldEnds[i];
+    }  // -----  end for expenses  -----
+  }  // -----  end for persons  -----
+}
+
+void WriteBinary (OutputWriter & w, const std::vector<Person> & p,
+                  const std::vector<Expense> & e, const Allocation & a) {
+  const std::size_t n = p.size();
+  const std::size_t m = e.size();
+
+  PutUint64(w.buffer, w.households);
+  PutUint32(w.buffer, static_cast<uint32_t>(n));
+  PutUint32(w.buffer, static_cast<uint32_t>(m));
+
+  for (std::size_t j = 0; j < n; ++j) {
+    for (std::size_t i = 0; i < m; ++i) {
+      PutUint32(w.buffer, static_cast<uint32_t>(j + 1));
+    }
+    FlushIfFull(w);
+  }
+  for (std::size_t j = 0; j < n; ++j) {
+    for (std::size_t i = 0; i < m; ++i) {
+      PutUint32(w.buffer, static_cast<uint32_t>(i + 1));
+    }
+    FlushIfFull(w);
+  }
+  for (std::size_t k = 0; k < n*m; ++k) {
+    PutDouble(w.buffer, a.shares[k]);
+    FlushIfFull(w);
+  }
+}
+}  // -----  end of namespace  -----
+
+//--------------------------------------------------------------------------
+//  primitives, see output-primitives.h
+//--------------------------------------------------------------------------
+// without a stream, w collects everything in w.buffer
+void Flush (OutputWriter & w) {
+  if (w.os == NULL) {
+    return;
+  }
+  w.os->write(w.buffer.data(), static_cast<std::streamsize>(w.buffer.size()));
+  CountStat(CounterBytesWritten, w.buffer.size());
+  w.buffer.clear();
+}
+
+void AppendNumber (std::string & out, const double x) {
+  char buffer[32];
+  const std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), x);
+  out.append(buffer, r.ptr);
+}
+
+void AppendNumber (std::string & out, const uint64_t x) {
+  char buffer[24];
+  const std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), x);
+  out.append(buffer, r.ptr);
+}
+
+// whole cents as an exact decimal with two digits, e.g. 21.90; transfers
+// are always positive
+void AppendCents (std::string & out, const int64_t cents) {
+  AppendNumber(out, static_cast<uint64_t>(cents/100));
+  out.push_back('.');
+  out.push_back(static_cast<char>('0' + cents/10 % 10));
+  out.push_back(static_cast<char>('0' + cents % 10));
+}
+
+// RFC 4180: quoted only if needed, quotes doubled
+void AppendCsvField (std::string & out, const std::string_view s) {
+  if (s.find_first_of(",\"\r\n") == std::string_view::npos) {
+    out.append(s);
+    return;
+  }
+  out.push_back('"');
+  for (std::size_t k = 0; k < s.size(); ++k) {
+    if (s[k] == '"') {
+      out.push_back('"');
+    }
+    out.push_back(s[k]);
+  }
+  out.push_back('"');
+}
+
+void AppendJsonString (std::string & out, const std::string_view s) {
+  static const char kHex[] = "0123456789abcdef";
+
+  out.push_back('"');
+  for (std::size_t k = 0; k < s.size(); ++k) {
+    const unsigned char c = static_cast<unsigned char>(s[k]);
+    if (c == '"' || c == '\\') {
+      out.push_back('\\');
+      out.push_back(s[k]);
+    } else if (c < 0x20) {
+      out.append("\\u00");
+      out.push_back(kHex[c >> 4]);
+      out.push_back(kHex[c & 0xf]);
+    } else {
+      out.push_back(s[k]);
+    }
+  }
+  out.push_back('"');
+}
+
+void AppendJsonNumber (std::string & out, const double x) {
+  if (IsFinite(x)) {
+    AppendNumber(out, x);
+  } else {
+    out.append("null"); // JSON has no infinities
+  }
+}
+
+// appends separator and s right aligned in a column of the series table
+void AppendCell (std::string & out, const char * s, const std::size_t length,
+                 const std::size_t width, const char * separator) {
+  out.append(separator);
+  if (length < width) {
+    out.append(width - length, ' ');
+  }
+  out.append(s, length);
+}
+
+void AppendRule (std::string & out, const std::size_t width,
+                 const std::size_t persons) {
+  out.push_back(' ');
+  out.append(width + 1, '-');
+  for (std::size_t j = 0; j < persons; ++j) {
+    out.push_back('+');
+    out.append(width + 2, '-');
+  }
+  out.push_back('\n');
+}
+
+// little-endian independent of the host, the compiler turns the shifts
+// into plain stores on x86
+void PutUint32 (std::string & out, const uint32_t x) {
+  const char bytes[4] = {
+    static_cast<char>(x),       static_cast<char>(x >> 8),
+    static_cast<char>(x >> 16), static_cast<char>(x >> 24) };
+  out.append(bytes, sizeof(bytes));
+}
+
+void PutUint64 (std::string & out, const uint64_t x) {
+  PutUint32(out, static_cast<uint32_t>(x));
+  PutUint32(out, static_cast<uint32_t>(x >> 32));
+}
+
+void PutDouble (std::string & out, const double x) {
+  uint64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  PutUint64(out, bits);
+}
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ParseOutputFormat
+//  Description:  Sets format to the format called name. Returns false if
+//                there is none.
+// =========================================================================
+bool ParseOutputFormat (const std::string & name, OutputFormat & format) {
+  if (name == "table") {
+    format = OutputTable;
+  } else if (name == "csv") {
+    format = OutputCsv;
+  } else if (name == "ndjson") {
+    format = OutputNdjson;
+  } else if (name == "binary") {
+    format = OutputBinary;
+  } else {
+    return false;
+  }
+  return true;
+}   // -----  end of function ParseOutputFormat  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  InitOutputWriter
+//  Description:  Prepares w to write to os and writes the CSV header or
+//                the header of the binary format.
+// =========================================================================
+void InitOutputWriter (OutputWriter & w, std::ostream & os,
+                       const OutputFormat format, const bool numbered) {
+  w.os         = &os;
+  w.format     = format;
+  w.numbered   = numbered;
+  w.households = 0;
+  w.flushBytes = kFlushBytes;
+  w.buffer.clear();
+  w.buffer.reserve(2*kFlushBytes);
+
+  switch (format) {
+    case OutputCsv:
+      w.buffer.append("household,person_id,person,expense_id,expense,amount\n");
+      break;
+    case OutputBinary:
+      w.buffer.append(kBinaryMagic, sizeof(kBinaryMagic));
+      PutUint32(w.buffer, kBinaryVersion);
+      break;
+    case OutputTable:
+    case OutputNdjson:
+    default:
+      break;
+  }  // -----  end switch  -----
+}   // -----  end of function InitOutputWriter  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  WriteHousehold
+//  Description:  Writes the allocation a of the next household. At most
+//                flushBytes plus one record are held back in memory.
+// =========================================================================
+void WriteHousehold (OutputWriter & w, const std::vector<Person> & p,
+                     const std::vector<Expense> & e, const Allocation & a) {
+  ++w.households;
+
+  switch (w.format) {
+    case OutputCsv:
+      WriteCsv(w, p, e, a);
+      break;
+    case OutputNdjson:
+      WriteNdjson(w, p, e, a);
+      break;
+    case OutputBinary:
+      WriteBinary(w, p, e, a);
+      break;
+    case OutputTable:
+    default:
+      WriteTable(w, p, e, a);
+      break;
+  }  // -----  end switch  -----
+}   // -----  end of function WriteHousehold  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  StartOutputChunk
+//  Description:  Lets w collect the records of the households following
+//                the first households ones in w.buffer instead of writing
+//                them to a stream, so that workers can format households
+//                in parallel. The chunks are passed in order to
+//                WriteOutputChunk of the writer of the stream, which has
+//                already written the header.
+// =========================================================================
+void StartOutputChunk (OutputWriter & w, const OutputFormat format,
+                       const bool numbered, const uint64_t households) {
+  w.os         = NULL;
+  w.format     = format;
+  w.numbered   = numbered;
+  w.households = households;
+  w.flushBytes = kFlushBytes;
+  w.buffer.clear();
+}   // -----  end of function StartOutputChunk  -----
+
+void WriteOutputChunk (OutputWriter & w, const std::string & chunk) {
+  if (w.buffer.size() + chunk.size() < w.flushBytes) {
+    w.buffer.append(chunk);
+    return;
+  }
+  Flush(w);
+  if (w.os != NULL) {
+    w.os->write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    CountStat(CounterBytesWritten, chunk.size());
+  }
+}   // -----  end of function WriteOutputChunk  -----
+
+void FinishOutputWriter (OutputWriter & w) {
+  Flush(w);
+  if (w.os != NULL) {
+    w.os->flush();
+  }
+}   // -----  end of function FinishOutputWriter  -----
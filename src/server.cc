@@ -0,0 +1,503 @@
+//
+// =========================================================================
+//
+//       Filename:  server.cc
+//
+//    Description:  Serves share queries over a Unix domain socket. The
+//                  settings are parsed once and kept in memory; every
+//                  query only applies its overrides, allocates and
+//                  formats, which takes microseconds instead of the
+//                  milliseconds of starting a new process.
+//
+//                  A query is one line of whitespace separated words:
+//
+//                    n:income     sets the income of the n-th person
+//                    format=name  table, csv, ndjson or binary, by default
+//                                 the one of --output-format
+//
+//                  e.g. "1:1500 2:2000 format=csv". The line "stats"
+//                  asks for the latency histogram instead. Every answer
+//                  is framed as
+//
+//                    OK <bytes>\n<bytes of output>
+//                    ERROR <message>\n
+//
+//                  settings.ini is watched with inotify and parsed again
+//                  when it was written or replaced. The new settings are
+//                  swapped in between two queries only if they parse, so
+//                  queries never see a half written file and a broken
+//                  file keeps the old settings in service.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 06:21:47 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cerrno>     // errno
+#include <charconv>   // from_chars, to_chars
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>    // EXIT_SUCCESS
+#include <cstring>    // strerror
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>    // move
+#include <vector>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "household-reader.h"
+#include "output-writer.h"
+#include "server.h"
+#include "stats.h"
+#include "helper-functions.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+// a client sending a longer line without a newline is disconnected
+const std::size_t kMaxRequestBytes = 1 << 16;
+
+volatile std::sig_atomic_t gStop = 0;
+
+extern "C" void StopServing (int) {
+  gStop = 1;
+}
+
+struct client {
+  int         fd;
+  std::string in;       // received, not yet answered
+  std::string out;      // answered, not yet sent
+  std::size_t sent;     // bytes of out already sent
+  bool        closing;  // close once out is sent
+};  // -----  end of struct client  -----
+
+typedef struct client Client;
+
+void AppendUnsigned (std::string & out, const uint64_t x) {
+  char buffer[24];
+  const std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), x);
+  out.append(buffer, r.ptr);
+}
+
+int OpenListenSocket (const std::string & path, std::string & error) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  if (path.size() >= sizeof(address.sun_path)) {
+    error = "Socket path " + path + " is too long.";
+    return -1;
+  }
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+  // a socket left behind by a server that was killed
+  struct stat status;
+  if (stat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)) {
+    unlink(path.c_str());
+  }
+
+  const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0
+      || bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0
+      || listen(fd, SOMAXCONN) != 0) {
+    error = "Could not listen on " + path + ": " + std::strerror(errno);
+    if (fd >= 0) {
+      close(fd);
+    }
+    return -1;
+  }
+  return fd;
+}
+
+// Watches the directory, as editors and deployments replace the file by
+// renaming a new one over it, which a watch on the file itself misses.
+int WatchSettingsFile (const std::string & fileName, std::string & error) {
+  const std::size_t slash     = fileName.rfind('/');
+  const std::string directory = slash == std::string::npos
+    ? std::string(".") : fileName.substr(0, slash + 1);
+
+  const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd < 0
+      || inotify_add_watch(fd, directory.c_str(),
+                           IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+    error = "Could not watch " + directory + ": " + std::strerror(errno);
+    if (fd >= 0) {
+      close(fd);
+    }
+    return -1;
+  }
+  return fd;
+}
+
+// Reads all pending events, returns true if one of them is about the
+// settings file.
+bool SettingsFileChanged (const int fd, const std::string & fileName) {
+  const std::size_t slash    = fileName.rfind('/');
+  const std::string baseName = slash == std::string::npos
+    ? fileName : fileName.substr(slash + 1);
+
+  alignas(inotify_event) char buffer[4096];
+  bool changed = false;
+  for (;;) {
+    const ssize_t length = read(fd, buffer, sizeof(buffer));
+    if (length <= 0) {
+      return changed;
+    }
+    for (ssize_t k = 0; k < length; ) {
+      inotify_event event;
+      std::memcpy(&event, buffer + k, sizeof(event));
+      if (event.len > 0 && baseName == buffer + k + sizeof(event)) {
+        changed = true;
+      }
+      k += static_cast<ssize_t>(sizeof(event) + event.len);
+    }
+  }  // -----  end for  -----
+}
+
+void ReloadSettings (const std::string & fileName, Household & settings) {
+  Household   fresh;
+  std::string error;
+  bool        ok = false;
+  {
+    PhaseTimer timer(PhaseParse);
+    ok = LoadHouseholdFile(fileName, fresh, error);
+    CountStat(CounterRecords, fresh.persons.size() + fresh.expenses.size());
+  }
+  if (!ok) {
+    DisplayError(error + " (keeping the previous settings)");
+    return;
+  }
+  settings.persons.swap(fresh.persons);
+  settings.expenses.swap(fresh.expenses);
+  std::cerr << "Reloaded " << fileName << std::endl;
+}
+
+// Answers all complete lines in c.in.
+void AnswerLines (Client & c, const Household & settings, const bool cents,
+                  const OutputFormat format, QueryScratch & scratch,
+                  LatencyHistogram & latencies,
+                  std::string & request, std::string & response) {
+  typedef std::chrono::steady_clock Clock;
+
+  std::size_t begin = 0;
+  for (std::size_t end; (end = c.in.find('\n', begin)) != std::string::npos;
+       begin = end + 1) {
+    const Clock::time_point start = Clock::now();
+
+    request.assign(c.in, begin, end - begin);
+    if (!request.empty() && request.back() == '\r') {
+      request.pop_back();
+    }
+
+    bool ok = true;
+    if (request == "stats") {
+      response.clear();
+      WriteLatencies(latencies, response);
+    } else {
+      PhaseTimer timer(PhaseQuery);
+      ok = AnswerQuery(settings, request, cents, format, scratch, response);
+    }
+
+    if (ok) {
+      c.out.append("OK ");
+      AppendUnsigned(c.out, response.size());
+      c.out.push_back('\n');
+    } else {
+      c.out.append("ERROR ");
+    }
+    c.out.append(response);
+    if (!ok) {
+      c.out.push_back('\n');
+    }
+
+    if (request != "stats") {
+      RecordLatency(latencies, static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          Clock::now() - start).count()));
+    }
+  }  // -----  end for  -----
+  c.in.erase(0, begin);
+
+  if (c.in.size() > kMaxRequestBytes) {
+    c.out.append("ERROR Request too long\n");
+    c.in.clear();
+    c.closing = true;
+  }
+}
+
+// Reads what is available, but no more than one request too long, so
+// that a client sending without pause can not grow c.in without bound;
+// the rest is read in the next round. Returns false if the client is
+// gone.
+bool ReceiveFrom (Client & c) {
+  char buffer[4096];
+  while (c.in.size() <= kMaxRequestBytes) {
+    const ssize_t length = recv(c.fd, buffer, sizeof(buffer), 0);
+    if (length > 0) {
+      c.in.append(buffer, static_cast<std::size_t>(length));
+      continue;
+    }
+    if (length == 0) {
+      c.closing = true; // answer what was sent, then close
+      return true;
+    }
+    return errno == EAGAIN || errno == EINTR;
+  }  // -----  end while  -----
+  return true;
+}
+
+// Sends what is pending, returns false if the client is gone.
+bool SendTo (Client & c) {
+  while (c.sent < c.out.size()) {
+    const ssize_t length = send(c.fd, c.out.data() + c.sent,
+                                c.out.size() - c.sent, MSG_NOSIGNAL);
+    if (length < 0) {
+      return errno == EAGAIN || errno == EINTR;
+    }
+    c.sent += static_cast<std::size_t>(length);
+    CountStat(CounterBytesWritten, static_cast<std::size_t>(length));
+  }  // -----  end while  -----
+  c.out.clear();
+  c.sent = 0;
+  return true;
+}
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  AnswerQuery
+//  Description:  Splits the expenses of settings with the overrides of
+//                the request and writes the result in the requested
+//                format into response. On a malformed request or
+//                invalid incomes response holds the message and false is
+//                returned; nothing exits.
+// =========================================================================
+bool AnswerQuery (const Household & settings, const std::string & request,
+                  const bool cents, OutputFormat format, QueryScratch & s,
+                  std::string & response) {
+
+  s.persons = settings.persons;
+
+  const std::string_view words(request);
+  std::size_t begin = words.find_first_not_of(" \t");
+  while (begin != std::string_view::npos) {
+    std::size_t end = words.find_first_of(" \t", begin);
+    if (end == std::string_view::npos) {
+      end = words.size();
+    }
+    const std::string_view word = words.substr(begin, end - begin);
+    begin = words.find_first_not_of(" \t", end);
+
+    if (word.substr(0, 7) == "format=") {
+      if (!ParseOutputFormat(std::string(word.substr(7)), format)) {
+        response = "Unknown output format '" + std::string(word.substr(7)) + "'.";
+        return false;
+      }
+      continue;
+    }
+
+    const std::size_t colon = word.find(':');
+    std::size_t       n     = 0;
+    const std::from_chars_result r =
+      std::from_chars(word.data(), word.data() + (colon == std::string_view::npos
+                                                   ? 0 : colon), n);
+    if (colon == std::string_view::npos || r.ptr != word.data() + colon
+        || r.ec != std::errc()) {
+      response = "'" + std::string(word) + "' is neither n:income nor format=name.";
+      return false;
+    }
+    if (n < 1 || n > s.persons.size()) {
+      response = "There is no person " + std::to_string(n) + ".";
+      return false;
+    }
+    const Conversion income = ParseDouble(word.substr(colon + 1));
+    if (income.error != ConversionOk) {
+      response = "Income of person " + std::to_string(n) + ": "
+                 + ConversionErrorMessage(income.error);
+      return false;
+    }
+    s.persons[n - 1].income = income.value;
+  }  // -----  end while  -----
+
+  const char * error = AllocateHousehold(s.persons, settings.expenses, cents,
+                                         s.allocation);
+  if (error != NULL) {
+    response = error;
+    return false;
+  }
+
+  s.output.str(std::string());
+  InitOutputWriter(s.writer, s.output, format, false);
+  WriteHousehold(s.writer, s.persons, settings.expenses, s.allocation);
+  FinishOutputWriter(s.writer);
+  response = s.output.str();
+  return true;
+}   // -----  end of function AnswerQuery  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  Serve
+//  Description:  Answers queries on socketPath until SIGINT or SIGTERM,
+//                then prints the latency histogram to stderr. All clients
+//                are served by one ppoll loop, so a reload of the settings
+//                always falls between two queries. Returns the exit code.
+// =========================================================================
+int Serve (const std::string & socketPath,
+           const std::string & settingsFileName, const bool cents,
+           const OutputFormat format) {
+
+  Household   settings;
+  std::string error;
+  bool        ok = false;
+  {
+    PhaseTimer timer(PhaseParse);
+    ok = LoadHouseholdFile(settingsFileName, settings, error);
+    CountStat(CounterRecords,
+              settings.persons.size() + settings.expenses.size());
+  }
+  if (!ok) {
+    DisplayError(error);
+    return EXIT_FAILURE;
+  }
+
+  const int listenFd = OpenListenSocket(socketPath, error);
+  if (listenFd < 0) {
+    DisplayError(error);
+    return EXIT_FAILURE;
+  }
+  const int watchFd = WatchSettingsFile(settingsFileName, error);
+  if (watchFd < 0) {
+    DisplayError(error);
+    close(listenFd);
+    unlink(socketPath.c_str());
+    return EXIT_FAILURE;
+  }
+
+  // SIGINT and SIGTERM are blocked but while ppoll waits, so a signal
+  // arriving between the test of gStop and ppoll is not lost: it is
+  // delivered once ppoll unblocks it, which then returns EINTR
+  struct sigaction action;
+  std::memset(&action, 0, sizeof(action));
+  action.sa_handler = StopServing;  // no SA_RESTART, ppoll returns EINTR
+  sigaction(SIGINT,  &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+
+  sigset_t stopSignals;
+  sigset_t waitMask;
+  sigemptyset(&stopSignals);
+  sigaddset(&stopSignals, SIGINT);
+  sigaddset(&stopSignals, SIGTERM);
+  sigprocmask(SIG_BLOCK, &stopSignals, &waitMask);
+  sigdelset(&waitMask, SIGINT);
+  sigdelset(&waitMask, SIGTERM);
+
+  std::cerr << "Serving " << settingsFileName << " on " << socketPath
+            << std::endl;
+
+  std::vector<Client> clients;
+  std::vector<pollfd> fds;
+  QueryScratch        scratch;
+  LatencyHistogram    latencies;
+  std::string         request;
+  std::string         response;
+  ClearLatencies(latencies);
+
+  while (!gStop) {
+    fds.clear();
+    fds.push_back(pollfd{ listenFd, POLLIN, 0 });
+    fds.push_back(pollfd{ watchFd,  POLLIN, 0 });
+    for (std::size_t k = 0; k < clients.size(); ++k) {
+      const short events = static_cast<short>(
+        (clients[k].closing ? 0 : POLLIN) | (clients[k].out.empty() ? 0 : POLLOUT));
+      fds.push_back(pollfd{ clients[k].fd, events, 0 });
+    }
+
+    if (ppoll(fds.data(), fds.size(), NULL, &waitMask) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      DisplayError(std::string("ppoll failed: ") + std::strerror(errno));
+      break;
+    }
+
+    if (fds[1].revents & POLLIN) {
+      if (SettingsFileChanged(watchFd, settingsFileName)) {
+        ReloadSettings(settingsFileName, settings);
+      }
+    }
+
+    // clients accepted now are polled in the next round, fds[k + 2]
+    // belongs to clients[k]
+    const std::size_t polled = clients.size();
+    if (fds[0].revents & POLLIN) {
+      for (int fd; (fd = accept4(listenFd, NULL, NULL,
+                                 SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0; ) {
+        clients.push_back(Client{ fd, std::string(), std::string(), 0, false });
+      }
+    }
+
+    for (std::size_t k = 0; k < polled; ++k) {
+      Client &    c      = clients[k];
+      const short events = fds[k + 2].revents;
+      bool        alive  = true;
+
+      if (events & (POLLIN | POLLHUP)) {
+        alive = ReceiveFrom(c);
+        if (alive) {
+          AnswerLines(c, settings, cents, format, scratch, latencies,
+                      request, response);
+        }
+      }
+      if (alive && (events & (POLLERR | POLLNVAL))) {
+        alive = false;
+      }
+      if (alive && !c.out.empty()) {
+        alive = SendTo(c);
+      }
+      if (!alive || (c.closing && c.out.empty())) {
+        close(c.fd);
+        c.fd = -1;
+      }
+    }  // -----  end for clients  -----
+
+    std::size_t kept = 0;
+    for (std::size_t k = 0; k < clients.size(); ++k) {
+      if (clients[k].fd >= 0) {
+        if (kept != k) {
+          clients[kept] = std::move(clients[k]);
+        }
+        ++kept;
+      }
+    }
+    clients.resize(kept);
+  }  // -----  end while  -----
+
+  for (std::size_t k = 0; k < clients.size(); ++k) {
+    close(clients[k].fd);
+  }
+  close(watchFd);
+  close(listenFd);
+  unlink(socketPath.c_str());
+  sigprocmask(SIG_UNBLOCK, &stopSignals, NULL);
+
+  std::string summary;
+  WriteLatencies(latencies, summary);
+  std::cerr << summary;
+  return EXIT_SUCCESS;
+}   // -----  end of function Serve  -----
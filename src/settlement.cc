@@ -0,0 +1,352 @@
+//
+// =========================================================================
+//
+//       Filename:  settlement.cc
+//
+//    Description:  Defines the parser of payments files and the
+//                  settlement engine. The plan is found greedily with
+//                  two heaps in O(n log n): the largest debt always
+//                  pays the largest credit, so that every transfer
+//                  clears at least one balance. The exact mode splits
+//                  the persons into as many groups of zero sum as
+//                  possible by dynamic programming over all subsets,
+//                  which gives the fewest transfers, and settles every
+//                  group greedily.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 03:18:52 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <algorithm>    // make_heap, push_heap, pop_heap
+#include <cstddef>
+#include <cstdint>
+#include <iostream>     // input/output streams, e.g. cout and cin
+#include <sstream>      // string streams to join different strings
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "arena.h"
+#include "name-table.h"
+#include "ini-parser.h"
+#include "table-renderer.h"
+#include "settlement.h"
+#include "helper-functions.h"
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+// 2^20 subsets take 9 MB and some ten milliseconds
+const std::size_t kMaxExactMembers = 20;
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+bool IsBlank (const char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+IniToken SetError (IniScanner & s, const char * position,
+                   const std::string & message) {
+  s.error.line    = s.line;
+  s.error.column  = IniColumn(s, position);
+  s.error.message = message;
+  return IniSyntaxError;
+}
+
+std::string FormatCents (const int64_t cents) {
+  char number[320];
+  return std::string(number, FormatFixed2(static_cast<double>(cents)/100.,
+                                          number, number + sizeof(number)));
+}
+
+// reads the [payments] section of s into s.paid and s.paidCosts
+IniToken ParsePaymentLines (IniScanner & s, Settlement & t) {
+  bool inPayments = false;
+  bool inSection  = false;
+
+  for (;;) {
+    const IniToken token = NextIniToken(s);
+    if (token == IniSyntaxError || token == IniEnd) {
+      return token;
+    }
+    if (token == IniSection) {
+      inSection  = true;
+      inPayments = s.section == "payments";
+      continue;
+    }
+    if (!inSection) {
+      return SetError(s, s.key.data(), "Key outside of any section.");
+    }
+    if (!inPayments) {
+      continue;
+    }
+
+    uint32_t person = 0;
+    if (!FindName(t.personNames, s.key, person)) {
+      return SetError(s, s.key.data(), "There is no person '"
+                      + std::string(s.key) + "'.");
+    }
+
+    // the amount is the last word, the expense everything before it
+    const char * first = s.value.data();
+    const char * last  = first + s.value.size();
+    const char * word  = last;
+    while (word > first && !IsBlank(*(word - 1))) {
+      --word;
+    }
+    const char * end = word;
+    while (end > first && IsBlank(*(end - 1))) {
+      --end;
+    }
+    if (end == first) {
+      return SetError(s, first, "Expected 'person = expense amount'.");
+    }
+
+    const std::string_view expense(first, static_cast<std::size_t>(end - first));
+    uint32_t               id = 0;
+    if (!FindName(t.expenseNames, expense, id)) {
+      return SetError(s, first, "There is no expense '"
+                      + std::string(expense) + "'.");
+    }
+    const Conversion c = ParseDouble(
+      std::string_view(word, static_cast<std::size_t>(last - word)));
+    if (c.error != ConversionOk) {
+      return SetError(s, word, ConversionErrorMessage(c.error));
+    }
+
+    const int64_t cents = ToCents(c.value);
+    t.paid[t.personOf[person]]   += cents;
+    t.paidCosts[t.expenseOf[id]] += cents;
+  }  // -----  end for  -----
+}
+
+bool CreditorLess (const std::vector<int64_t> & remaining, const uint32_t a,
+                   const uint32_t b) {
+  return remaining[a] < remaining[b]
+    || (remaining[a] == remaining[b] && a > b);
+}
+
+bool DebtorLess (const std::vector<int64_t> & remaining, const uint32_t a,
+                 const uint32_t b) {
+  return remaining[a] > remaining[b]
+    || (remaining[a] == remaining[b] && a > b);
+}
+
+// Settles the persons ids[0..count), whose balances add up to zero: the
+// person who owes most pays the one who is owed most until one of them
+// is even, and goes back into its heap otherwise. Ties go to the person
+// listed first.
+void SettleGreedily (Settlement & s, const uint32_t * ids,
+                     const std::size_t count) {
+  const std::vector<int64_t> & remaining = s.remaining;
+  auto creditorLess = [&remaining](uint32_t a, uint32_t b) {
+    return CreditorLess(remaining, a, b);
+  };
+  auto debtorLess = [&remaining](uint32_t a, uint32_t b) {
+    return DebtorLess(remaining, a, b);
+  };
+
+  s.creditors.clear();
+  s.debtors.clear();
+  for (std::size_t k = 0; k < count; ++k) {
+    if (remaining[ids[k]] > 0) {
+      s.creditors.push_back(ids[k]);
+    } else if (remaining[ids[k]] < 0) {
+      s.debtors.push_back(ids[k]);
+    }
+  }
+  std::make_heap(s.creditors.begin(), s.creditors.end(), creditorLess);
+  std::make_heap(s.debtors.begin(), s.debtors.end(), debtorLess);
+
+  while (!s.creditors.empty() && !s.debtors.empty()) {
+    std::pop_heap(s.creditors.begin(), s.creditors.end(), creditorLess);
+    std::pop_heap(s.debtors.begin(), s.debtors.end(), debtorLess);
+    const uint32_t to    = s.creditors.back();
+    const uint32_t from  = s.debtors.back();
+    const int64_t  cents = std::min(s.remaining[to], -s.remaining[from]);
+    s.creditors.pop_back();
+    s.debtors.pop_back();
+
+    const Transfer t = { from, to, cents };
+    s.transfers.push_back(t);
+    s.remaining[to]   -= cents;
+    s.remaining[from] += cents;
+
+    if (s.remaining[to] > 0) {
+      s.creditors.push_back(to);
+      std::push_heap(s.creditors.begin(), s.creditors.end(), creditorLess);
+    }
+    if (s.remaining[from] < 0) {
+      s.debtors.push_back(from);
+      std::push_heap(s.debtors.begin(), s.debtors.end(), debtorLess);
+    }
+  }  // -----  end while  -----
+}
+
+// Splits s.members into the most groups whose balances add up to zero.
+// A group of g persons needs g - 1 transfers and no fewer, so k persons
+// in z groups need k - z. groups[m] is the most groups of zero sum the
+// subset m can be split into; walking back from the full set along
+// subsets that keep the count, every subset of zero sum on the way ends
+// a group, which is then settled greedily.
+void SettleExactly (Settlement & s) {
+  const std::size_t k    = s.members.size();
+  const uint32_t    full = (uint32_t(1) << k) - 1;
+
+  std::vector<int64_t> & sums   = s.subsetSums;
+  std::vector<uint8_t> & groups = s.subsetGroups;
+  sums.resize(std::size_t(full) + 1);
+  groups.resize(std::size_t(full) + 1);
+  sums[0]   = 0;
+  groups[0] = 0;
+  for (uint32_t m = 1; m <= full; ++m) {
+    const unsigned lowest = static_cast<unsigned>(__builtin_ctz(m));
+    sums[m] = sums[m & (m - 1)] + s.balances[s.members[lowest]];
+    uint8_t most = 0;
+    for (uint32_t rest = m; rest != 0; rest &= rest - 1) {
+      most = std::max(most, groups[m ^ (rest & (~rest + 1))]);
+    }
+    groups[m] = static_cast<uint8_t>(most + (sums[m] == 0 ? 1 : 0));
+  }  // -----  end for  -----
+
+  uint32_t m    = full;
+  uint32_t last = full;
+  while (m != 0) {
+    const uint8_t keep = static_cast<uint8_t>(groups[m]
+                                              - (sums[m] == 0 ? 1 : 0));
+    uint32_t next = m;
+    for (uint32_t rest = m; rest != 0; rest &= rest - 1) {
+      next = m ^ (rest & (~rest + 1));
+      if (groups[next] == keep) {
+        break;
+      }
+    }
+    if (sums[next] == 0) {
+      s.group.clear();
+      for (uint32_t rest = last ^ next; rest != 0; rest &= rest - 1) {
+        s.group.push_back(
+          s.members[static_cast<unsigned>(__builtin_ctz(rest))]);
+      }
+      SettleGreedily(s, s.group.data(), s.group.size());
+      last = next;
+    }
+    m = next;
+  }  // -----  end while  -----
+}
+}  // -----  end of namespace  -----
+
+void InitSettlement (Settlement & s) {
+  InitArena(s.arena, kArenaBlockBytes);
+  InitNameTable(s.personNames);
+  InitNameTable(s.expenseNames);
+  s.exact = false;
+}   // -----  end of function InitSettlement  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ParsePayments
+//  Description:  Adds up the payments of the text of a payments file per
+//                person and per expense, see Settlement. Persons
+//                and expenses are found by name, the first one of a
+//                name if there are several. On failure error is set, as
+//                by ParseHouseholdText, and false is returned.
+// =========================================================================
+bool ParsePayments (const std::string_view text, const std::string & fileName,
+                    const std::vector<Person>  & persons,
+                    const std::vector<Expense> & expenses,
+                    Settlement & s, std::string & error) {
+  ResetArena(s.arena);
+  ResetNameTable(s.personNames);
+  ResetNameTable(s.expenseNames);
+  s.personOf.clear();
+  s.expenseOf.clear();
+  for (std::size_t j = 0; j < persons.size(); ++j) {
+    if (InternName(s.personNames, s.arena, persons[j].name)
+        == s.personOf.size()) {
+      s.personOf.push_back(static_cast<uint32_t>(j));
+    }
+  }
+  for (std::size_t i = 0; i < expenses.size(); ++i) {
+    if (InternName(s.expenseNames, s.arena, expenses[i].name)
+        == s.expenseOf.size()) {
+      s.expenseOf.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  s.paid.assign(persons.size(), 0);
+  s.paidCosts.assign(expenses.size(), 0);
+
+  IniScanner scanner;
+  InitIniScanner(scanner, text);
+  if (ParsePaymentLines(scanner, s) == IniSyntaxError) {
+    std::ostringstream message;
+    message << fileName << ":" << scanner.error.line << ":"
+      << scanner.error.column << ": " << scanner.error.message;
+    error = message.str();
+    return false;
+  }
+  return true;
+}   // -----  end of function ParsePayments  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  SettleBalances
+//  Description:  Sets the balance of every person, what it paid less its
+//                fair share, from the shares of a in cents, see
+//                AllocateInCents. Returns false with error set if the
+//                payments of an expense do not add up to its cost.
+// =========================================================================
+bool SettleBalances (const std::vector<Expense> & expenses,
+                     const Allocation & a, Settlement & s,
+                     std::string & error) {
+  for (std::size_t i = 0; i < expenses.size(); ++i) {
+    if (s.paidCosts[i] != a.centCosts[i]) {
+      error = "Payments of '" + expenses[i].name + "' add up to "
+              + FormatCents(s.paidCosts[i]) + ", but it costs "
+              + FormatCents(a.centCosts[i]) + ".";
+      return false;
+    }
+  }  // -----  end for  -----
+
+  const std::size_t n = s.paid.size();
+  s.owed.assign(a.centTotals.begin(), a.centTotals.begin() + n);
+  s.balances.resize(n);
+  for (std::size_t j = 0; j < n; ++j) {
+    s.balances[j] = s.paid[j] - s.owed[j];
+  }
+  return true;
+}   // -----  end of function SettleBalances  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  PlanTransfers
+//  Description:  Finds transfers that even out all balances, at most one
+//                fewer than there are persons with a balance. With exact
+//                and no more than kMaxExactMembers such persons the plan
+//                has the fewest transfers possible, see SettleExactly;
+//                s.exact tells whether it has.
+// =========================================================================
+void PlanTransfers (Settlement & s, const bool exact) {
+  s.transfers.clear();
+  s.members.clear();
+  for (std::size_t j = 0; j < s.balances.size(); ++j) {
+    if (s.balances[j] != 0) {
+      s.members.push_back(static_cast<uint32_t>(j));
+    }
+  }
+  s.remaining.assign(s.balances.begin(), s.balances.end());
+
+  s.exact = exact && s.members.size() <= kMaxExactMembers;
+  if (s.exact) {
+    SettleExactly(s);
+  } else {
+    SettleGreedily(s, s.members.data(), s.members.size());
+  }
+}   // -----  end of function PlanTransfers  -----
@@ -0,0 +1,160 @@
+//
+// =========================================================================
+//
+//       Filename:  share-model.cc
+//
+//    Description:  Defines the incremental share model. An update
+//                  adjusts one input and the running sum in O(1); the
+//                  shares are only computed when they are read.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 07:34:12 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cmath>    // fabs
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "summation.h"
+#include "share-model.h"
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+const double kModelTolerance = 1e-9;
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+const double kEpsilon = std::numeric_limits<double>::epsilon();
+
+// Adds up values from scratch, see SumCompensated. n*eps times the sum
+// of the magnitudes of the n terms, the bound of a plain sum, is kept as
+// a safe bound of the error.
+double Resum (const std::vector<double> & values, double & error) {
+  double magnitude = 0.;
+  for (std::size_t k = 0; k < values.size(); ++k) {
+    magnitude += std::fabs(values[k]);
+  }
+  error = static_cast<double>(values.size())*kEpsilon*magnitude;
+  return SumCompensated(values.data(), values.size());
+}
+
+// Replaces the term old by value in sum. Every addition adds at most
+// half an ulp of its result to the error; once the bound is no longer
+// small compared to the sum, the sum is recomputed.
+void Replace (double & sum, double & error, const double old,
+              const double value, const std::vector<double> & values,
+              uint64_t & resums) {
+  sum   += value - old;
+  error += kEpsilon*(std::fabs(value - old) + std::fabs(sum));
+  if (error > kModelTolerance*std::fabs(sum)) {
+    sum = Resum(values, error);
+    ++resums;
+  }
+}
+}  // -----  end of namespace  -----
+
+void InitShareModel (ShareModel & m, const std::vector<Person> & persons,
+                     const std::vector<Expense> & expenses) {
+  m.incomes.resize(persons.size());
+  m.costs.resize(expenses.size());
+  for (std::size_t j = 0; j < persons.size(); ++j) {
+    m.incomes[j] = persons[j].income;
+  }
+  for (std::size_t i = 0; i < expenses.size(); ++i) {
+    m.costs[i] = expenses[i].cost;
+  }
+
+  m.sumIncomes = Resum(m.incomes, m.incomeError);
+  m.sumCosts   = Resum(m.costs,   m.costError);
+  m.ratio      = 1./m.sumIncomes;
+  m.updates    = 0;
+  m.resums     = 0;
+}   // -----  end of function InitShareModel  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  UpdateIncome
+//  Description:  Sets the income of person to income in O(1). All shares
+//                change with the ratio; read them through ModelShare and
+//                ModelTotal.
+// =========================================================================
+void UpdateIncome (ShareModel & m, const std::size_t person,
+                   const double income) {
+  const double old = m.incomes[person];
+  m.incomes[person] = income;
+  Replace(m.sumIncomes, m.incomeError, old, income, m.incomes, m.resums);
+  m.ratio = 1./m.sumIncomes;
+  ++m.updates;
+}   // -----  end of function UpdateIncome  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  UpdateCost
+//  Description:  Sets the cost of expense to cost in O(1). Only the
+//                column of the expense and the totals change; the column
+//                is written out by ExpenseColumn.
+// =========================================================================
+void UpdateCost (ShareModel & m, const std::size_t expense,
+                 const double cost) {
+  const double old = m.costs[expense];
+  m.costs[expense] = cost;
+  Replace(m.sumCosts, m.costError, old, cost, m.costs, m.resums);
+  ++m.updates;
+}   // -----  end of function UpdateCost  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ExpenseColumn
+//  Description:  Writes the share of every person of expense into
+//                shares, one entry per person.
+// =========================================================================
+void ExpenseColumn (const ShareModel & m, const std::size_t expense,
+                    double * shares) {
+  const double scaled = m.ratio*m.costs[expense];
+  for (std::size_t j = 0; j < m.incomes.size(); ++j) {
+    shares[j] = m.incomes[j]*scaled;
+  }
+}   // -----  end of function ExpenseColumn  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ShareModelDeviation
+//  Description:  Consistency check: recomputes all shares and totals of
+//                the current inputs from scratch with AllocateShares into
+//                scratch and returns the largest difference to the lazy
+//                view, relative to the larger of the value and 1.
+// =========================================================================
+double ShareModelDeviation (const ShareModel & m, Allocation & scratch) {
+  const std::size_t n = m.incomes.size();
+  const std::size_t e = m.costs.size();
+
+  scratch.shares.resize(n*e);
+  scratch.totals.resize(n);
+  AllocateShares(m.incomes.data(), n, m.costs.data(), e,
+                 scratch.shares.data(), scratch.totals.data());
+
+  double deviation = 0.;
+  for (std::size_t j = 0; j < n; ++j) {
+    for (std::size_t i = 0; i < e; ++i) {
+      const double full = scratch.shares[j*e + i];
+      const double d    = std::fabs(ModelShare(m, j, i) - full)
+                          / std::fmax(1., std::fabs(full));
+      deviation = std::fmax(deviation, d);
+    }
+    const double full = scratch.totals[j];
+    const double d    = std::fabs(ModelTotal(m, j) - full)
+                        / std::fmax(1., std::fabs(full));
+    deviation = std::fmax(deviation, d);
+  }
+  return deviation;
+}   // -----  end of function ShareModelDeviation  -----
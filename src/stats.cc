@@ -0,0 +1,250 @@
+//
+// =========================================================================
+//
+//       Filename:  stats.cc
+//
+//    Description:  Defines the log2 latency histograms and, if
+//                  FAIRSHARE_STATS is defined, the recording of phases
+//                  and counters. A timer reads the monotonic clock twice
+//                  and adds to the RunStats of its thread, so threads
+//                  never share a cache line while they record; only
+//                  MergeThreadStats takes a lock.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 05:02:37 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <charconv>   // to_chars
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "stats.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+void AppendUnsigned (std::string & out, const uint64_t x) {
+  char buffer[24];
+  const std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), x);
+  out.append(buffer, r.ptr);
+}
+
+#ifdef FAIRSHARE_STATS
+const char * const kPhaseNames[kStatsPhases] = {
+  "arguments", "parse", "check_income", "allocate", "output", "household",
+  "query",
+};
+const char * const kCounterNames[kStatsCounters] = {
+  "records", "bytes_read", "bytes_written", "allocations", "allocated_bytes",
+};
+
+// zero initialized, so neither needs a constructor nor a guard
+thread_local RunStats threadStats;
+RunStats              processStats;
+std::mutex            processMutex;
+
+void AddStats (RunStats & to, RunStats & from) {
+  for (std::size_t p = 0; p < kStatsPhases; ++p) {
+    LatencyHistogram & h = to.phases[p];
+    LatencyHistogram & g = from.phases[p];
+    for (std::size_t b = 0; b < kLatencyBuckets; ++b) {
+      h.counts[b] += g.counts[b];
+    }
+    h.requests += g.requests;
+    h.maxNs     = g.maxNs > h.maxNs ? g.maxNs : h.maxNs;
+    to.phaseNs[p] += from.phaseNs[p];
+  }
+  for (std::size_t c = 0; c < kStatsCounters; ++c) {
+    to.counters[c] += from.counters[c];
+  }
+}
+#endif   //---- #ifdef FAIRSHARE_STATS  -----
+}  // -----  end of namespace  -----
+
+void ClearLatencies (LatencyHistogram & h) {
+  for (std::size_t b = 0; b < kLatencyBuckets; ++b) {
+    h.counts[b] = 0;
+  }
+  h.requests = 0;
+  h.maxNs    = 0;
+}   // -----  end of function ClearLatencies  -----
+
+void RecordLatency (LatencyHistogram & h, const uint64_t ns) {
+  std::size_t b = static_cast<std::size_t>(63 - __builtin_clzll(ns | 1));
+  if (b >= kLatencyBuckets) {
+    b = kLatencyBuckets - 1;
+  }
+  ++h.counts[b];
+  ++h.requests;
+  h.maxNs = ns > h.maxNs ? ns : h.maxNs;
+}   // -----  end of function RecordLatency  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  LatencyPercentile
+//  Description:  Returns an upper bound of the p-th percentile, 0 <= p
+//                <= 1, of the recorded latencies in nanoseconds: the end
+//                of its bucket, but no more than the largest latency.
+// =========================================================================
+uint64_t LatencyPercentile (const LatencyHistogram & h, const double p) {
+  const double rank = p*static_cast<double>(h.requests);
+  uint64_t     seen = 0;
+  for (std::size_t b = 0; b < kLatencyBuckets; ++b) {
+    seen += h.counts[b];
+    if (seen > 0 && static_cast<double>(seen) >= rank) {
+      const uint64_t end = uint64_t(2) << b;
+      return end < h.maxNs ? end : h.maxNs;
+    }
+  }  // -----  end for  -----
+  return h.maxNs;
+}   // -----  end of function LatencyPercentile  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  WriteLatencies
+//  Description:  Appends the summary and the non-empty buckets of h as
+//                lines of "name value", e.g. "p99_ns 8192" and
+//                "bucket_ns 4096 17" for 17 requests in [4096, 8192).
+// =========================================================================
+void WriteLatencies (const LatencyHistogram & h, std::string & out) {
+  const char * kNames[]       = { "p50_ns ", "p90_ns ", "p99_ns ", "p999_ns " };
+  const double kPercentiles[] = { 0.5, 0.9, 0.99, 0.999 };
+
+  out.append("requests ");
+  AppendUnsigned(out, h.requests);
+  out.push_back('\n');
+  for (std::size_t k = 0; k < 4; ++k) {
+    out.append(kNames[k]);
+    AppendUnsigned(out, LatencyPercentile(h, kPercentiles[k]));
+    out.push_back('\n');
+  }
+  out.append("max_ns ");
+  AppendUnsigned(out, h.maxNs);
+  out.push_back('\n');
+
+  for (std::size_t b = 0; b < kLatencyBuckets; ++b) {
+    if (h.counts[b] > 0) {
+      out.append("bucket_ns ");
+      AppendUnsigned(out, uint64_t(1) << b);
+      out.push_back(' ');
+      AppendUnsigned(out, h.counts[b]);
+      out.push_back('\n');
+    }
+  }  // -----  end for  -----
+}   // -----  end of function WriteLatencies  -----
+
+#ifdef FAIRSHARE_STATS
+
+uint64_t StatsClockNs () {
+  return static_cast<uint64_t>(std::chrono::duration_cast<
+    std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}   // -----  end of function StatsClockNs  -----
+
+void RecordPhase (const StatsPhase phase, const uint64_t ns) {
+  RecordLatency(threadStats.phases[phase], ns);
+  threadStats.phaseNs[phase] += ns;
+}   // -----  end of function RecordPhase  -----
+
+void CountStat (const StatsCounter counter, const uint64_t n) {
+  threadStats.counters[counter] += n;
+}   // -----  end of function CountStat  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  MergeThreadStats
+//  Description:  Adds what the calling thread recorded to the stats of
+//                the process and clears it. Every thread but the main
+//                one has to call it before it ends.
+// =========================================================================
+void MergeThreadStats () {
+  std::lock_guard<std::mutex> lock(processMutex);
+  AddStats(processStats, threadStats);
+  threadStats = RunStats();
+}   // -----  end of function MergeThreadStats  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  CollectStats
+//  Description:  Merges the stats of the calling thread and copies those
+//                of the process into s. Returns false if the stats are
+//                compiled out.
+// =========================================================================
+bool CollectStats (RunStats & s) {
+  MergeThreadStats();
+  std::lock_guard<std::mutex> lock(processMutex);
+  s = processStats;
+  return true;
+}   // -----  end of function CollectStats  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  WriteStatsJson
+//  Description:  Appends s as one line of JSON: per phase the calls, the
+//                total, largest and percentile durations and the
+//                non-empty buckets as [start_ns, count] pairs, then the
+//                counters, e.g.
+//
+//                  {"phases":{"parse":{"calls":1,"total_ns":5120,...,
+//                   "buckets":[[4096,1]]},...},"counters":{"records":7,
+//                   ...}}
+// =========================================================================
+void WriteStatsJson (const RunStats & s, std::string & out) {
+  const char * kNames[]       = { "p50_ns", "p90_ns", "p99_ns" };
+  const double kPercentiles[] = { 0.5, 0.9, 0.99 };
+
+  out.append("{\"phases\":{");
+  for (std::size_t p = 0; p < kStatsPhases; ++p) {
+    const LatencyHistogram & h = s.phases[p];
+    if (p > 0) {
+      out.push_back(',');
+    }
+    out.push_back('"');
+    out.append(kPhaseNames[p]);
+    out.append("\":{\"calls\":");
+    AppendUnsigned(out, h.requests);
+    out.append(",\"total_ns\":");
+    AppendUnsigned(out, s.phaseNs[p]);
+    out.append(",\"max_ns\":");
+    AppendUnsigned(out, h.maxNs);
+    for (std::size_t k = 0; k < 3; ++k) {
+      out.append(",\"");
+      out.append(kNames[k]);
+      out.append("\":");
+      AppendUnsigned(out, LatencyPercentile(h, kPercentiles[k]));
+    }
+    out.append(",\"buckets\":[");
+    bool first = true;
+    for (std::size_t b = 0; b < kLatencyBuckets; ++b) {
+      if (h.counts[b] > 0) {
+        out.append(first ? "[" : ",[");
+        AppendUnsigned(out, uint64_t(1) << b);
+        out.push_back(',');
+        AppendUnsigned(out, h.counts[b]);
+        out.push_back(']');
+        first = false;
+      }
+    }  // -----  end for  -----
+    out.append("]}");
+  }  // -----  end for  -----
+
+  out.append("},\"counters\":{");
+  for (std::size_t c = 0; c < kStatsCounters; ++c) {
+    if (c > 0) {
+      out.push_back(',');
+    }
+    out.push_back('"');
+    out.append(kCounterNames[c]);
+    out.append("\":");
+    AppendUnsigned(out, s.counters[c]);
+  }
+  out.append("}}\n");
+}   // -----  end of function WriteStatsJson  -----
+
+#endif   //---- #ifdef FAIRSHARE_STATS  -----
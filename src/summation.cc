@@ -0,0 +1,198 @@
+//
+// =========================================================================
+//
+//       Filename:  summation.cc
+//
+//    Description:  Defines the reproducible sums, see summation.h. This
+//                  file is compiled with -fno-fast-math and
+//                  -ffp-contract=off in every build, so every addition
+//                  is done as written, in the order written. The sums
+//                  are spread over kLanes partial sums side by side,
+//                  which the compiler vectorizes without reordering
+//                  anything, and the lanes are added up in a fixed order
+//                  at the end.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 01:37:52 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstddef>
+
+#include "summation.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+const std::size_t kLanes = 4;
+
+// the blocks of SumPairwise, summed in lanes
+const std::size_t kPairwiseBlock = 256;
+
+// t + e = s + x exactly, with t the rounded sum (Knuth's TwoSum); unlike
+// Fast2Sum it needs no branch on which of s and x is larger
+inline void TwoSum (const double s, const double x, double & t, double & e) {
+  t = s + x;
+  const double z = t - s;
+  e = (s - (t - z)) + (x - z);
+}
+
+inline double SumLanes (const double * x, const std::size_t n) {
+  // the incomes of a household, in a row
+  if (n < kLanes) {
+    double sum = n > 0 ? x[0] : 0.;
+    for (std::size_t k = 1; k < n; ++k) {
+      sum += x[k];
+    }
+    return sum;
+  }
+
+  // the lanes start from the first four rather than from zero, which
+  // keeps an addition off the critical path of short arrays; they are
+  // named rather than an array, so that they stay in registers
+  double      lane0 = x[0];
+  double      lane1 = x[1];
+  double      lane2 = x[2];
+  double      lane3 = x[3];
+  std::size_t k     = kLanes;
+  for (; k + kLanes <= n; k += kLanes) {
+    lane0 += x[k];
+    lane1 += x[k + 1];
+    lane2 += x[k + 2];
+    lane3 += x[k + 3];
+  }
+  if (k < n) {
+    lane0 += x[k];
+  }
+  if (k + 1 < n) {
+    lane1 += x[k + 1];
+  }
+  if (k + 2 < n) {
+    lane2 += x[k + 2];
+  }
+  return (lane0 + lane1) + (lane2 + lane3);
+}
+
+// the recursion of SumPairwise, apart so that the sums of short arrays
+// get by without saving registers
+__attribute__((noinline))
+double SumHalves (const double * x, const std::size_t n) {
+  // the first half a multiple of whole blocks
+  const std::size_t half = (n/2 + kPairwiseBlock - 1)/kPairwiseBlock
+                           *kPairwiseBlock;
+  return SumPairwise(x, half) + SumPairwise(x + half, n - half);
+}
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  SumPairwise
+//  Description:  Returns the sum of x[0..n), adding up the halves of
+//                the array recursively down to blocks of kPairwiseBlock.
+//                The error grows with log n instead of n, at the speed
+//                of a plain loop.
+// =========================================================================
+double SumPairwise (const double * x, const std::size_t n) {
+  if (n <= kPairwiseBlock) {
+    return SumLanes(x, n);
+  }
+  return SumHalves(x, n);
+}   // -----  end of function SumPairwise  -----
+
+// SumPairwise of N values, with the branches on the length resolved
+template <std::size_t N>
+double SumFixed (const double * x, std::size_t) {
+  return SumLanes(x, N);
+}   // -----  end of function SumFixed  -----
+
+template double SumFixed<1> (const double *, std::size_t);
+template double SumFixed<2> (const double *, std::size_t);
+template double SumFixed<3> (const double *, std::size_t);
+template double SumFixed<4> (const double *, std::size_t);
+template double SumFixed<5> (const double *, std::size_t);
+template double SumFixed<6> (const double *, std::size_t);
+template double SumFixed<7> (const double *, std::size_t);
+template double SumFixed<8> (const double *, std::size_t);
+
+// ===  FUNCTION  ==========================================================
+//         Name:  SumCompensated
+//  Description:  Returns the sum of x[0..n), the low bits lost by every
+//                addition kept in an error term per lane (Kahan-Babuska,
+//                by TwoSum) and added at the end. The lanes are joined
+//                the same way. The result is off by about an ulp of the
+//                sum, whatever n, as long as n*eps is small.
+// =========================================================================
+double SumCompensated (const double * x, const std::size_t n) {
+  double      sums[kLanes]   = { 0., 0., 0., 0. };
+  double      errors[kLanes] = { 0., 0., 0., 0. };
+  std::size_t k              = 0;
+  for (; k + kLanes <= n; k += kLanes) {
+    for (std::size_t l = 0; l < kLanes; ++l) {
+      double t;
+      double e;
+      TwoSum(sums[l], x[k + l], t, e);
+      sums[l]    = t;
+      errors[l] += e;
+    }
+  }  // -----  end for  -----
+  for (std::size_t l = 0; k < n; ++k, ++l) {
+    double t;
+    double e;
+    TwoSum(sums[l], x[k], t, e);
+    sums[l]    = t;
+    errors[l] += e;
+  }  // -----  end for  -----
+
+  double sum   = sums[0];
+  double error = errors[0];
+  for (std::size_t l = 1; l < kLanes; ++l) {
+    double t;
+    double e;
+    TwoSum(sum, sums[l], t, e);
+    sum    = t;
+    error += e + errors[l];
+  }  // -----  end for  -----
+  return sum + error;
+}   // -----  end of function SumCompensated  -----
+
+void InitCompensatedSum (CompensatedSum & s) {
+  s.sum   = 0.;
+  s.error = 0.;
+}   // -----  end of function InitCompensatedSum  -----
+
+// for amounts that are not side by side, e.g. the incomes of persons
+void AddCompensated (CompensatedSum & s, const double x) {
+  double t;
+  double e;
+  TwoSum(s.sum, x, t, e);
+  s.sum    = t;
+  s.error += e;
+}   // -----  end of function AddCompensated  -----
+
+double CompensatedTotal (const CompensatedSum & s) {
+  return s.sum + s.error;
+}   // -----  end of function CompensatedTotal  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  AccumulateCompensated
+//  Description:  Adds x[k] to the running total totals[k] for every k
+//                < n. totals always holds the rounded value of the exact
+//                running total, errors what is left of it, so totals
+//                does not drift over any number of additions.
+// =========================================================================
+void AccumulateCompensated (double *__restrict totals,
+                            double *__restrict errors,
+                            const double *__restrict x, const std::size_t n) {
+  for (std::size_t k = 0; k < n; ++k) {
+    double t;
+    double e;
+    TwoSum(totals[k], x[k], t, e);
+    TwoSum(t, errors[k] + e, totals[k], errors[k]);
+  }
+}   // -----  end of function AccumulateCompensated  -----
@@ -0,0 +1,407 @@
+//
+// =========================================================================
+//
+//       Filename:  sweep.cc
+//
+//    Description:  Defines the sweep engine, see sweep.h. Every swept
+//                  amount enters the split linearly, so the household is
+//                  reduced once to a few constants per person and every
+//                  scenario costs a division and a multiply-add per
+//                  person, in loops over a block of scenarios that the
+//                  compiler vectorizes.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 07:26:50 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cmath>        // floor
+#include <cstddef>
+#include <cstdint>
+#include <iostream>     // input/output streams, e.g. cout and cin
+#include <sstream>      // string streams to join different strings
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "helper-functions.h"
+#include "summation.h"
+#include "sweep.h"
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+// 1024 scenarios of a few persons fit the L1 and L2 caches
+const std::size_t kSweepBlock        = 1024;
+const uint64_t    kMaxSweepScenarios = uint64_t(1) << 40;
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+// the last value may fall short of stop by rounding, hence the slack
+const double kStepSlack = 1e-9;
+
+bool IsZero (const double x) {
+  return x <= 0. && x >= 0.;
+}
+
+bool IsDigits (const std::string_view s) {
+  if (s.empty()) {
+    return false;
+  }
+  for (std::size_t k = 0; k < s.size(); ++k) {
+    if (s[k] < '0' || s[k] > '9') {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParseAmount (const std::string_view s, const std::string_view spec,
+                  double & x, std::string & error) {
+  const Conversion c = ParseDouble(s);
+  if (c.error != ConversionOk) {
+    error = "Sweep '" + std::string(spec) + "': " + std::string(s) + ": "
+            + ConversionErrorMessage(c.error);
+    return false;
+  }
+  x = c.value;
+  return true;
+}
+
+// what a swept person or expense is called in the errors
+std::string AxisName (const std::vector<Person> & p,
+                      const std::vector<Expense> & e, const SweepAxis & a) {
+  return a.expense ? "expense '" + e[a.index].name + "'"
+                   : "the income of '" + p[a.index].name + "'";
+}
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ParseSweepAxis
+//  Description:  Parses spec, given as key=start:stop:step, into axis,
+//                see SweepAxis. Returns false and sets error if it is
+//                malformed, names no person or expense of p and e, or
+//                its step does not lead from start to stop.
+// =========================================================================
+bool ParseSweepAxis (const std::string_view spec,
+                     const std::vector<Person> & p,
+                     const std::vector<Expense> & e, SweepAxis & axis,
+                     std::string & error) {
+  const std::size_t equals = spec.find('=');
+  const std::size_t colon1 = spec.find(':', equals);
+  const std::size_t colon2 = colon1 == std::string_view::npos
+                             ? colon1 : spec.find(':', colon1 + 1);
+  if (equals == std::string_view::npos || colon2 == std::string_view::npos) {
+    error = "Sweep '" + std::string(spec)
+            + "' is not of the form key=start:stop:step.";
+    return false;
+  }
+
+  const std::string_view key = spec.substr(0, equals);
+  if (IsDigits(key)) {
+    const unsigned long n = std::stoul(std::string(key));
+    if (n < 1 || n > p.size()) {
+      error = "Sweep '" + std::string(spec) + "': there is no person "
+              + std::string(key) + ".";
+      return false;
+    }
+    axis.expense = false;
+    axis.index   = n - 1;
+  } else {
+    std::size_t i = 0;
+    while (i < e.size() && e[i].name != key) {
+      ++i;
+    }
+    if (i == e.size()) {
+      error = "Sweep '" + std::string(spec) + "': there is no expense '"
+              + std::string(key) + "'.";
+      return false;
+    }
+    axis.expense = true;
+    axis.index   = i;
+  }
+
+  double stop;
+  if (!ParseAmount(spec.substr(equals + 1, colon1 - equals - 1), spec,
+                   axis.start, error)
+      || !ParseAmount(spec.substr(colon1 + 1, colon2 - colon1 - 1), spec,
+                      stop, error)
+      || !ParseAmount(spec.substr(colon2 + 1), spec, axis.step, error)) {
+    return false;
+  }
+
+  const double span = IsZero(axis.step) ? -1. : (stop - axis.start)/axis.step;
+  if (span < 0.) {
+    error = "Sweep '" + std::string(spec) + "': the step does not lead from "
+            "start to stop.";
+    return false;
+  }
+  if (span >= static_cast<double>(kMaxSweepScenarios)) {
+    error = "Sweep '" + std::string(spec) + "' has too many values.";
+    return false;
+  }
+  axis.count = static_cast<uint64_t>(span + kStepSlack) + 1;
+  return true;
+}   // -----  end of function ParseSweepAxis  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  PrepareSweep
+//  Description:  Reduces the household p and e to the constants of
+//                s.axes, see Sweep, and sizes the block. Returns false
+//                and sets error if an amount is swept twice, the grid is
+//                too large, the policies do not fit, see CheckPolicies,
+//                or an income is zero, in any scenario.
+// =========================================================================
+bool PrepareSweep (const std::vector<Person> & p,
+                   const std::vector<Expense> & e, Sweep & s,
+                   std::string & error) {
+  const std::size_t n    = p.size();
+  const std::size_t axes = s.axes.size();
+
+  const char * reason = CheckPolicies(p, e, false);
+  if (reason != NULL) {
+    error = reason;
+    return false;
+  }
+
+  s.persons   = n;
+  s.scenarios = 1;
+  s.strides.assign(axes, 1);
+  s.sweptBy.assign(n, axes);
+  std::vector<std::size_t> expenseAxes(e.size(), axes);
+  for (std::size_t k = axes; k-- > 0; ) {
+    const SweepAxis & a    = s.axes[k];
+    std::size_t     & seen = a.expense ? expenseAxes[a.index]
+                                       : s.sweptBy[a.index];
+    if (seen != axes) {
+      error = "Sweep of " + AxisName(p, e, a) + " is given twice.";
+      return false;
+    }
+    seen         = k;
+    s.strides[k] = s.scenarios;
+    if (a.count > kMaxSweepScenarios/s.scenarios) {
+      error = "The sweep has more than "
+              + std::to_string(kMaxSweepScenarios) + " scenarios.";
+      return false;
+    }
+    s.scenarios *= a.count;
+
+    // the only value that can be zero is the one closest to -start/step
+    const double zero = std::floor(-a.start/a.step + 0.5);
+    if (!a.expense && zero >= 0. && zero < static_cast<double>(a.count)
+        && IsZero(a.start + a.step*zero)) {
+      error = "Sweep of " + AxisName(p, e, a) + " reaches zero.";
+      return false;
+    }
+  }  // -----  end for  -----
+
+  s.incomes.assign(n, 0.);
+  for (std::size_t j = 0; j < n; ++j) {
+    if (s.sweptBy[j] == axes) {
+      if (IsZero(p[j].income)) {
+        error = "Income of '" + p[j].name + "' is zero.";
+        return false;
+      }
+      s.incomes[j] = p[j].income;
+    }
+  }  // -----  end for  -----
+  s.incomeSum = SumPairwise(s.incomes.data(), n);
+
+  // alpha and beta per expense, the part of a swept cost that is split by
+  // income and the part person j pays on top; the costs not swept are
+  // summed pairwise in the order of the ledger, as by Allocate, split and
+  // the constants compensated, as their terms come one at a time
+  CompensatedSum split;
+  InitCompensatedSum(split);
+  std::vector<CompensatedSum> constants(n);
+  for (std::size_t j = 0; j < n; ++j) {
+    InitCompensatedSum(constants[j]);
+  }
+  std::vector<double> costs;
+  s.alphas.assign(axes, 0.);
+  s.betas.assign(axes*n, 0.);
+  std::vector<double> betas(n);
+  for (std::size_t i = 0; i < e.size(); ++i) {
+    const Expense & x     = e[i];
+    double          alpha = 1.;
+    double          fixed = 0.;
+    betas.assign(n, 0.);
+    switch (x.policy) {
+      case PolicyEqual:
+        alpha = 0.;
+        betas.assign(n, 1./static_cast<double>(n));
+        break;
+      case PolicyWeighted: {
+        const double sumWeights = SumPairwise(x.weights.data(), n);
+        alpha = 0.;
+        for (std::size_t j = 0; j < n; ++j) {
+          betas[j] = x.weights[j]/sumWeights;
+        }
+        break;
+      }
+      case PolicyFixed:
+        // the fixed amounts do not depend on the cost
+        fixed = SumPairwise(x.weights.data(), n);
+        for (std::size_t j = 0; j < n; ++j) {
+          AddCompensated(constants[j], x.weights[j]);
+        }
+        break;
+      case PolicyIncome:
+      default:
+        break;
+    }  // -----  end switch  -----
+
+    AddCompensated(split, -fixed);
+    if (expenseAxes[i] != axes) {
+      s.alphas[expenseAxes[i]] = alpha;
+      for (std::size_t j = 0; j < n; ++j) {
+        s.betas[expenseAxes[i]*n + j] = betas[j];
+      }
+    } else {
+      AddCompensated(split, alpha*x.cost);
+      costs.push_back(x.cost);
+      for (std::size_t j = 0; j < n; ++j) {
+        AddCompensated(constants[j], betas[j]*x.cost);
+      }
+    }
+  }  // -----  end for  -----
+  s.split   = CompensatedTotal(split);
+  s.costSum = SumPairwise(costs.data(), costs.size());
+  s.constants.resize(n);
+  for (std::size_t j = 0; j < n; ++j) {
+    s.constants[j] = CompensatedTotal(constants[j]);
+  }
+
+  s.first = 0;
+  s.size  = 0;
+  s.values.assign(axes*kSweepBlock, 0.);
+  s.ramp.resize(kSweepBlock);
+  for (std::size_t t = 0; t < kSweepBlock; ++t) {
+    s.ramp[t] = static_cast<double>(t);
+  }
+  s.sums.assign(kSweepBlock, 0.);
+  s.splits.assign(kSweepBlock, 0.);
+  s.costs.assign(kSweepBlock, 0.);
+  s.rates.assign(kSweepBlock, 0.);
+  s.shares.assign(kSweepBlock, 0.);
+  s.totals.assign(n*kSweepBlock, 0.);
+  return true;
+}   // -----  end of function PrepareSweep  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  NextSweepBlock
+//  Description:  Evaluates the next block of up to kSweepBlock scenarios
+//                of s after PrepareSweep. Returns false once every
+//                scenario was evaluated.
+// =========================================================================
+bool NextSweepBlock (Sweep & s) {
+  s.first += s.size;
+  if (s.first >= s.scenarios) {
+    s.size = 0;
+    return false;
+  }
+  const uint64_t    left = s.scenarios - s.first;
+  const std::size_t size = left < kSweepBlock
+                           ? static_cast<std::size_t>(left) : kSweepBlock;
+  const std::size_t axes = s.axes.size();
+  s.size = size;
+
+  // the values of every axis, which stay for stride scenarios each; the
+  // last axis counts up by one step per scenario until it wraps around
+  for (std::size_t k = 0; k < axes; ++k) {
+    const SweepAxis &  a      = s.axes[k];
+    const uint64_t     stride = s.strides[k];
+    uint64_t           digit  = s.first/stride % a.count;
+    uint64_t           run    = stride - s.first % stride;
+    double *__restrict values = s.values.data() + k*kSweepBlock;
+    for (std::size_t t = 0; t < size; ) {
+      const std::size_t length = stride > 1
+        ? static_cast<std::size_t>(run < size - t ? run : size - t)
+        : static_cast<std::size_t>(a.count - digit < size - t
+                                   ? a.count - digit : size - t);
+      if (stride > 1) {
+        const double value = a.start + a.step*static_cast<double>(digit);
+        for (std::size_t i = 0; i < length; ++i) {
+          values[t + i] = value;
+        }
+        digit = digit + 1 == a.count ? 0 : digit + 1;
+        run   = stride;
+      } else {
+        const double             first = static_cast<double>(digit);
+        const double *__restrict ramp  = s.ramp.data();
+        for (std::size_t i = 0; i < length; ++i) {
+          values[t + i] = a.start + a.step*(first + ramp[i]);
+        }
+        digit = 0;
+      }
+      t += length;
+    }  // -----  end for  -----
+  }  // -----  end for axes  -----
+
+  double *__restrict sums   = s.sums.data();
+  double *__restrict splits = s.splits.data();
+  double *__restrict costs  = s.costs.data();
+  double *__restrict rates  = s.rates.data();
+  double *__restrict shares = s.shares.data();
+  for (std::size_t t = 0; t < size; ++t) {
+    sums[t]   = s.incomeSum;
+    splits[t] = s.split;
+    costs[t]  = s.costSum;
+  }
+  for (std::size_t k = 0; k < axes; ++k) {
+    const double *__restrict values = s.values.data() + k*kSweepBlock;
+    const double             alpha  = s.alphas[k];
+    if (!s.axes[k].expense) {
+      for (std::size_t t = 0; t < size; ++t) {
+        sums[t] += values[t];
+      }
+    } else {
+      for (std::size_t t = 0; t < size; ++t) {
+        splits[t] += alpha*values[t];
+        costs[t]  += values[t];
+      }
+    }
+  }  // -----  end for axes  -----
+  for (std::size_t t = 0; t < size; ++t) {
+    rates[t]  = splits[t]/sums[t];
+    shares[t] = costs[t]/sums[t];
+  }
+
+  for (std::size_t j = 0; j < s.persons; ++j) {
+    double *__restrict total    = s.totals.data() + j*kSweepBlock;
+    const double       constant = s.constants[j];
+    if (s.sweptBy[j] < axes) {
+      const double *__restrict incomes = s.values.data()
+                                         + s.sweptBy[j]*kSweepBlock;
+      for (std::size_t t = 0; t < size; ++t) {
+        total[t] = incomes[t]*rates[t] + constant;
+      }
+    } else {
+      const double income = s.incomes[j];
+      for (std::size_t t = 0; t < size; ++t) {
+        total[t] = income*rates[t] + constant;
+      }
+    }
+    for (std::size_t k = 0; k < axes; ++k) {
+      const double *__restrict values = s.values.data() + k*kSweepBlock;
+      const double             beta   = s.betas[k*s.persons + j];
+      if (IsZero(beta)) {
+        continue;
+      }
+      for (std::size_t t = 0; t < size; ++t) {
+        total[t] += beta*values[t];
+      }
+    }  // -----  end for axes  -----
+  }  // -----  end for persons  -----
+  return true;
+}   // -----  end of function NextSweepBlock  -----
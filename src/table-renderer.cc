@@ -0,0 +1,241 @@
+//
+// =========================================================================
+//
+//       Filename:  table-renderer.cc
+//
+//    Description:  Renders the results table into a string. Every number
+//                  is formatted exactly once by FormatFixed2, the column
+//                  width is found while formatting, and the padding is
+//                  appended in blocks instead of by stream manipulators.
+//                  The output is byte for byte the one of the former
+//                  iostream implementation of DisplayResults.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 04:02:55 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <algorithm> // max
+#include <charconv>  // to_chars
+#include <cmath>     // nearbyint
+#include <cstddef>
+#include <cstdint>
+#include <cstring>   // memcpy
+#include <string>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "table-renderer.h"
+#include "global-constants.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+// longest double printed with two decimals, e.g. -1.8e308
+const std::size_t kMaxNumberLength = 320;
+
+// appends s right aligned in a field of width characters
+void AppendRight (std::string & out, const char * s, const std::size_t length,
+                  const std::size_t width) {
+  if (length < width) {
+    out.append(width - length, ' ');
+  }
+  out.append(s, length);
+}
+
+// appends s left aligned in a field of width characters
+void AppendLeft (std::string & out, const char * s, const std::size_t length,
+                 const std::size_t width) {
+  out.append(s, length);
+  if (length < width) {
+    out.append(width - length, ' ');
+  }
+}
+
+void AppendLine (std::string & out, const char fill, const char separator,
+                 const char last, const std::size_t width,
+                 const std::size_t columns) {
+  out.push_back(' ');
+  for (std::size_t c = 0; c + 1 < columns; ++c) {
+    out.append(width, fill);
+    out.push_back(separator);
+  }
+  out.append(width, fill);
+  out.push_back(last);
+  out.push_back('\n');
+}
+
+// formats x at the end of b.numbers and returns its length
+std::size_t PushNumber (TableBuffer & b, const double x) {
+  const std::size_t begin = b.ends.empty() ? 0 : b.ends.back();
+  if (b.numbers.size() < begin + kMaxNumberLength) {
+    b.numbers.resize(2*(begin + kMaxNumberLength));
+  }
+  const std::size_t length = FormatFixed2(x, b.numbers.data() + begin,
+                                          b.numbers.data() + b.numbers.size());
+  b.ends.push_back(begin + length);
+  return length;
+}
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  FormatFixed2
+//  Description:  Writes x with two decimals, as std::fixed with
+//                std::setprecision(2) does, into [first,last) and returns
+//                the number of characters written.
+//
+//                Amounts below 2^40 cents are rounded to whole cents in
+//                double precision, which is off from the exact decimal
+//                value of x by less than 1e-4 cents. Only when the cents
+//                are that close to a tie, the rounding is left to
+//                to_chars, which works on the exact value.
+// =========================================================================
+std::size_t FormatFixed2 (const double x, char * first, char * last) {
+  const double scaled = 100.*x;
+
+  if (std::fabs(scaled) < 1099511627776.) { // 2^40
+    const double rounded = std::nearbyint(scaled);
+    if (std::fabs(scaled - rounded) < 0.499) {
+      uint64_t cents = static_cast<uint64_t>(std::fabs(rounded));
+
+      // digits from the back, at least one before the point
+      char   digits[24];
+      char * d = digits + sizeof(digits);
+      *--d = static_cast<char>('0' + cents % 10);
+      cents /= 10;
+      *--d = static_cast<char>('0' + cents % 10);
+      cents /= 10;
+      *--d = '.';
+      do {
+        *--d = static_cast<char>('0' + cents % 10);
+        cents /= 10;
+      } while (cents > 0);
+      // from the bits, -ffast-math ignores the sign of zero otherwise
+      uint64_t bits;
+      std::memcpy(&bits, &x, sizeof(bits));
+      if (bits >> 63) {
+        *--d = '-';
+      }
+
+      const std::size_t length =
+        static_cast<std::size_t>(digits + sizeof(digits) - d);
+      if (length <= static_cast<std::size_t>(last - first)) {
+        std::memcpy(first, d, length);
+        return length;
+      }
+    }
+  }
+
+  const std::to_chars_result r =
+    std::to_chars(first, last, x, std::chars_format::fixed, 2);
+  return static_cast<std::size_t>(r.ptr - first);
+}   // -----  end of function FormatFixed2  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  RenderTable
+//  Description:  Renders the table of DisplayResults into b.text.
+//
+//                The first pass formats all numbers into b.numbers and
+//                finds the column width: the longest of "Name/Costs",
+//                the names, the incomes and the sum of the costs, plus 4
+//                for a space before and three spaces behind. The second
+//                pass copies the numbers into the padded columns.
+// =========================================================================
+void RenderTable (const std::vector<Person>  & p,
+                  const std::vector<Expense> & e,
+                  const Allocation & a, TableBuffer & b) {
+
+  const std::size_t n = p.size();
+  const std::size_t m = e.size();
+
+  // first pass: format, in the order they are displayed
+  b.ends.clear();
+  b.ends.reserve(m + 1 + n*(m + 2) + 1);
+
+  std::size_t width = 10; // widths of the string "Name/Costs"
+  for (std::size_t i = 0; i < m; ++i) {
+    PushNumber(b, e[i].cost);
+    width = std::max(width, e[i].name.size());
+  }
+  width = std::max(width, PushNumber(b, a.sumCosts));
+  for (std::size_t j = 0; j < n; ++j) {
+    width = std::max(width, p[j].name.size());
+    width = std::max(width, PushNumber(b, p[j].income));
+    for (std::size_t i = 0; i < m; ++i) {
+      PushNumber(b, Share(a, j, i));
+    }
+    PushNumber(b, a.totals[j]);
+  }
+  PushNumber(b, 100.*a.sumCosts*a.ratio);
+  width += 4; // to add a space before the word and three spaces behind
+
+  // second pass: layout
+  std::string & out = b.text;
+  out.clear();
+  out.reserve((n + 1)*2*(m + 3)*(width + 1) + 256);
+
+  const char *      numbers = b.numbers.data();
+  std::size_t       k       = 0;
+  std::size_t       begin   = 0;
+  const std::size_t cell    = width - 1; // width without the " |"
+
+  // the header, left aligned
+  out.append("\n\n ");
+  AppendLeft(out, " ", 1, cell);
+  out.append(" |");
+  AppendLeft(out, " Income", 7, cell);
+  out.append(" |");
+  for (std::size_t i = 0; i < m; ++i) {
+    out.push_back(' ');
+    AppendLeft(out, e[i].name.data(), e[i].name.size(), cell - 1);
+    out.append(" |");
+  }
+  AppendLeft(out, " Total", 6, cell);
+  out.append(" |\n");
+  AppendLine(out, '=', '=', '=', width, m + 3);
+
+  // the costs
+  out.push_back(' ');
+  AppendRight(out, "Name/Costs", 10, cell);
+  out.append(" |");
+  AppendRight(out, " ", 1, cell);
+  out.append(" |");
+  for (std::size_t i = 0; i <= m; ++i, ++k) {
+    AppendRight(out, numbers + begin, b.ends[k] - begin, cell);
+    out.append(" |");
+    begin = b.ends[k];
+  }
+  out.push_back('\n');
+  AppendLine(out, '-', '+', '|', width, m + 3);
+
+  // one row per person
+  for (std::size_t j = 0; j < n; ++j) {
+    out.push_back(' ');
+    AppendRight(out, p[j].name.data(), p[j].name.size(), cell);
+    out.append(" |");
+    for (std::size_t i = 0; i < m + 2; ++i, ++k) {
+      AppendRight(out, numbers + begin, b.ends[k] - begin, cell);
+      out.append(" |");
+      begin = b.ends[k];
+    }
+    out.push_back('\n');
+    if (j + 1 != n) {
+      AppendLine(out, '-', '+', '|', width, m + 3);
+    }
+  }
+
+  out.append("\n\nEvery person pays a fair share of ");
+  out.append(bold);
+  out.append(numbers + begin, b.ends[k] - begin);
+  out.append("%");
+  out.append(normal);
+  out.append(" of her/his income.\n");
+}   // -----  end of function RenderTable  -----
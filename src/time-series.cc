@@ -0,0 +1,341 @@
+//
+// =========================================================================
+//
+//       Filename:  time-series.cc
+//
+//    Description:  Defines the parser of series households and the
+//                  streaming engine. The lists of a household are read
+//                  in the order of the file and transposed into the
+//                  period-major layout once the number of periods is
+//                  known; the engine then walks the periods in one pass,
+//                  splitting each with AllocateShares or AllocateCents
+//                  and adding the shares to the running totals.
+//
+//        Version:  1.0
+//        Created:  10/18/2026 11:52:40 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>     // input/output streams, e.g. cout and cin
+#include <sstream>      // string streams to join different strings
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ledger.h"
+#include "allocation.h"
+#include "ini-parser.h"
+#include "summation.h"
+#include "time-series.h"
+#include "helper-functions.h"
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+IniToken SetError (IniScanner & s, const char * position,
+                   const std::string & message) {
+  s.error.line    = s.line;
+  s.error.column  = IniColumn(s, position);
+  s.error.message = message;
+  return IniSyntaxError;
+}
+
+// Appends the blank separated amounts of s.value to ts.rowValues and
+// checks that there is either one or ts.periods of them; the first
+// longer list sets ts.periods.
+IniToken ParseAmounts (IniScanner & s, TimeSeries & ts) {
+  const char *      p     = s.value.data();
+  const char *const last  = p + s.value.size();
+  const std::size_t begin = ts.rowValues.size();
+
+  if (p == last) {
+    return SetError(s, p, ConversionErrorMessage(ConversionEmpty));
+  }
+  while (p < last) {
+    const char * first = p;
+    while (p < last && *p != ' ' && *p != '\t') {
+      ++p;
+    }
+    const Conversion c = ParseDouble(
+      std::string_view(first, static_cast<std::size_t>(p - first)));
+    if (c.error != ConversionOk) {
+      return SetError(s, first, ConversionErrorMessage(c.error));
+    }
+    ts.rowValues.push_back(c.value);
+    while (p < last && (*p == ' ' || *p == '\t')) {
+      ++p;
+    }
+  }  // -----  end while  -----
+
+  const std::size_t count = ts.rowValues.size() - begin;
+  if (count > 1 && ts.periods == 1) {
+    ts.periods = count;
+  } else if (count > 1 && count != ts.periods) {
+    std::ostringstream message;
+    message << "Expected 1 or " << ts.periods << " amounts, found "
+      << count << ".";
+    return SetError(s, s.value.data(), message.str());
+  }
+  return IniKeyValue;
+}
+
+// copies the lists given by rows into the columns of out, periods x
+// rows.size()/2, repeating single amounts
+void Transpose (const TimeSeries & ts, const std::vector<std::size_t> & rows,
+                std::vector<double> & out) {
+  const std::size_t columns = rows.size()/2;
+  out.resize(ts.periods*columns);
+  for (std::size_t c = 0; c < columns; ++c) {
+    const double *    values = ts.rowValues.data() + rows[2*c];
+    const std::size_t step   = rows[2*c + 1] - rows[2*c] > 1 ? 1 : 0;
+    for (std::size_t t = 0; t < ts.periods; ++t) {
+      out[t*columns + c] = values[t*step];
+    }
+  }  // -----  end for  -----
+}
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ParseSeriesHousehold
+//  Description:  Reads a series household into ts, with the same
+//                sections, errors and stopAtNextHousehold/pendingPerson
+//                protocol as ParseHousehold. Every income and cost is a
+//                list of amounts, see TimeSeries.
+// =========================================================================
+IniToken ParseSeriesHousehold (IniScanner & s, TimeSeries & ts,
+                               const bool stopAtNextHousehold,
+                               bool & pendingPerson) {
+
+  enum Section : unsigned short {
+    NoSection,
+    PersonSection,
+    ExpensesSection,
+    OtherSection,
+  };
+
+  ts.personNames.clear();
+  ts.expenseNames.clear();
+  ts.rowValues.clear();
+  ts.incomeRows.clear();
+  ts.costRows.clear();
+  ts.periods = 1;
+
+  Section     section      = NoSection;
+  bool        seenExpenses = false;
+  bool        hasName      = false;
+  bool        hasIncome    = false;
+  std::size_t personLine   = 0;
+
+  if (pendingPerson) {
+    ts.personNames.push_back(std::string());
+    ts.incomeRows.push_back(0);
+    ts.incomeRows.push_back(0);
+    section       = PersonSection;
+    personLine    = s.line;
+    pendingPerson = false;
+  }
+
+  for (;;) {
+    const IniToken token = NextIniToken(s);
+
+    if (token == IniSyntaxError) {
+      return IniSyntaxError;
+    }
+
+    // a person section is complete
+    if (section == PersonSection && token != IniKeyValue
+        && !(hasName && hasIncome)) {
+      s.error.line    = personLine;
+      s.error.column  = 1;
+      s.error.message = hasName ? "Person has no income."
+                                : "Person has no name.";
+      return IniSyntaxError;
+    }
+
+    if (token == IniEnd) {
+      Transpose(ts, ts.incomeRows, ts.incomes);
+      Transpose(ts, ts.costRows, ts.costs);
+      return IniEnd;
+    }
+
+    if (token == IniSection) {
+      if (IsPersonSection(s.section)) {
+        if (stopAtNextHousehold && seenExpenses) {
+          pendingPerson = true;
+          Transpose(ts, ts.incomeRows, ts.incomes);
+          Transpose(ts, ts.costRows, ts.costs);
+          return IniSection;
+        }
+        ts.personNames.push_back(std::string());
+        ts.incomeRows.push_back(0);
+        ts.incomeRows.push_back(0);
+        section    = PersonSection;
+        hasName    = false;
+        hasIncome  = false;
+        personLine = s.line;
+      } else if (s.section == "expenses") {
+        section      = ExpensesSection;
+        seenExpenses = true;
+      } else {
+        section = OtherSection;
+      }
+      continue;
+    }  // -----  end if section  -----
+
+    switch (section) {
+      case PersonSection:
+        if (s.key == "name") {
+          ts.personNames.back().assign(s.value.data(), s.value.size());
+          hasName = true;
+        } else if (s.key == "income") {
+          const std::size_t begin = ts.rowValues.size();
+          if (ParseAmounts(s, ts) == IniSyntaxError) {
+            return IniSyntaxError;
+          }
+          ts.incomeRows[ts.incomeRows.size() - 2] = begin;
+          ts.incomeRows[ts.incomeRows.size() - 1] = ts.rowValues.size();
+          hasIncome = true;
+        }
+        break;
+
+      case ExpensesSection: {
+        const std::size_t begin = ts.rowValues.size();
+        if (ParseAmounts(s, ts) == IniSyntaxError) {
+          return IniSyntaxError;
+        }
+        ts.expenseNames.push_back(std::string(s.key));
+        ts.costRows.push_back(begin);
+        ts.costRows.push_back(ts.rowValues.size());
+        break;
+      }
+
+      case NoSection:
+        return SetError(s, s.key.data(), "Key outside of any section.");
+
+      case OtherSection:
+        break;
+
+      default:
+        break;
+    }  // -----  end switch  -----
+  }  // -----  end for  -----
+}   // -----  end of function ParseSeriesHousehold  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  StartSeries
+//  Description:  Checks the incomes of every period as AllocateHousehold
+//                does and prepares state for the first period. Returns
+//                NULL on success, otherwise why ts can not be split; no
+//                period is split then, so a household is either written
+//                completely or not at all. With cents, every period
+//                needs at least one cent of income, see AllocateCents.
+// =========================================================================
+const char * StartSeries (const TimeSeries & ts, const bool cents,
+                          SeriesState & state) {
+  const std::size_t n = SeriesPersons(ts);
+  const std::size_t m = SeriesExpenses(ts);
+
+  if (n == 0) {
+    return "There is nobody to split the expenses between.";
+  }
+  for (std::size_t t = 0; t < ts.periods; ++t) {
+    int64_t centSum = 0;
+    for (std::size_t j = 0; j < n; ++j) {
+      const double income = ts.incomes[t*n + j];
+      if (income <= 0. && income >= 0.) {
+        return "Incomes have to be non zero.";
+      }
+      if (cents && income < 0.) {
+        return "Splitting in cents needs non negative incomes.";
+      }
+      centSum += cents ? ToCents(income) : 0;
+    }
+    const double sum = SumPairwise(ts.incomes.data() + t*n, n);
+    if (sum <= 0. && sum >= 0.) {
+      return "The incomes add up to zero.";
+    }
+    if (cents && centSum <= 0) {
+      return "Splitting in cents needs non negative incomes.";
+    }
+  }  // -----  end for  -----
+
+  state.period = 0;
+  state.cents  = cents;
+  state.shares.resize(n*m);
+  state.totals.resize(n);
+  state.cumulative.assign(n*m, 0.);
+  state.cumulativeTotals.assign(n, 0.);
+  state.cumulativeErrors.assign(n*m, 0.);
+  state.cumulativeTotalErrors.assign(n, 0.);
+
+  if (cents) {
+    state.centIncomes.resize(n);
+    state.centCosts.resize(m);
+    state.centShares.resize(n*m);
+    state.centTotals.resize(n);
+    state.centScratch.resize(AllocateCentsScratch(n));
+    state.centCumulative.assign(n*m, 0);
+    state.centCumulativeTotals.assign(n, 0);
+  }
+  return NULL;
+}   // -----  end of function StartSeries  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  NextPeriod
+//  Description:  Splits period state.period of ts into state.shares and
+//                state.totals and adds them to the running totals. With
+//                cents the running totals are summed in cents, so they
+//                stay exact over any number of periods.
+// =========================================================================
+void NextPeriod (const TimeSeries & ts, SeriesState & state) {
+  const std::size_t n       = SeriesPersons(ts);
+  const std::size_t m       = SeriesExpenses(ts);
+  const double *    incomes = ts.incomes.data() + state.period*n;
+  const double *    costs   = ts.costs.data()   + state.period*m;
+
+  if (!state.cents) {
+    AllocateShares(incomes, n, costs, m, state.shares.data(),
+                   state.totals.data());
+    AccumulateCompensated(state.cumulative.data(),
+                          state.cumulativeErrors.data(), state.shares.data(),
+                          n*m);
+    AccumulateCompensated(state.cumulativeTotals.data(),
+                          state.cumulativeTotalErrors.data(),
+                          state.totals.data(), n);
+    ++state.period;
+    return;
+  }
+
+  for (std::size_t j = 0; j < n; ++j) {
+    state.centIncomes[j] = ToCents(incomes[j]);
+  }
+  for (std::size_t i = 0; i < m; ++i) {
+    state.centCosts[i] = ToCents(costs[i]);
+  }
+  // StartSeries made sure that no income is negative
+  AllocateCents(state.centIncomes.data(), n, state.centCosts.data(), m,
+                state.centShares.data(), state.centTotals.data(),
+                state.centScratch.data());
+
+  for (std::size_t k = 0; k < n*m; ++k) {
+    state.centCumulative[k] += state.centShares[k];
+    state.shares[k]     = static_cast<double>(state.centShares[k])/100.;
+    state.cumulative[k] = static_cast<double>(state.centCumulative[k])/100.;
+  }
+  for (std::size_t j = 0; j < n; ++j) {
+    state.centCumulativeTotals[j] += state.centTotals[j];
+    state.totals[j] = static_cast<double>(state.centTotals[j])/100.;
+    state.cumulativeTotals[j] =
+      static_cast<double>(state.centCumulativeTotals[j])/100.;
+  }
+  ++state.period;
+}   // -----  end of function NextPeriod  -----
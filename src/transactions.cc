@@ -0,0 +1,551 @@
+//
+// =========================================================================
+//
+//       Filename:  transactions.cc
+//
+//    Description:  Defines the ingester of bank statements, see
+//                  transactions.h. The export is read into one buffer of
+//                  kTransactionChunkBytes at a time and scanned line by
+//                  line with memchr; only the columns up to the last one
+//                  needed are split, and the amount is read straight
+//                  into cents. A line costs one lookup in the hash table
+//                  of descriptions; the rules are only matched against
+//                  the distinct descriptions, once the file is read.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 09:02:16 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cerrno>
+#include <charconv>     // from_chars
+#include <cstddef>
+#include <cstdint>
+#include <cstring>      // memchr, strerror
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ledger.h"
+#include "arena.h"
+#include "name-table.h"
+#include "ini-parser.h"
+#include "chunk-reader.h"
+#include "transactions.h"
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+// the chunks of the ChunkReader, as kChunkReaderBytes
+const std::size_t kTransactionChunkBytes = 1 << 20;
+
+// about 100 MB of sums, slots and key bytes at 30 bytes a description
+const std::size_t kMaxTransactionKeys = 1 << 20;
+
+//--------------------------------------------------------------------------
+//  local helpers
+//--------------------------------------------------------------------------
+namespace {
+const std::size_t kNoColumn = static_cast<std::size_t>(-1);
+
+// at most 17 digits, so that the sum of many amounts does not overflow
+const int kMaxAmountDigits = 17;
+
+bool IsBlank (const char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+std::string_view Trim (std::string_view s) {
+  while (!s.empty() && IsBlank(s.front())) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() && IsBlank(s.back())) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+IniToken SetError (IniScanner & s, const char * position,
+                   const std::string & message) {
+  s.error.line    = s.line;
+  s.error.column  = IniColumn(s, position);
+  s.error.message = message;
+  return IniSyntaxError;
+}
+
+bool ParseColumn (const std::string_view value, std::size_t & column) {
+  std::size_t n = 0;
+  const std::from_chars_result r = std::from_chars(
+    value.data(), value.data() + value.size(), n);
+  if (r.ec != std::errc() || r.ptr != value.data() + value.size()) {
+    return false;
+  }
+  column = n;
+  return true;
+}
+
+// reads the [format] and [rules] sections of s into t
+IniToken ParseRuleLines (IniScanner & s, TransactionLedger & t) {
+  enum Section { None, Format, Rules, Other } section = None;
+  TransactionFormat & f = t.format;
+
+  for (;;) {
+    const IniToken token = NextIniToken(s);
+    if (token == IniSyntaxError || token == IniEnd) {
+      return token;
+    }
+    if (token == IniSection) {
+      section = s.section == "format" ? Format
+              : s.section == "rules"  ? Rules : Other;
+      continue;
+    }
+
+    switch (section) {
+      case None:
+        return SetError(s, s.key.data(), "Key outside of any section.");
+
+      case Rules: {
+        TransactionRule r;
+        r.expense = std::string(s.key);
+        r.text    = std::string(s.value);
+        if (r.text.empty()) {
+          return SetError(s, s.key.data(), "Rule without a text.");
+        }
+        t.rules.push_back(r);
+        break;
+      }
+
+      case Format: {
+        std::size_t n = 0;
+        if (s.key == "separator" || s.key == "decimal") {
+          const char c = s.value == "tab" ? '\t'
+                       : s.value.size() == 1 ? s.value[0] : '\0';
+          if (c == '\0' || c == '"' || c == '\n'
+              || (s.key == "decimal" && c != '.' && c != ',')) {
+            return SetError(s, s.value.data(), "Invalid " + std::string(s.key)
+                            + " '" + std::string(s.value) + "'.");
+          }
+          (s.key == "separator" ? f.separator : f.decimal) = c;
+        } else if (s.key == "key" || s.key == "amount") {
+          if (!ParseColumn(s.value, n) || n < 1) {
+            return SetError(s, s.value.data(), "Columns count from 1.");
+          }
+          (s.key == "key" ? f.keyColumn : f.amountColumn) = n - 1;
+        } else if (s.key == "header") {
+          if (!ParseColumn(s.value, n)) {
+            return SetError(s, s.value.data(), "Expected a number of lines.");
+          }
+          f.headerLines = n;
+        } else if (s.key == "debits") {
+          if (s.value != "negative" && s.value != "positive") {
+            return SetError(s, s.value.data(),
+                            "Expected 'negative' or 'positive'.");
+          }
+          f.debitsNegative = s.value == "negative";
+        } else {
+          return SetError(s, s.key.data(), "Unknown key '"
+                          + std::string(s.key) + "'.");
+        }
+        break;
+      }
+
+      case Other:
+      default:
+        break;
+    }  // -----  end switch  -----
+  }  // -----  end for  -----
+}
+
+// Sets field to the field at p, without its quotes if it has any, and
+// returns the start of the next one, or end + 1 after the last one.
+// Doubled quotes are kept as they are, which only matters for matching
+// a rule against them.
+inline const char * NextField (const char * p, const char * end,
+                               const char separator, std::string_view & field) {
+  if (p < end && *p == '"') {
+    const char * q = p + 1;
+    for (;;) {
+      const char * quote = static_cast<const char *>(
+        std::memchr(q, '"', static_cast<std::size_t>(end - q)));
+      if (quote == NULL) {  // not closed, take the rest
+        field = std::string_view(p + 1, static_cast<std::size_t>(end - p - 1));
+        return end + 1;
+      }
+      if (quote + 1 < end && quote[1] == '"') {
+        q = quote + 2;
+        continue;
+      }
+      field = std::string_view(p + 1, static_cast<std::size_t>(quote - p - 1));
+      const char * next = static_cast<const char *>(
+        std::memchr(quote + 1, separator,
+                    static_cast<std::size_t>(end - quote - 1)));
+      return next != NULL ? next + 1 : end + 1;
+    }
+  }
+  const char * next = static_cast<const char *>(
+    std::memchr(p, separator, static_cast<std::size_t>(end - p)));
+  if (next == NULL) {
+    field = std::string_view(p, static_cast<std::size_t>(end - p));
+    return end + 1;
+  }
+  field = std::string_view(p, static_cast<std::size_t>(next - p));
+  return next + 1;
+}
+
+const uint64_t kZeros = 0x3030303030303030ull;  // '0' in every byte
+
+// the eight digits of word, the first in its lowest byte, as a number
+inline uint64_t EightDigits (uint64_t word) {
+  word -= kZeros;
+  word  = word*10 + (word >> 8);
+  return (((word & 0x000000ff000000ffull)*(100 + (1000000ull << 32)))
+          + (((word >> 16) & 0x000000ff000000ffull)*(1 + (10000ull << 32))))
+         >> 32;
+}
+
+// Reads an amount like -1.234,56 with the given decimal separator into
+// cents; the other one of '.' and ',', blanks and apostrophes group the
+// thousands. More than two decimals are only allowed as zeros. An amount
+// of at most eight digits, maybe with a decimal separator before two
+// decimals, is read as one word, the eight bytes up to its end, if they
+// start at or after from; the others digit by digit.
+bool ParseCents (std::string_view s, const char decimal,
+                 const char * const from, int64_t & cents) {
+  const char grouping = decimal == ',' ? '.' : ',';
+  s = Trim(s);
+  const char * p        = s.data();
+  const char * end      = p + s.size();
+  bool         negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    ++p;
+  }
+
+  const std::size_t n = static_cast<std::size_t>(end - p);
+  if (n >= 1 && n <= 8 && end - from >= 8) {
+    uint64_t word;
+    std::memcpy(&word, end - 8, sizeof(word));
+    const uint64_t keep = ~0ull << 8*(8 - n);
+    word = (word & keep) | (kZeros & ~keep);
+    // the decimal separator of two decimals is read as a zero
+    const unsigned point = static_cast<unsigned>(word >> 40) & 0xff;
+    const bool     two   = n >= 3
+                           && point == static_cast<unsigned char>(decimal);
+    word ^= two ? static_cast<uint64_t>(point ^ '0') << 40 : 0;
+    const uint64_t kHighNibbles = 0xf0f0f0f0f0f0f0f0ull;
+    if ((word & kHighNibbles) == kZeros
+        && ((word + 0x0606060606060606ull) & kHighNibbles) == kZeros) {
+      const uint64_t value = EightDigits(word);
+      const int64_t  c     = static_cast<int64_t>(
+        two ? value/1000*100 + value % 100 : value*100);
+      cents = negative ? -c : c;
+      return true;
+    }
+  }
+
+  uint64_t value  = 0;  // unsigned, it may wrap before too many digits
+  int      digits = 0;  // are found below
+  for (; p < end; ++p) {
+    const unsigned d = static_cast<unsigned char>(*p) - unsigned('0');
+    if (d < 10) {
+      value = 10*value + d;
+      ++digits;
+    } else if (*p != grouping && *p != ' ' && *p != '\'') {
+      break;
+    }
+  }  // -----  end for  -----
+
+  int decimals = 0;
+  if (p < end && *p == decimal) {
+    for (++p; p < end && decimals < 2; ++p, ++decimals) {
+      const unsigned d = static_cast<unsigned char>(*p) - unsigned('0');
+      if (d >= 10) {
+        return false;
+      }
+      value = 10*value + d;
+      ++digits;
+    }  // -----  end for  -----
+    while (p < end && *p == '0') {
+      ++p;
+    }
+  }
+  if (p != end || digits == 0 || digits > kMaxAmountDigits) {
+    return false;
+  }
+  value *= decimals == 0 ? 100 : decimals == 1 ? 10 : 1;
+  cents  = negative ? -static_cast<int64_t>(value)
+                    : static_cast<int64_t>(value);
+  return true;
+}
+
+void SetLineError (const TransactionLedger & t, const std::string & message,
+                   std::string & error) {
+  error = t.fileName + ":" + std::to_string(t.lines) + ": " + message;
+}
+
+// returns false if key would be one description more than
+// kMaxTransactionKeys
+bool AddTransaction (TransactionLedger & t, const std::string_view key,
+                     const int64_t cents) {
+  const uint32_t id = InternName(t.keys, t.arena, Trim(key));
+  if (id == t.cents.size()) {
+    if (id >= kMaxTransactionKeys) {
+      return false;
+    }
+    t.cents.push_back(0);
+    t.counts.push_back(0);
+  }
+  t.cents[id]  += cents;
+  t.counts[id] += 1;
+  ++t.transactions;
+  return true;
+}
+}  // -----  end of namespace  -----
+
+void InitTransactionLedger (TransactionLedger & t) {
+  t.format.separator      = ',';
+  t.format.decimal        = '.';
+  t.format.keyColumn      = kNoColumn;
+  t.format.amountColumn   = kNoColumn;
+  t.format.headerLines    = 1;
+  t.format.debitsNegative = true;
+  t.rules.clear();
+  InitArena(t.arena, kArenaBlockBytes);
+  InitNameTable(t.keys);
+  t.cents.clear();
+  t.counts.clear();
+  t.lines        = 0;
+  t.transactions = 0;
+  t.fileName.clear();
+  t.reader.fd = -1;
+}   // -----  end of function InitTransactionLedger  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ParseTransactionRules
+//  Description:  Reads the format and the rules of the text of a rules
+//                file into t, see TransactionRule. On failure error is
+//                set, as by ParsePayments, and false is returned.
+// =========================================================================
+bool ParseTransactionRules (const std::string_view text,
+                            const std::string & fileName,
+                            TransactionLedger & t, std::string & error) {
+  IniScanner scanner;
+  InitIniScanner(scanner, text);
+  if (ParseRuleLines(scanner, t) == IniSyntaxError) {
+    error = fileName + ":" + std::to_string(scanner.error.line) + ":"
+            + std::to_string(scanner.error.column) + ": "
+            + scanner.error.message;
+    return false;
+  }
+  if (t.format.keyColumn == kNoColumn || t.format.amountColumn == kNoColumn) {
+    error = fileName + ": The [format] needs the key and amount columns.";
+    return false;
+  }
+  if (t.format.separator == t.format.decimal) {
+    error = fileName + ": The separator can not be the decimal separator.";
+    return false;
+  }
+  return true;
+}   // -----  end of function ParseTransactionRules  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ScanTransactions
+//  Description:  Adds the transactions of all complete lines of text to
+//                t and sets consumed to the bytes read, i.e. up to and
+//                including the last newline. Empty lines and the header
+//                lines are skipped. The end of each line is found first,
+//                then its fields up to the last column needed, both from
+//                the bits of the newlines and separators in blocks of 64
+//                bytes, see ByteBits; only a quoted field is read by
+//                NextField. On failure error is set to the file and line
+//                and false is returned.
+// =========================================================================
+bool ScanTransactions (const std::string_view text, TransactionLedger & t,
+                       std::size_t & consumed, std::string & error) {
+  const TransactionFormat & f    = t.format;
+  const std::size_t         last = f.keyColumn > f.amountColumn
+                                   ? f.keyColumn : f.amountColumn;
+  const char *              line = text.data();
+  const char *              end  = line + text.size();
+  bool                      ok   = true;
+  ByteBits                  newlines;
+  ByteBits                  separators;
+  StartByteBits(newlines, line, end, '\n');
+  StartByteBits(separators, line, end, f.separator);
+
+  while (line < end) {
+    const char * eol = NextByte(newlines, line, end, end);
+    if (eol == end) {
+      break;  // the rest of the line is in the next chunk
+    }
+    ++t.lines;
+    if (t.lines <= f.headerLines || *line == '\n' || *line == '\r') {
+      line = eol + 1;
+      continue;
+    }
+
+    const char *     lineEnd = eol[-1] == '\r' ? eol - 1 : eol;
+    const char *     p       = line;
+    std::string_view key;
+    std::string_view amount;
+    std::size_t      c       = 0;
+    for (; c <= last && p <= lineEnd; ++c) {
+      std::string_view field;
+      if (*p == '"') {
+        p = NextField(p, lineEnd, f.separator, field);
+      } else {
+        const char * q = NextByte(separators, p, lineEnd, end);
+        field = std::string_view(p, static_cast<std::size_t>(q - p));
+        p     = q + 1;
+      }
+      if (c == f.keyColumn) {
+        key = field;
+      }
+      if (c == f.amountColumn) {
+        amount = field;
+      }
+    }  // -----  end for  -----
+
+    int64_t cents = 0;
+    if (c <= last) {
+      SetLineError(t, "Expected " + std::to_string(last + 1)
+                   + " columns, found " + std::to_string(c) + ".", error);
+      ok = false;
+      break;
+    }
+    if (!ParseCents(amount, f.decimal, line, cents)) {
+      SetLineError(t, "Invalid amount '" + std::string(amount) + "'.", error);
+      ok = false;
+      break;
+    }
+    if (!AddTransaction(t, key, cents)) {
+      SetLineError(t, "More than " + std::to_string(kMaxTransactionKeys)
+                   + " distinct descriptions, use a column with fewer.",
+                   error);
+      ok = false;
+      break;
+    }
+    line = eol + 1;
+  }  // -----  end while  -----
+
+  consumed = static_cast<std::size_t>(line - text.data());
+  return ok;
+}   // -----  end of function ScanTransactions  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  IngestTransactions
+//  Description:  Reads the export fileName in chunks of
+//                kTransactionChunkBytes into the sums of t, after its
+//                rules, see ScanTransactions. The memory does not grow
+//                with the size of the file, only with the number of
+//                distinct descriptions, of which there may be at most
+//                kMaxTransactionKeys. On failure error is set and
+//                false is returned.
+// =========================================================================
+bool IngestTransactions (const std::string & fileName, TransactionLedger & t,
+                         std::string & error) {
+  ResetArena(t.arena);
+  ResetNameTable(t.keys);
+  t.cents.clear();
+  t.counts.clear();
+  t.lines        = 0;
+  t.transactions = 0;
+  t.fileName     = fileName;
+
+  if (!OpenChunkReader(fileName, kTransactionChunkBytes, true, t.reader)) {
+    error = "Could not open " + fileName + ": " + std::strerror(errno);
+    return false;
+  }
+
+  bool ok = true;
+  do {
+    if (!FillChunk(t.reader)) {
+      error = "Could not read " + fileName + ": " + std::strerror(errno);
+      ok    = false;
+      break;
+    }
+    std::size_t consumed = 0;
+    if (!ScanTransactions(ChunkText(t.reader), t, consumed, error)) {
+      ok = false;
+      break;
+    }
+    ConsumeChunk(t.reader, consumed);
+    if (ChunkLineTooLong(t.reader)) {
+      error = fileName + ":" + std::to_string(t.lines + 1) + ": Line longer "
+              "than " + std::to_string(kTransactionChunkBytes) + " bytes.";
+      ok    = false;
+      break;
+    }
+  } while (!t.reader.atEnd);
+
+  CloseChunkReader(t.reader);
+  return ok;
+}   // -----  end of function IngestTransactions  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  ApplyTransactions
+//  Description:  Sets the cost of every expense of a rule of t to the
+//                sum of the transactions matched to it, money spent
+//                counting as positive; expenses not in e are added, split
+//                by income. Transactions that match no rule are left
+//                out and counted in summary.
+// =========================================================================
+void ApplyTransactions (const TransactionLedger & t, std::vector<Expense> & e,
+                        TransactionSummary & summary) {
+  // the expenses of the rules, each once, in the order of the rules
+  std::vector<std::string> names;
+  std::vector<std::size_t> expenseOf(t.rules.size());
+  for (std::size_t r = 0; r < t.rules.size(); ++r) {
+    std::size_t k = 0;
+    while (k < names.size() && names[k] != t.rules[r].expense) {
+      ++k;
+    }
+    if (k == names.size()) {
+      names.push_back(t.rules[r].expense);
+    }
+    expenseOf[r] = k;
+  }  // -----  end for  -----
+
+  std::vector<int64_t> sums(names.size(), 0);
+  summary.unmatchedKeys         = 0;
+  summary.unmatchedTransactions = 0;
+  summary.unmatchedCents        = 0;
+  for (std::size_t id = 0; id < t.cents.size(); ++id) {
+    const std::string_view key = NameOf(t.keys, static_cast<uint32_t>(id));
+    std::size_t            r   = 0;
+    while (r < t.rules.size() && key.find(t.rules[r].text) == key.npos) {
+      ++r;
+    }
+    if (r == t.rules.size()) {
+      ++summary.unmatchedKeys;
+      summary.unmatchedTransactions += t.counts[id];
+      summary.unmatchedCents        += t.cents[id];
+      continue;
+    }
+    sums[expenseOf[r]] += t.cents[id];
+  }  // -----  end for  -----
+
+  summary.expenses = names.size();
+  summary.added    = 0;
+  for (std::size_t k = 0; k < names.size(); ++k) {
+    const int64_t cents = t.format.debitsNegative ? -sums[k] : sums[k];
+    const double  cost  = static_cast<double>(cents)/100.;
+    std::size_t   i     = 0;
+    while (i < e.size() && e[i].name != names[k]) {
+      ++i;
+    }
+    if (i == e.size()) {
+      Expense x;
+      x.name = names[k];
+      e.push_back(x);
+      ++summary.added;
+    }
+    e[i].cost = cost;
+  }  // -----  end for  -----
+}   // -----  end of function ApplyTransactions  -----
@@ -0,0 +1,171 @@
+//
+// =========================================================================
+//
+//       Filename:  validation.cc
+//
+//    Description:  Defines the validation stage. Nothing here exits or
+//                  forks: every check appends RecordErrors and leaves it
+//                  to the caller to stop, skip or quarantine the record.
+//                  The checks only run once allocating a household
+//                  failed, so clean data never pays for them.
+//
+//        Version:  1.0
+//        Created:  10/19/2026 06:14:05 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  Frank Milde (FM), frank.milde (at) posteo.de
+//        Company:
+//
+// =========================================================================
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ledger.h"
+#include "summation.h"
+#include "validation.h"
+
+//--------------------------------------------------------------------------
+//  constants
+//--------------------------------------------------------------------------
+namespace {
+// the reject log is written whenever it holds this many bytes
+const std::size_t kRejectFlushBytes = 1 << 16;
+}  // -----  end of namespace  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  CheckIncomes
+//  Description:  Appends an error for every person of p with a zero
+//                income to errors and returns their number. If there is
+//                none, but p is empty or its incomes add up to zero,
+//                appends one error for the household and returns 1, as
+//                AllocateHousehold refuses both.
+// =========================================================================
+std::size_t CheckIncomes (const std::vector<Person> & p, const uint64_t record,
+                          std::vector<RecordError> & errors) {
+  std::size_t    found = 0;
+  CompensatedSum sum;
+  InitCompensatedSum(sum);
+  for (std::size_t j = 0; j < p.size(); ++j) {
+    AddCompensated(sum, p[j].income);
+    if (p[j].income <= 0. && p[j].income >= 0.) {
+      RecordError e;
+      e.record  = record;
+      e.line    = 0;
+      e.column  = 0;
+      e.section = "person" + std::to_string(j + 1);
+      e.key     = "income";
+      e.reason  = "Income of '" + p[j].name + "' is zero.";
+      errors.push_back(e);
+      ++found;
+    }
+  }  // -----  end for  -----
+  if (found > 0) {
+    return found;
+  }
+
+  const double sumIncomes = CompensatedTotal(sum);
+  if (p.empty() || (sumIncomes <= 0. && sumIncomes >= 0.)) {
+    RecordError e;
+    e.record = record;
+    e.line   = 0;
+    e.column = 0;
+    e.reason = p.empty() ? "There is nobody to split the expenses between."
+                         : "The incomes add up to zero.";
+    errors.push_back(e);
+    return 1;
+  }
+  return 0;
+}   // -----  end of function CheckIncomes  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  DescribeAllocationError
+//  Description:  Appends the errors of a household that AllocateHousehold
+//                refused with reason: one per zero income, or the reason
+//                itself if it is about the household as a whole.
+// =========================================================================
+void DescribeAllocationError (const std::vector<Person> & p,
+                              const uint64_t record, const char * reason,
+                              std::vector<RecordError> & errors) {
+  if (CheckIncomes(p, record, errors) > 0) {
+    return;
+  }
+  RecordError e;
+  e.record = record;
+  e.line   = 0;
+  e.column = 0;
+  e.reason = reason;
+  errors.push_back(e);
+}   // -----  end of function DescribeAllocationError  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  FormatRecordError
+//  Description:  Returns e as "file:line:column: household 3, [person2]
+//                income: reason", leaving out what is unknown.
+// =========================================================================
+std::string FormatRecordError (const std::string & fileName,
+                               const RecordError & e) {
+  std::string message = fileName;
+  if (e.line > 0) {
+    message += ":" + std::to_string(e.line) + ":" + std::to_string(e.column);
+  }
+  message += ": ";
+  if (e.record > 0) {
+    message += "household " + std::to_string(e.record);
+    message += e.section.empty() && e.key.empty() ? ": " : ", ";
+  }
+  if (!e.section.empty()) {
+    message += "[" + e.section + "]";
+    message += e.key.empty() ? ": " : " ";
+  }
+  if (!e.key.empty()) {
+    message += e.key + ": ";
+  }
+  return message + e.reason;
+}   // -----  end of function FormatRecordError  -----
+
+void InitRejectLog (RejectLog & r, std::ostream * os,
+                    const std::string & fileName) {
+  r.os       = os;
+  r.fileName = fileName;
+  r.records  = 0;
+  r.buffer.clear();
+}   // -----  end of function InitRejectLog  -----
+
+// ===  FUNCTION  ==========================================================
+//         Name:  RejectRecord
+//  Description:  Appends the n errors of one household as comments and
+//                then its text to the reject log.
+// =========================================================================
+void RejectRecord (RejectLog & r, const RecordError * errors,
+                   const std::size_t n, const std::string_view text) {
+  for (std::size_t k = 0; k < n; ++k) {
+    r.buffer.append("; rejected ");
+    r.buffer.append(FormatRecordError(r.fileName, errors[k]));
+    r.buffer.push_back('\n');
+  }
+  r.buffer.append(text);
+  if (!text.empty() && text.back() != '\n') {
+    r.buffer.push_back('\n');
+  }
+  ++r.records;
+
+  if (r.buffer.size() >= kRejectFlushBytes && r.os != NULL) {
+    r.os->write(r.buffer.data(), static_cast<std::streamsize>(r.buffer.size()));
+    r.buffer.clear();
+  }
+}   // -----  end of function RejectRecord  -----
+
+void FinishRejectLog (RejectLog & r) {
+  if (r.os != NULL) {
+    r.os->write(r.buffer.data(), static_cast<std::streamsize>(r.buffer.size()));
+    r.os->flush();
+  }
+  r.buffer.clear();
+}   // -----  end of function FinishRejectLog  -----